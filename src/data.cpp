@@ -35,10 +35,12 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 Data::Data(const Name& name)
   : m_name(name)
   , m_content(tlv::Content)
+  , m_deferredFields(0)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_deferredFields(0)
 {
   wireDecode(wire);
 }
@@ -56,16 +58,18 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool wantUnsignedPortionOnly) const
 
   size_t totalLength = 0;
 
+  const Signature& signature = getSignature();
+
   // SignatureValue
   if (!wantUnsignedPortionOnly) {
-    if (!m_signature) {
+    if (!signature) {
       BOOST_THROW_EXCEPTION(Error("Requested wire format, but Data has not been signed"));
     }
-    totalLength += encoder.prependBlock(m_signature.getValue());
+    totalLength += encoder.prependBlock(signature.getValue());
   }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   // Content
   totalLength += encoder.prependBlock(getContent());
@@ -119,7 +123,7 @@ Data::wireEncode() const
 }
 
 void
-Data::wireDecode(const Block& wire)
+Data::wireDecode(const Block& wire, bool wantLazyDecoding)
 {
   m_wire = wire;
   m_wire.parse();
@@ -129,6 +133,7 @@ Data::wireDecode(const Block& wire)
   m_content = Block(tlv::Content);
   m_signature = Signature();
   m_fullName.clear();
+  m_deferredFields = 0;
 
   int lastEle = 0; // last recognized element index, in spec order
   for (const Block& ele : m_wire.elements()) {
@@ -146,7 +151,12 @@ Data::wireDecode(const Block& wire)
         if (lastEle >= 2) {
           BOOST_THROW_EXCEPTION(Error("MetaInfo element is out of order"));
         }
-        m_metaInfo.wireDecode(ele);
+        if (wantLazyDecoding) {
+          m_deferredFields |= DEFERRED_META_INFO;
+        }
+        else {
+          m_metaInfo.wireDecode(ele);
+        }
         lastEle = 2;
         break;
       }
@@ -163,7 +173,12 @@ Data::wireDecode(const Block& wire)
           BOOST_THROW_EXCEPTION(Error("SignatureInfo element is out of order"));
         }
         hasSigInfo = true;
-        m_signature.setInfo(ele);
+        if (wantLazyDecoding) {
+          m_deferredFields |= DEFERRED_SIGNATURE;
+        }
+        else {
+          m_signature.setInfo(ele);
+        }
         lastEle = 4;
         break;
       }
@@ -171,7 +186,9 @@ Data::wireDecode(const Block& wire)
         if (lastEle >= 5) {
           BOOST_THROW_EXCEPTION(Error("SignatureValue element is out of order"));
         }
-        m_signature.setValue(ele);
+        if (!wantLazyDecoding) {
+          m_signature.setValue(ele);
+        }
         lastEle = 5;
         break;
       }
@@ -193,6 +210,29 @@ Data::wireDecode(const Block& wire)
   }
 }
 
+void
+Data::decodeDeferredFieldsImpl(uint8_t fields)
+{
+  fields &= m_deferredFields;
+
+  // element order has been validated by wireDecode, and unrecognized elements are non-critical
+  if ((fields & DEFERRED_META_INFO) != 0) {
+    m_metaInfo.wireDecode(*m_wire.find(tlv::MetaInfo));
+    m_deferredFields &= ~DEFERRED_META_INFO;
+  }
+
+  if ((fields & DEFERRED_SIGNATURE) != 0) {
+    Signature signature;
+    signature.setInfo(*m_wire.find(tlv::SignatureInfo));
+    auto value = m_wire.find(tlv::SignatureValue);
+    if (value != m_wire.elements_end()) {
+      signature.setValue(*value);
+    }
+    m_signature = std::move(signature);
+    m_deferredFields &= ~DEFERRED_SIGNATURE;
+  }
+}
+
 const Name&
 Data::getFullName() const
 {
@@ -210,6 +250,7 @@ Data::getFullName() const
 void
 Data::resetWire()
 {
+  decodeDeferredFields(DEFERRED_ALL);
   m_wire.reset();
   m_fullName.clear();
 }
@@ -313,7 +354,7 @@ Data::setFinalBlock(optional<name::Component> finalBlockId)
 name::Component
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 Data&
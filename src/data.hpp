@@ -102,9 +102,17 @@ public:
   wireEncode() const;
 
   /** @brief Decode from @p wire in NDN Packet Format v0.2 or v0.3.
+   *  @param wire @c tlv::Data element
+   *  @param wantLazyDecoding if true, only the Name is decoded and the TLV structure of the
+   *         other elements is validated; MetaInfo and Signature are decoded on first access.
+   *
+   *  Lazy decoding reduces the per-packet cost for applications that look only at the Name,
+   *  such as filtering or caching proxies. If a deferred element is malformed, the error is
+   *  reported by the accessor that triggers its decoding (e.g., getSignature() throws
+   *  tlv::Error), rather than by this function.
    */
   void
-  wireDecode(const Block& wire);
+  wireDecode(const Block& wire, bool wantLazyDecoding = false);
 
   /** @brief Check if this instance has cached wire encoding.
    */
@@ -141,6 +149,7 @@ public: // Data fields
   const MetaInfo&
   getMetaInfo() const
   {
+    decodeDeferredFields(DEFERRED_META_INFO);
     return m_metaInfo;
   }
 
@@ -188,6 +197,7 @@ public: // Data fields
   const Signature&
   getSignature() const
   {
+    decodeDeferredFields(DEFERRED_SIGNATURE);
     return m_signature;
   }
 
@@ -207,7 +217,7 @@ public: // MetaInfo fields
   uint32_t
   getContentType() const
   {
-    return m_metaInfo.getType();
+    return getMetaInfo().getType();
   }
 
   Data&
@@ -216,7 +226,7 @@ public: // MetaInfo fields
   time::milliseconds
   getFreshnessPeriod() const
   {
-    return m_metaInfo.getFreshnessPeriod();
+    return getMetaInfo().getFreshnessPeriod();
   }
 
   Data&
@@ -225,7 +235,7 @@ public: // MetaInfo fields
   const optional<name::Component>&
   getFinalBlock() const
   {
-    return m_metaInfo.getFinalBlock();
+    return getMetaInfo().getFinalBlock();
   }
 
   Data&
@@ -252,6 +262,26 @@ protected:
   void
   resetWire();
 
+private:
+  enum : uint8_t {
+    DEFERRED_META_INFO = 1 << 0,
+    DEFERRED_SIGNATURE = 1 << 1,
+    DEFERRED_ALL = DEFERRED_META_INFO | DEFERRED_SIGNATURE,
+  };
+
+  /** @brief Decode the specified @p fields if their decoding has been deferred
+   */
+  void
+  decodeDeferredFields(uint8_t fields) const
+  {
+    if ((m_deferredFields & fields) != 0) {
+      const_cast<Data*>(this)->decodeDeferredFieldsImpl(fields);
+    }
+  }
+
+  void
+  decodeDeferredFieldsImpl(uint8_t fields);
+
 private:
   Name m_name;
   MetaInfo m_metaInfo;
@@ -259,6 +289,7 @@ private:
   Signature m_signature;
 
   mutable Block m_wire;
+  uint8_t m_deferredFields; ///< fields not yet decoded from m_wire
   mutable Name m_fullName; ///< cached FullName computed from m_wire
 };
 
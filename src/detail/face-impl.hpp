@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,8 +24,9 @@
 
 #include "../face.hpp"
 #include "container-with-on-empty-signal.hpp"
+#include "interest-filter-table.hpp"
 #include "lp-field-tag.hpp"
-#include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
 #include "registered-prefix.hpp"
 #include "../lp/packet.hpp"
 #include "../lp/tags.hpp"
@@ -37,6 +38,7 @@
 #include "../util/logger.hpp"
 #include "../util/scheduler.hpp"
 #include "../util/signal.hpp"
+#include "../util/trace.hpp"
 
 NDN_LOG_INIT(ndn.Face);
 // INFO level: prefix registration, etc.
@@ -48,7 +50,7 @@ NDN_LOG_INIT(ndn.Face);
 // Nack is printed as the Interest followed by the Nack reason and delimited by a '~' symbol. A
 // log line about an incoming packet may be followed by zero or more lines about Interest matching
 // InterestFilter, Data satisfying Interest, or Nack rejecting Interest, which are also written at
-// DEBUG level.
+// DEBUG level. Packet log lines are recorded into the binary trace when util::Trace is enabled.
 //
 // TRACE level: more detailed unstructured messages.
 
@@ -59,8 +61,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  using PendingInterestTable = ContainerWithOnEmptySignal<shared_ptr<PendingInterest>>;
-  using InterestFilterTable = std::list<shared_ptr<InterestFilterRecord>>;
   using RegisteredPrefixTable = ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>>;
 
   explicit
@@ -88,17 +88,18 @@ public: // consumer
                        const NackCallback& afterNacked,
                        const TimeoutCallback& afterTimeout)
   {
-    NDN_LOG_DEBUG("<I " << *interest);
+    NDN_TRACE_DEBUG("<I {}", *interest);
     this->ensureConnected(true);
 
     const Interest& interest2 = *interest;
-    auto i = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      std::move(interest), afterSatisfied, afterNacked, afterTimeout, ref(m_scheduler))).first;
     // In dispatchInterest, an InterestCallback may respond with Data right away and delete
     // the PendingInterestTable entry. shared_ptr is retained to ensure PendingInterest instance
     // remains valid in this case.
-    shared_ptr<PendingInterest> entry = *i;
-    entry->setDeleter([this, i] { m_pendingInterestTable.erase(i); });
+    auto entry = make_shared<PendingInterest>(std::move(interest), afterSatisfied, afterNacked,
+                                              afterTimeout, ref(m_scheduler));
+    m_pendingInterestTable.insert(entry);
+    auto id = reinterpret_cast<const PendingInterestId*>(&interest2);
+    entry->setDeleter([this, id] { m_pendingInterestTable.erase(id); });
 
     lp::Packet lpPacket;
     addFieldFromTag<lp::NextHopFaceIdField, lp::NextHopFaceIdTag>(lpPacket, interest2);
@@ -113,7 +114,7 @@ public: // consumer
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.erase(pendingInterestId);
   }
 
   void
@@ -128,15 +129,13 @@ public: // consumer
   satisfyPendingInterests(const Data& data)
   {
     bool hasAppMatch = false, hasForwarderMatch = false;
-    for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
-      shared_ptr<PendingInterest> entry = *i;
-      if (!entry->getInterest()->matchesData(data)) {
-        ++i;
+    for (const auto& entry : m_pendingInterestTable.findAllDataMatches(data)) {
+      // a callback invoked earlier in this loop may have removed this entry
+      if (!m_pendingInterestTable.erase(*entry)) {
         continue;
       }
 
       NDN_LOG_DEBUG("   satisfying " << *entry->getInterest() << " from " << entry->getOrigin());
-      i = m_pendingInterestTable.erase(i);
 
       if (entry->getOrigin() == PendingInterestOrigin::APP) {
         hasAppMatch = true;
@@ -156,18 +155,16 @@ public: // consumer
   nackPendingInterests(const lp::Nack& nack)
   {
     optional<lp::Nack> outNack;
-    for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
-      shared_ptr<PendingInterest> entry = *i;
-      if (!nack.getInterest().matchesInterest(*entry->getInterest())) {
-        ++i;
-        continue;
-      }
-
+    for (const auto& entry : m_pendingInterestTable.findAllNackMatches(nack)) {
       NDN_LOG_DEBUG("   nacking " << *entry->getInterest() << " from " << entry->getOrigin());
 
       optional<lp::Nack> outNack1 = entry->recordNack(nack);
       if (!outNack1) {
-        ++i;
+        continue;
+      }
+
+      // a callback invoked earlier in this loop may have removed this entry
+      if (!m_pendingInterestTable.erase(*entry)) {
         continue;
       }
 
@@ -177,7 +174,6 @@ public: // consumer
       else {
         outNack = outNack1;
       }
-      i = m_pendingInterestTable.erase(i);
     }
     // send "least severe" Nack from any PendingInterest record originated from forwarder, because
     // it is unimportant to consider Nack reason for the unlikely case when forwarder sends multiple
@@ -190,18 +186,15 @@ public: // producer
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
   {
     NDN_LOG_INFO("setting InterestFilter: " << interestFilterRecord->getFilter());
-    m_interestFilterTable.push_back(std::move(interestFilterRecord));
+    m_interestFilterTable.insert(std::move(interestFilterRecord));
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end()) {
-      NDN_LOG_INFO("unsetting InterestFilter: " << (*i)->getFilter());
-      m_interestFilterTable.erase(i);
+    auto filter = m_interestFilterTable.erase(interestFilterId);
+    if (filter != nullptr) {
+      NDN_LOG_INFO("unsetting InterestFilter: " << filter->getFilter());
     }
   }
 
@@ -209,13 +202,13 @@ public: // producer
   processIncomingInterest(shared_ptr<const Interest> interest)
   {
     const Interest& interest2 = *interest;
-    auto i = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      std::move(interest), ref(m_scheduler))).first;
     // In dispatchInterest, an InterestCallback may respond with Data right away and delete
     // the PendingInterestTable entry. shared_ptr is retained to ensure PendingInterest instance
     // remains valid in this case.
-    shared_ptr<PendingInterest> entry = *i;
-    entry->setDeleter([this, i] { m_pendingInterestTable.erase(i); });
+    auto entry = make_shared<PendingInterest>(std::move(interest), ref(m_scheduler));
+    m_pendingInterestTable.insert(entry);
+    auto id = reinterpret_cast<const PendingInterestId*>(&interest2);
+    entry->setDeleter([this, id] { m_pendingInterestTable.erase(id); });
 
     this->dispatchInterest(*entry, interest2);
   }
@@ -223,19 +216,17 @@ public: // producer
   void
   dispatchInterest(PendingInterest& entry, const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(entry)) {
-        NDN_LOG_DEBUG("   matches " << filter->getFilter());
-        entry.recordForwarding();
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(entry)) {
+      NDN_LOG_DEBUG("   matches " << filter->getFilter());
+      entry.recordForwarding();
+      filter->invokeInterestCallback(interest);
     }
   }
 
   void
   asyncPutData(const Data& data)
   {
-    NDN_LOG_DEBUG("<D " << data.getName());
+    NDN_TRACE_DEBUG("<D {}", data.getName());
     bool shouldSendToForwarder = satisfyPendingInterests(data);
     if (!shouldSendToForwarder) {
       return;
@@ -254,7 +245,7 @@ public: // producer
   void
   asyncPutNack(const lp::Nack& nack)
   {
-    NDN_LOG_DEBUG("<N " << nack.getInterest() << '~' << nack.getHeader().getReason());
+    NDN_TRACE_DEBUG("<N {}~{}", nack.getInterest(), nack.getHeader().getReason());
     optional<lp::Nack> outNack = nackPendingInterests(nack);
     if (!outNack) {
       return;
@@ -307,7 +298,7 @@ public: // prefix registration
 
     if (registeredPrefix->getFilter() != nullptr) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (onSuccess != nullptr) {
@@ -329,7 +320,7 @@ public: // prefix registration
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.erase(*filter);
       }
 
       NDN_LOG_INFO("unregistering prefix: " << record.getPrefix());
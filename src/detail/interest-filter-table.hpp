@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "interest-filter-record.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief A table of InterestFilterRecords indexed by filter prefix
+ *
+ * Records are stored in a name tree keyed by the components of the InterestFilter prefix.
+ * Finding the records that match an Interest walks the Interest name from the root, so its
+ * cost depends on the name length rather than the number of filters.  A filter with a regular
+ * expression is stored under its prefix as well, and the expression is evaluated only when
+ * the prefix matches.  Each record can also be located by its InterestFilterId in constant time.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  InterestFilterTable()
+    : m_nextSeq(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_index.empty();
+  }
+
+  /**
+   * @brief Insert a record
+   * @pre the record does not exist in the table
+   */
+  void
+  insert(shared_ptr<InterestFilterRecord> filter)
+  {
+    Node* node = &m_root;
+    for (const auto& component : filter->getFilter().getPrefix()) {
+      auto it = node->children.find(component);
+      if (it == node->children.end()) {
+        it = node->children.emplace(component, make_unique<Node>()).first;
+        it->second->parent = node;
+        it->second->self = it;
+      }
+      node = it->second.get();
+    }
+
+    const InterestFilterId* id = getKey(*filter);
+    node->records.push_back({std::move(filter), m_nextSeq++});
+    Position& pos = m_index[id];
+    pos.node = node;
+    pos.record = std::prev(node->records.end());
+  }
+
+  /**
+   * @brief Erase the record identified by @p id
+   * @return the erased record, or nullptr if no record has been erased
+   */
+  shared_ptr<InterestFilterRecord>
+  erase(const InterestFilterId* id)
+  {
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+      return nullptr;
+    }
+
+    Node* node = it->second.node;
+    shared_ptr<InterestFilterRecord> filter = std::move(it->second.record->filter);
+    node->records.erase(it->second.record);
+    m_index.erase(it);
+    prune(node);
+    return filter;
+  }
+
+  shared_ptr<InterestFilterRecord>
+  erase(const InterestFilterRecord& filter)
+  {
+    return erase(getKey(filter));
+  }
+
+  /**
+   * @brief Find records whose filter matches the Interest in @p entry
+   * @return matching records in insertion order
+   */
+  std::vector<shared_ptr<InterestFilterRecord>>
+  findMatches(const PendingInterest& entry) const
+  {
+    std::vector<const Record*> matches;
+    auto collect = [&matches, &entry] (const Node& node) {
+      for (const Record& record : node.records) {
+        if (record.filter->doesMatch(entry)) {
+          matches.push_back(&record);
+        }
+      }
+    };
+
+    const Node* node = &m_root;
+    collect(*node);
+    for (const auto& component : entry.getInterest()->getName()) {
+      auto it = node->children.find(component);
+      if (it == node->children.end()) {
+        break;
+      }
+      node = it->second.get();
+      collect(*node);
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const Record* a, const Record* b) { return a->seq < b->seq; });
+
+    std::vector<shared_ptr<InterestFilterRecord>> filters;
+    filters.reserve(matches.size());
+    for (const Record* record : matches) {
+      filters.push_back(record->filter);
+    }
+    return filters;
+  }
+
+private:
+  struct Record
+  {
+    shared_ptr<InterestFilterRecord> filter;
+    uint64_t seq; ///< insertion sequence number
+  };
+
+  struct Node
+  {
+    using Children = std::map<name::Component, unique_ptr<Node>>;
+
+    Node* parent = nullptr;
+    Children::iterator self; ///< position in parent's children, unused for root
+    Children children;
+    std::list<Record> records;
+  };
+
+  struct Position
+  {
+    Node* node;
+    std::list<Record>::iterator record;
+  };
+
+  static const InterestFilterId*
+  getKey(const InterestFilterRecord& filter)
+  {
+    return reinterpret_cast<const InterestFilterId*>(&filter);
+  }
+
+  /**
+   * @brief Remove @p node and its ancestors if they no longer hold any record
+   */
+  void
+  prune(Node* node)
+  {
+    while (node != &m_root && node->records.empty() && node->children.empty()) {
+      Node* parent = node->parent;
+      parent->children.erase(node->self);
+      node = parent;
+    }
+  }
+
+private:
+  Node m_root;
+  std::unordered_map<const InterestFilterId*, Position> m_index;
+  uint64_t m_nextSeq;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
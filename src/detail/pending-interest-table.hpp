@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "pending-interest.hpp"
+#include "../util/signal.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief A table of PendingInterest records indexed by Interest name
+ *
+ * Records are stored in a name tree keyed by the components of the Interest name.
+ * Finding the records that can be satisfied by a Data packet walks the Data name
+ * from the root, so its cost depends on the name length rather than the table size.
+ * Each record can also be located by its PendingInterestId in constant time.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  PendingInterestTable()
+    : m_nextSeq(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_index.empty();
+  }
+
+  /**
+   * @brief Insert a record
+   * @pre no record with the same Interest instance exists in the table
+   */
+  void
+  insert(const shared_ptr<PendingInterest>& entry)
+  {
+    const Name& name = entry->getInterest()->getName();
+    Node* node = &m_root;
+    for (const auto& component : name) {
+      auto it = node->children.find(component);
+      if (it == node->children.end()) {
+        it = node->children.emplace(component, make_unique<Node>()).first;
+        it->second->parent = node;
+        it->second->self = it;
+      }
+      node = it->second.get();
+    }
+
+    node->records.push_back({entry, m_nextSeq++});
+    Position& pos = m_index[getKey(*entry)];
+    pos.node = node;
+    pos.record = std::prev(node->records.end());
+  }
+
+  /**
+   * @brief Erase the record identified by @p id
+   * @return whether a record has been erased
+   */
+  bool
+  erase(const PendingInterestId* id)
+  {
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+      if (empty()) {
+        this->onEmpty();
+      }
+      return false;
+    }
+
+    Node* node = it->second.node;
+    // the record may hold the last reference to the PendingInterest, so it is destroyed last
+    shared_ptr<PendingInterest> entry = std::move(it->second.record->entry);
+    node->records.erase(it->second.record);
+    m_index.erase(it);
+    prune(node);
+
+    if (empty()) {
+      this->onEmpty();
+    }
+    return true;
+  }
+
+  bool
+  erase(const PendingInterest& entry)
+  {
+    return erase(getKey(entry));
+  }
+
+  void
+  clear()
+  {
+    m_index.clear();
+    m_root.children.clear();
+    m_root.records.clear();
+    this->onEmpty();
+  }
+
+  /**
+   * @brief Find records whose Interest can be satisfied by @p data
+   * @return matching records in insertion order
+   */
+  std::vector<shared_ptr<PendingInterest>>
+  findAllDataMatches(const Data& data) const
+  {
+    std::vector<const Record*> matches;
+    auto collect = [&matches, &data] (const Node& node) {
+      for (const Record& record : node.records) {
+        if (record.entry->getInterest()->matchesData(data)) {
+          matches.push_back(&record);
+        }
+      }
+    };
+
+    const Name& dataName = data.getName();
+    const Node* node = &m_root;
+    collect(*node);
+    for (const auto& component : dataName) {
+      auto it = node->children.find(component);
+      if (it == node->children.end()) {
+        return sortBySeq(matches);
+      }
+      node = it->second.get();
+      collect(*node);
+    }
+
+    // an Interest name may end with the implicit digest of the Data
+    if (!node->children.empty()) {
+      auto it = node->children.find(data.getFullName().get(-1));
+      if (it != node->children.end()) {
+        collect(*it->second);
+      }
+    }
+    return sortBySeq(matches);
+  }
+
+  /**
+   * @brief Find records whose Interest is matched by the Interest carried in @p nack
+   * @return matching records in insertion order
+   */
+  std::vector<shared_ptr<PendingInterest>>
+  findAllNackMatches(const lp::Nack& nack) const
+  {
+    std::vector<const Record*> matches;
+    const Interest& interest = nack.getInterest();
+    const Node* node = &m_root;
+    for (const auto& component : interest.getName()) {
+      auto it = node->children.find(component);
+      if (it == node->children.end()) {
+        return {};
+      }
+      node = it->second.get();
+    }
+
+    for (const Record& record : node->records) {
+      if (interest.matchesInterest(*record.entry->getInterest())) {
+        matches.push_back(&record);
+      }
+    }
+    return sortBySeq(matches);
+  }
+
+private:
+  struct Record
+  {
+    shared_ptr<PendingInterest> entry;
+    uint64_t seq; ///< insertion sequence number
+  };
+
+  struct Node
+  {
+    using Children = std::map<name::Component, unique_ptr<Node>>;
+
+    Node* parent = nullptr;
+    Children::iterator self; ///< position in parent's children, unused for root
+    Children children;
+    std::list<Record> records;
+  };
+
+  struct Position
+  {
+    Node* node;
+    std::list<Record>::iterator record;
+  };
+
+  static const PendingInterestId*
+  getKey(const PendingInterest& entry)
+  {
+    return reinterpret_cast<const PendingInterestId*>(entry.getInterest().get());
+  }
+
+  /**
+   * @brief Remove @p node and its ancestors if they no longer hold any record
+   */
+  void
+  prune(Node* node)
+  {
+    while (node != &m_root && node->records.empty() && node->children.empty()) {
+      Node* parent = node->parent;
+      parent->children.erase(node->self);
+      node = parent;
+    }
+  }
+
+  static std::vector<shared_ptr<PendingInterest>>
+  sortBySeq(std::vector<const Record*>& matches)
+  {
+    std::sort(matches.begin(), matches.end(),
+              [] (const Record* a, const Record* b) { return a->seq < b->seq; });
+
+    std::vector<shared_ptr<PendingInterest>> entries;
+    entries.reserve(matches.size());
+    for (const Record* record : matches) {
+      entries.push_back(record->entry);
+    }
+    return entries;
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when the table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  Node m_root;
+  std::unordered_map<const PendingInterestId*, Position> m_index;
+  uint64_t m_nextSeq;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -216,28 +216,6 @@ private:
  */
 class PendingInterestId;
 
-/**
- * @brief Functor to match PendingInterestId
- */
-class MatchPendingInterestId
-{
-public:
-  explicit
-  MatchPendingInterestId(const PendingInterestId* pendingInterestId)
-    : m_id(pendingInterestId)
-  {
-  }
-
-  bool
-  operator()(const shared_ptr<const PendingInterest>& pendingInterest) const
-  {
-    return reinterpret_cast<const PendingInterestId*>(pendingInterest->getInterest().get()) == m_id;
-  }
-
-private:
-  const PendingInterestId* m_id;
-};
-
 } // namespace ndn
 
 #endif // NDN_DETAIL_PENDING_INTEREST_HPP
@@ -22,6 +22,7 @@
  */
 
 #include "block.hpp"
+#include "buffer-pool.hpp"
 #include "buffer-stream.hpp"
 #include "encoding-buffer.hpp"
 #include "tlv.hpp"
@@ -122,7 +123,7 @@ Block::Block(const uint8_t* buf, size_t bufSize)
   size_t typeLengthSize = pos - buf;
   m_size = typeLengthSize + length;
 
-  m_buffer = make_shared<Buffer>(buf, m_size);
+  m_buffer = BufferPool::get().allocate(buf, m_size);
   m_begin = m_buffer->begin();
   m_end = m_valueEnd = m_buffer->end();
   m_valueBegin = m_begin + typeLengthSize;
@@ -192,25 +193,32 @@ std::tuple<bool, Block>
 Block::fromBuffer(ConstBufferPtr buffer, size_t offset)
 {
   const Buffer::const_iterator begin = buffer->begin() + offset;
+  const Buffer::const_iterator end = buffer->end();
+  return fromBuffer(std::move(buffer), begin, end);
+}
+
+std::tuple<bool, Block>
+Block::fromBuffer(ConstBufferPtr buffer, Buffer::const_iterator begin, Buffer::const_iterator end)
+{
   Buffer::const_iterator pos = begin;
 
   uint32_t type = 0;
-  bool isOk = tlv::readType(pos, buffer->end(), type);
+  bool isOk = tlv::readType(pos, end, type);
   if (!isOk) {
     return std::make_tuple(false, Block());
   }
   uint64_t length = 0;
-  isOk = tlv::readVarNumber(pos, buffer->end(), length);
+  isOk = tlv::readVarNumber(pos, end, length);
   if (!isOk) {
     return std::make_tuple(false, Block());
   }
   // pos now points to TLV-VALUE
 
-  if (length > static_cast<uint64_t>(buffer->end() - pos)) {
+  if (length > static_cast<uint64_t>(end - pos)) {
     return std::make_tuple(false, Block());
   }
 
-  return std::make_tuple(true, Block(buffer, type, begin, pos + length, pos, pos + length));
+  return std::make_tuple(true, Block(std::move(buffer), type, begin, pos + length, pos, pos + length));
 }
 
 std::tuple<bool, Block>
@@ -236,7 +244,7 @@ Block::fromBuffer(const uint8_t* buf, size_t bufSize)
   }
 
   size_t typeLengthSize = pos - buf;
-  auto b = make_shared<Buffer>(buf, pos + length);
+  auto b = BufferPool::get().allocate(buf, typeLengthSize + length);
   return std::make_tuple(true, Block(b, type, b->begin(), b->end(),
                                      b->begin() + typeLengthSize, b->end()));
 }
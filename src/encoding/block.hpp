@@ -153,6 +153,17 @@ public: // constructor, creation, assignment
   static std::tuple<bool, Block>
   fromBuffer(ConstBufferPtr buffer, size_t offset);
 
+  /** @brief Try to parse Block from a portion of a wire buffer
+   *  @param buffer a Buffer containing an TLV element at position @p begin
+   *  @param begin begin position of the TLV element within @p buffer
+   *  @param end end position of usable octets within @p buffer; may be beyond the TLV element
+   *  @note This function does not throw exceptions upon decoding failure.
+   *  @note The returned Block shares ownership of @p buffer, no octets are copied.
+   *  @return true and the Block if parsing succeeds; otherwise false
+   */
+  static std::tuple<bool, Block>
+  fromBuffer(ConstBufferPtr buffer, Buffer::const_iterator begin, Buffer::const_iterator end);
+
   /** @brief Try to parse Block from a raw buffer
    *  @param buf pointer to the first octet of an TLV element
    *  @param bufSize size of the raw buffer; may be more than size of the TLV element
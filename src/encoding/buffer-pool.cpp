@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "buffer-pool.hpp"
+#include "tlv.hpp"
+
+namespace ndn {
+
+constexpr size_t BufferPool::N_SIZE_CLASSES;
+const std::array<size_t, BufferPool::N_SIZE_CLASSES> BufferPool::SIZE_CLASSES{{
+  512, 2048, MAX_NDN_PACKET_SIZE
+}};
+const size_t BufferPool::DEFAULT_CAPACITY = 64;
+
+// The pool of each thread is owned by a thread-local Holder. t_pool and t_isShutdown are trivially
+// destructible, so that Buffers released during thread shutdown, after the Holder has been
+// destroyed, can still see that the pool is gone.
+static thread_local BufferPool* t_pool = nullptr;
+static thread_local bool t_isShutdown = false;
+
+class BufferPool::Holder : noncopyable
+{
+public:
+  Holder()
+    : pool(new BufferPool)
+  {
+    t_pool = pool.get();
+  }
+
+  ~Holder()
+  {
+    t_pool = nullptr;
+    t_isShutdown = true;
+  }
+
+public:
+  unique_ptr<BufferPool> pool;
+};
+
+BufferPool::Counters::Counters()
+  : nAllocations(0)
+  , nHits(0)
+  , nRecycled(0)
+{
+}
+
+BufferPool::BufferPool()
+  : m_capacity(DEFAULT_CAPACITY)
+{
+}
+
+BufferPool&
+BufferPool::get()
+{
+  if (t_pool == nullptr && t_isShutdown) {
+    // allocation during thread shutdown: use a non-recycling pool that is never destroyed
+    t_pool = new BufferPool;
+    t_pool->m_capacity = 0;
+  }
+  if (t_pool == nullptr) {
+    static thread_local Holder holder;
+  }
+  return *t_pool;
+}
+
+shared_ptr<Buffer>
+BufferPool::allocate(size_t size)
+{
+  ++m_counters.nAllocations;
+
+  ssize_t i = findClassForRequest(size);
+  if (i < 0) {
+    return make_shared<Buffer>(size);
+  }
+
+  unique_ptr<Buffer> buffer = acquire(i);
+  buffer->resize(size);
+  return shared_ptr<Buffer>(buffer.release(), Recycler());
+}
+
+shared_ptr<Buffer>
+BufferPool::allocate(const void* buf, size_t length)
+{
+  ++m_counters.nAllocations;
+
+  ssize_t i = findClassForRequest(length);
+  if (i < 0) {
+    return make_shared<Buffer>(buf, length);
+  }
+
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(buf);
+  unique_ptr<Buffer> buffer = acquire(i);
+  buffer->assign(begin, begin + length);
+  return shared_ptr<Buffer>(buffer.release(), Recycler());
+}
+
+unique_ptr<Buffer>
+BufferPool::acquire(size_t i)
+{
+  if (m_idle[i].empty()) {
+    unique_ptr<Buffer> buffer(new Buffer);
+    buffer->reserve(SIZE_CLASSES[i]);
+    return buffer;
+  }
+
+  ++m_counters.nHits;
+  unique_ptr<Buffer> buffer = std::move(m_idle[i].back());
+  m_idle[i].pop_back();
+  return buffer;
+}
+
+void
+BufferPool::setCapacity(size_t capacity)
+{
+  m_capacity = capacity;
+  for (auto& idle : m_idle) {
+    if (idle.size() > m_capacity) {
+      idle.resize(m_capacity);
+    }
+  }
+}
+
+size_t
+BufferPool::size() const
+{
+  size_t n = 0;
+  for (const auto& idle : m_idle) {
+    n += idle.size();
+  }
+  return n;
+}
+
+void
+BufferPool::clear()
+{
+  for (auto& idle : m_idle) {
+    idle.clear();
+  }
+}
+
+void
+BufferPool::Recycler::operator()(Buffer* buffer) const
+{
+  if (t_pool == nullptr && t_isShutdown) {
+    delete buffer;
+    return;
+  }
+  BufferPool::get().recycle(unique_ptr<Buffer>(buffer));
+}
+
+void
+BufferPool::recycle(unique_ptr<Buffer> buffer)
+{
+  ssize_t i = findClassForCapacity(buffer->capacity());
+  if (i < 0 || m_idle[i].size() >= m_capacity) {
+    return;
+  }
+
+  buffer->clear();
+  m_idle[i].push_back(std::move(buffer));
+  ++m_counters.nRecycled;
+}
+
+ssize_t
+BufferPool::findClassForRequest(size_t size)
+{
+  for (size_t i = 0; i < N_SIZE_CLASSES; ++i) {
+    if (size <= SIZE_CLASSES[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+ssize_t
+BufferPool::findClassForCapacity(size_t capacity)
+{
+  if (capacity > SIZE_CLASSES.back()) {
+    // do not hoard Buffers that have grown beyond the largest size class
+    return -1;
+  }
+  for (ssize_t i = N_SIZE_CLASSES - 1; i >= 0; --i) {
+    if (capacity >= SIZE_CLASSES[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+} // namespace ndn
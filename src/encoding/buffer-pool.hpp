@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BUFFER_POOL_HPP
+#define NDN_ENCODING_BUFFER_POOL_HPP
+
+#include "buffer.hpp"
+
+#include <array>
+
+namespace ndn {
+
+/** @brief Per-thread pool of reusable Buffers
+ *
+ *  Buffers handed out by the pool are grouped into a few size classes that cover common
+ *  packet sizes. When the last reference to such a Buffer goes away, the Buffer is returned to
+ *  the pool of the releasing thread, and its storage is reused by a later allocation of the same
+ *  size class. A request larger than the largest size class is served by a plain heap allocation.
+ *
+ *  Each thread has its own pool, obtained through BufferPool::get(), so that no locking is needed.
+ */
+class BufferPool : noncopyable
+{
+public:
+  static constexpr size_t N_SIZE_CLASSES = 3;
+
+  /** @brief capacities of the size classes, in ascending order
+   */
+  static const std::array<size_t, N_SIZE_CLASSES> SIZE_CLASSES;
+
+  /** @brief default maximum number of idle Buffers retained in each size class
+   */
+  static const size_t DEFAULT_CAPACITY;
+
+  /** @brief counters of a BufferPool
+   */
+  class Counters
+  {
+  public:
+    Counters();
+
+  public:
+    uint64_t nAllocations; ///< number of allocations served
+    uint64_t nHits;        ///< number of allocations served by a recycled Buffer
+    uint64_t nRecycled;    ///< number of released Buffers retained for reuse
+  };
+
+  /** @brief get the pool of the calling thread
+   */
+  static BufferPool&
+  get();
+
+  /** @brief create a zero-filled Buffer
+   *  @param size size of the Buffer
+   */
+  shared_ptr<Buffer>
+  allocate(size_t size);
+
+  /** @brief create a Buffer by copying contents from a raw buffer
+   *  @param buf const pointer to buffer to copy
+   *  @param length length of the buffer to copy
+   */
+  shared_ptr<Buffer>
+  allocate(const void* buf, size_t length);
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+  /** @brief set the maximum number of idle Buffers retained in each size class
+   *
+   *  Idle Buffers in excess of the new limit are freed. Zero disables recycling.
+   */
+  void
+  setCapacity(size_t capacity);
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /** @return number of idle Buffers currently retained by the pool
+   */
+  size_t
+  size() const;
+
+  /** @brief free all idle Buffers
+   */
+  void
+  clear();
+
+private:
+  BufferPool();
+
+  /** @brief deleter of pooled Buffers, which recycles the Buffer into the releasing thread's pool
+   */
+  class Recycler
+  {
+  public:
+    void
+    operator()(Buffer* buffer) const;
+  };
+
+  /** @brief take an idle Buffer of size class @p i, or create one if none is available
+   *  @post the returned Buffer is empty
+   */
+  unique_ptr<Buffer>
+  acquire(size_t i);
+
+  void
+  recycle(unique_ptr<Buffer> buffer);
+
+  /** @return index of the size class serving a request of @p size octets, or -1 if none
+   */
+  static ssize_t
+  findClassForRequest(size_t size);
+
+  /** @return index of the size class that can reuse a Buffer of @p capacity, or -1 if none
+   */
+  static ssize_t
+  findClassForCapacity(size_t capacity);
+
+private:
+  std::array<std::vector<unique_ptr<Buffer>>, N_SIZE_CLASSES> m_idle;
+  size_t m_capacity;
+  Counters m_counters;
+
+  class Holder;
+};
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BUFFER_POOL_HPP
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2016 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -20,12 +20,13 @@
  */
 
 #include "encoder.hpp"
+#include "buffer-pool.hpp"
 
 namespace ndn {
 namespace encoding {
 
 Encoder::Encoder(size_t totalReserve/* = MAX_NDN_PACKET_SIZE*/, size_t reserveFromBack/* = 400*/)
-  : m_buffer(new Buffer(totalReserve))
+  : m_buffer(BufferPool::get().allocate(totalReserve))
 {
   m_begin = m_end = m_buffer->end() - (reserveFromBack < totalReserve ? reserveFromBack : 0);
 }
@@ -75,10 +76,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_buffer->end() - m_end;
     size_t diffBegin = m_buffer->end() - m_begin;
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = BufferPool::get().allocate(size);
     std::copy_backward(m_buffer->begin(), m_buffer->end(), buf->end());
 
-    m_buffer.reset(buf);
+    m_buffer = std::move(buf);
 
     m_end = m_buffer->end() - diffEnd;
     m_begin = m_buffer->end() - diffBegin;
@@ -87,10 +88,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_end - m_buffer->begin();
     size_t diffBegin = m_begin - m_buffer->begin();
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = BufferPool::get().allocate(size);
     std::copy(m_buffer->begin(), m_buffer->end(), buf->begin());
 
-    m_buffer.reset(buf);
+    m_buffer = std::move(buf);
 
     m_end = m_buffer->begin() + diffEnd;
     m_begin = m_buffer->begin() + diffBegin;
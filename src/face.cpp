@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -380,12 +380,20 @@ extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
-  lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
-                                        // no need to distinguish
+  lp::Packet lpPacket;
+  Block netPacket;
+  if (blockFromDaemon.type() == tlv::Interest || blockFromDaemon.type() == tlv::Data) {
+    // bare Interest/Data is decoded directly, without wrapping into an lp::Packet
+    netPacket = blockFromDaemon;
+  }
+  else {
+    lpPacket.wireDecode(blockFromDaemon);
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    // the fragment lies within the wire buffer of blockFromDaemon, so it is not copied
+    netPacket = Block(blockFromDaemon, begin, end);
+  }
 
-  Buffer::const_iterator begin, end;
-  std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
   switch (netPacket.type()) {
     case tlv::Interest: {
       auto interest = make_shared<Interest>(netPacket);
@@ -393,12 +401,12 @@ Face::onReceiveElement(const Block& blockFromDaemon)
         auto nack = make_shared<lp::Nack>(std::move(*interest));
         nack->setHeader(lpPacket.get<lp::NackField>());
         extractLpLocalFields(*nack, lpPacket);
-        NDN_LOG_DEBUG(">N " << nack->getInterest() << '~' << nack->getHeader().getReason());
+        NDN_TRACE_DEBUG(">N {}~{}", nack->getInterest(), nack->getHeader().getReason());
         m_impl->nackPendingInterests(*nack);
       }
       else {
         extractLpLocalFields(*interest, lpPacket);
-        NDN_LOG_DEBUG(">I " << *interest);
+        NDN_TRACE_DEBUG(">I {}", *interest);
         m_impl->processIncomingInterest(std::move(interest));
       }
       break;
@@ -406,7 +414,7 @@ Face::onReceiveElement(const Block& blockFromDaemon)
     case tlv::Data: {
       auto data = make_shared<Data>(netPacket);
       extractLpLocalFields(*data, lpPacket);
-      NDN_LOG_DEBUG(">D " << data->getName());
+      NDN_TRACE_DEBUG(">D {}", data->getName());
       m_impl->satisfyPendingInterests(*data);
       break;
     }
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,7 +24,9 @@
 namespace ndn {
 
 InMemoryStorageEntry::InMemoryStorageEntry()
-  : m_isFresh(true)
+  : m_nameHash(0)
+  , m_fullNameHash(0)
+  , m_isFresh(true)
 {
 }
 
@@ -39,6 +41,8 @@ void
 InMemoryStorageEntry::setData(const Data& data)
 {
   m_dataPacket = data.shared_from_this();
+  m_nameHash = std::hash<Name>()(data.getName());
+  m_fullNameHash = std::hash<Name>()(data.getFullName());
   m_isFresh = true;
 }
 
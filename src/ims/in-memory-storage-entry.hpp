@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -59,6 +59,22 @@ public:
     return m_dataPacket->getFullName();
   }
 
+  /** @brief Returns the hash of the Data name, computed when the Data is set
+   */
+  size_t
+  getNameHash() const
+  {
+    return m_nameHash;
+  }
+
+  /** @brief Returns the hash of the Data full name, computed when the Data is set
+   */
+  size_t
+  getFullNameHash() const
+  {
+    return m_fullNameHash;
+  }
+
   /** @brief Returns the Data packet stored in the in-memory storage entry
    */
   const Data&
@@ -94,6 +110,8 @@ public:
 
 private:
   shared_ptr<const Data> m_dataPacket;
+  size_t m_nameHash;
+  size_t m_fullNameHash;
 
   bool m_isFresh;
   unique_ptr<util::scheduler::ScopedEventId> m_markStaleEventId;
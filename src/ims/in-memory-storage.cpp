@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -161,8 +161,7 @@ void
 InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshProcessingWindow)
 {
   //check if identical Data/Name already exists
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(data.getFullName());
-  if (it != m_cache.get<byFullName>().end())
+  if (findExact<byHashedFullName>(HashedName(data.getFullName())) != m_cache.end())
     return;
 
   //if full, double the capacity
@@ -197,9 +196,34 @@ InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshP
   afterInsert(entry);
 }
 
+template<typename Tag>
+InMemoryStorage::Cache::iterator
+InMemoryStorage::findExact(const HashedName& key)
+{
+  const auto& index = m_cache.get<Tag>();
+  auto range = index.equal_range(key, index.hash_function(), index.key_eq());
+  if (range.first == range.second || std::next(range.first) != range.second) {
+    // not found or not unique
+    return m_cache.end();
+  }
+  return m_cache.project<byFullName>(range.first);
+}
+
 shared_ptr<const Data>
 InMemoryStorage::find(const Name& name)
 {
+  // an exact match of the full name, or the only Data with this name, is the one that
+  // the prefix search would find
+  HashedName key(name);
+  Cache::iterator exact = findExact<byHashedFullName>(key);
+  if (exact == m_cache.end()) {
+    exact = findExact<byHashedName>(key);
+  }
+  if (exact != m_cache.end()) {
+    afterAccess(*exact);
+    return (*exact)->getData().shared_from_this();
+  }
+
   Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().lower_bound(name);
 
   //if not found, return null
@@ -220,17 +244,37 @@ shared_ptr<const Data>
 InMemoryStorage::find(const Interest& interest)
 {
   //if the interest contains implicit digest, it is possible to directly locate a packet.
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>()
-                                                    .find(interest.getName());
+  HashedName key(interest.getName());
+  Cache::iterator exact = findExact<byHashedFullName>(key);
 
   //if a packet is located by its full name, it must be the packet to return.
-  if (it != m_cache.get<byFullName>().end()) {
-    return ((*it)->getData()).shared_from_this();
+  if (exact != m_cache.end()) {
+    return (*exact)->getData().shared_from_this();
+  }
+
+  //without CanBePrefix, only a Data with exactly the Interest name can match;
+  //if there are several of them, ChildSelector decides in the prefix search below.
+  if (!interest.getCanBePrefix()) {
+    const auto& byNameIndex = m_cache.get<byHashedName>();
+    auto range = byNameIndex.equal_range(key, byNameIndex.hash_function(), byNameIndex.key_eq());
+    if (range.first == range.second) {
+      return nullptr;
+    }
+    if (std::next(range.first) == range.second) {
+      InMemoryStorageEntry* entry = *range.first;
+      if ((interest.getMustBeFresh() && !entry->isFresh()) ||
+          !interest.matchesData(entry->getData())) {
+        return nullptr;
+      }
+      afterAccess(entry);
+      return entry->getData().shared_from_this();
+    }
   }
 
   //if the packet is not discovered by last step, either the packet is not in the storage or
   //the interest doesn't contains implicit digest.
-  it = m_cache.get<byFullName>().lower_bound(interest.getName());
+  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>()
+                                                    .lower_bound(interest.getName());
 
   if (it == m_cache.get<byFullName>().end()) {
     return shared_ptr<const Data>();
@@ -380,9 +424,8 @@ InMemoryStorage::erase(const Name& prefix, const bool isPrefix)
     }
   }
   else {
-    Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(prefix);
-
-    if (it == m_cache.get<byFullName>().end())
+    Cache::iterator it = findExact<byHashedFullName>(HashedName(prefix));
+    if (it == m_cache.end())
       return;
 
     //let derived class do something with the entry
@@ -397,9 +440,8 @@ InMemoryStorage::erase(const Name& prefix, const bool isPrefix)
 void
 InMemoryStorage::eraseImpl(const Name& name)
 {
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(name);
-
-  if (it == m_cache.get<byFullName>().end())
+  Cache::iterator it = findExact<byHashedFullName>(HashedName(name));
+  if (it == m_cache.end())
     return;
 
   freeEntry(it);
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -28,6 +28,7 @@
 #include <stack>
 
 #include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
@@ -41,19 +42,114 @@ namespace ndn {
 class InMemoryStorage : noncopyable
 {
 public:
+  /** @brief a Name to look up in the hashed indexes, together with its hash
+   */
+  class HashedName
+  {
+  public:
+    explicit
+    HashedName(const Name& name)
+      : name(name)
+      , hash(std::hash<Name>()(name))
+    {
+    }
+
+  public:
+    const Name& name;
+    size_t hash;
+  };
+
+  /** @brief hash and equality on the Data name of entries, using the precomputed hash
+   */
+  class EntryNameHashEqual
+  {
+  public:
+    size_t
+    operator()(const InMemoryStorageEntry* entry) const
+    {
+      return entry->getNameHash();
+    }
+
+    size_t
+    operator()(const HashedName& key) const
+    {
+      return key.hash;
+    }
+
+    bool
+    operator()(const InMemoryStorageEntry* a, const InMemoryStorageEntry* b) const
+    {
+      return a->getName() == b->getName();
+    }
+
+    bool
+    operator()(const HashedName& key, const InMemoryStorageEntry* entry) const
+    {
+      return key.name == entry->getName();
+    }
+  };
+
+  /** @brief hash and equality on the Data full name of entries, using the precomputed hash
+   */
+  class EntryFullNameHashEqual
+  {
+  public:
+    size_t
+    operator()(const InMemoryStorageEntry* entry) const
+    {
+      return entry->getFullNameHash();
+    }
+
+    size_t
+    operator()(const HashedName& key) const
+    {
+      return key.hash;
+    }
+
+    bool
+    operator()(const InMemoryStorageEntry* a, const InMemoryStorageEntry* b) const
+    {
+      return a->getFullName() == b->getFullName();
+    }
+
+    bool
+    operator()(const HashedName& key, const InMemoryStorageEntry* entry) const
+    {
+      return key.name == entry->getFullName();
+    }
+  };
+
   // multi_index_container to implement storage
   class byFullName;
+  class byHashedFullName;
+  class byHashedName;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
     boost::multi_index::indexed_by<
 
-      // by Full Name
+      // by Full Name, for prefix matching and iteration in canonical order
       boost::multi_index::ordered_unique<
         boost::multi_index::tag<byFullName>,
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
                                           &InMemoryStorageEntry::getFullName>,
         std::less<Name>
+      >,
+
+      // by Full Name, for exact lookup
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byHashedFullName>,
+        boost::multi_index::identity<InMemoryStorageEntry*>,
+        EntryFullNameHashEqual,
+        EntryFullNameHashEqual
+      >,
+
+      // by Name, for exact lookup
+      boost::multi_index::hashed_non_unique<
+        boost::multi_index::tag<byHashedName>,
+        boost::multi_index::identity<InMemoryStorageEntry*>,
+        EntryNameHashEqual,
+        EntryNameHashEqual
       >
 
     >
@@ -300,6 +396,14 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
    *  child of the rightmost child.
    *  @return{ the best match, if any; otherwise 0 }
    */
+  /** @brief find the entry whose name, or full name, is exactly @p key, in a hashed index
+   *  @tparam Tag byHashedName or byHashedFullName
+   *  @return the entry, or m_cache.end() if there is none or more than one
+   */
+  template<typename Tag>
+  Cache::iterator
+  findExact(const HashedName& key);
+
   InMemoryStorageEntry*
   selectChild(const Interest& interest,
               Cache::index<byFullName>::type::iterator startingPoint) const;
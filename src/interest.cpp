@@ -38,6 +38,7 @@ static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
 Interest::Interest(const Name& name, time::milliseconds lifetime)
   : m_name(name)
   , m_interestLifetime(lifetime)
+  , m_deferredFields(0)
 {
   if (lifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
@@ -45,6 +46,7 @@ Interest::Interest(const Name& name, time::milliseconds lifetime)
 }
 
 Interest::Interest(const Block& wire)
+  : m_deferredFields(0)
 {
   wireDecode(wire);
 }
@@ -67,8 +69,8 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   // (reverse encoding)
 
   // ForwardingHint
-  if (m_forwardingHint.size() > 0) {
-    totalLength += m_forwardingHint.wireEncode(encoder);
+  if (getForwardingHint().size() > 0) {
+    totalLength += getForwardingHint().wireEncode(encoder);
   }
 
   // InterestLifetime
@@ -116,17 +118,18 @@ Interest::wireEncode() const
 }
 
 void
-Interest::wireDecode(const Block& wire)
+Interest::wireDecode(const Block& wire, bool wantLazyDecoding)
 {
   m_wire = wire;
   m_wire.parse();
+  m_deferredFields = 0;
 
   if (m_wire.type() != tlv::Interest) {
     BOOST_THROW_EXCEPTION(Error("expecting Interest element, got " + to_string(m_wire.type())));
   }
 
-  if (!decode02()) {
-    decode03();
+  if (!decode02(wantLazyDecoding)) {
+    decode03(wantLazyDecoding);
     if (!hasNonce()) {
       setNonce(getNonce());
     }
@@ -134,7 +137,7 @@ Interest::wireDecode(const Block& wire)
 }
 
 bool
-Interest::decode02()
+Interest::decode02(bool wantLazyDecoding)
 {
   auto ele = m_wire.elements_begin();
 
@@ -149,7 +152,13 @@ Interest::decode02()
 
   // Selectors?
   if (ele != m_wire.elements_end() && ele->type() == tlv::Selectors) {
-    m_selectors.wireDecode(*ele);
+    if (wantLazyDecoding) {
+      m_selectors = Selectors();
+      m_deferredFields |= DEFERRED_SELECTORS;
+    }
+    else {
+      m_selectors.wireDecode(*ele);
+    }
     ++ele;
   }
   else {
@@ -181,7 +190,13 @@ Interest::decode02()
 
   // ForwardingHint?
   if (ele != m_wire.elements_end() && ele->type() == tlv::ForwardingHint) {
-    m_forwardingHint.wireDecode(*ele, false);
+    if (wantLazyDecoding) {
+      m_forwardingHint = DelegationList();
+      m_deferredFields |= DEFERRED_FORWARDING_HINT;
+    }
+    else {
+      m_forwardingHint.wireDecode(*ele, false);
+    }
     ++ele;
   }
   else {
@@ -192,7 +207,7 @@ Interest::decode02()
 }
 
 void
-Interest::decode03()
+Interest::decode03(bool wantLazyDecoding)
 {
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -209,6 +224,7 @@ Interest::decode03()
   m_nonce.reset();
   m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
   m_forwardingHint = DelegationList();
+  m_deferredFields = 0; // discard fields deferred by a failed decode02
 
   int lastEle = 0; // last recognized element index, in spec order
   for (const Block& ele : m_wire.elements()) {
@@ -251,7 +267,12 @@ Interest::decode03()
         if (lastEle >= 4) {
           BOOST_THROW_EXCEPTION(Error("ForwardingHint element is out of order"));
         }
-        m_forwardingHint.wireDecode(ele);
+        if (wantLazyDecoding) {
+          m_deferredFields |= DEFERRED_FORWARDING_HINT;
+        }
+        else {
+          m_forwardingHint.wireDecode(ele);
+        }
         lastEle = 4;
         break;
       }
@@ -310,6 +331,26 @@ Interest::decode03()
   }
 }
 
+void
+Interest::decodeDeferredFieldsImpl(uint8_t fields)
+{
+  fields &= m_deferredFields;
+
+  // deferred fields are only set by a successful wireDecode, which has validated element order
+  if ((fields & DEFERRED_SELECTORS) != 0) {
+    m_selectors.wireDecode(*m_wire.find(tlv::Selectors));
+    m_deferredFields &= ~DEFERRED_SELECTORS;
+  }
+
+  if ((fields & DEFERRED_FORWARDING_HINT) != 0) {
+    // ForwardingHint follows the Nonce in v0.2 format, where it is decoded without sorting
+    auto fh = m_wire.find(tlv::ForwardingHint);
+    bool isV02 = m_wire.find(tlv::Nonce) < fh;
+    m_forwardingHint.wireDecode(*fh, !isV02);
+    m_deferredFields &= ~DEFERRED_FORWARDING_HINT;
+  }
+}
+
 std::string
 Interest::toUri() const
 {
@@ -453,8 +494,8 @@ Interest::getNonce() const
 Interest&
 Interest::setNonce(uint32_t nonce)
 {
+  resetWire();
   m_nonce = nonce;
-  m_wire.reset();
   return *this;
 }
 
@@ -478,16 +519,16 @@ Interest::setInterestLifetime(time::milliseconds lifetime)
   if (lifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
   }
+  resetWire();
   m_interestLifetime = lifetime;
-  m_wire.reset();
   return *this;
 }
 
 Interest&
 Interest::setForwardingHint(const DelegationList& value)
 {
+  resetWire();
   m_forwardingHint = value;
-  m_wire.reset();
   return *this;
 }
 
@@ -83,9 +83,16 @@ public:
   wireEncode() const;
 
   /** @brief Decode from @p wire in NDN Packet Format v0.2 or v0.3.
+   *  @param wire @c tlv::Interest element
+   *  @param wantLazyDecoding if true, Selectors and ForwardingHint are not decoded until first
+   *         access; only their position in the TLV structure is validated.
+   *
+   *  Lazy decoding reduces the per-packet cost for applications that look only at the Name,
+   *  such as filtering or caching proxies. If a deferred element is malformed, the error is
+   *  reported by the accessor that triggers its decoding rather than by this function.
    */
   void
-  wireDecode(const Block& wire);
+  wireDecode(const Block& wire, bool wantLazyDecoding = false);
 
   /** @brief Check if this instance has cached wire encoding.
    */
@@ -142,8 +149,8 @@ public: // element access
   Interest&
   setName(const Name& name)
   {
+    resetWire();
     m_name = name;
-    m_wire.reset();
     return *this;
   }
 
@@ -156,6 +163,7 @@ public: // element access
   bool
   getCanBePrefix() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getMaxSuffixComponents() != 1;
   }
 
@@ -169,8 +177,8 @@ public: // element access
   Interest&
   setCanBePrefix(bool canBePrefix)
   {
+    resetWire();
     m_selectors.setMaxSuffixComponents(canBePrefix ? -1 : 1);
-    m_wire.reset();
     return *this;
   }
 
@@ -183,6 +191,7 @@ public: // element access
   bool
   getMustBeFresh() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getMustBeFresh();
   }
 
@@ -196,14 +205,15 @@ public: // element access
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
+    resetWire();
     m_selectors.setMustBeFresh(mustBeFresh);
-    m_wire.reset();
     return *this;
   }
 
   const DelegationList&
   getForwardingHint() const
   {
+    decodeDeferredFields(DEFERRED_FORWARDING_HINT);
     return m_forwardingHint;
   }
 
@@ -224,8 +234,8 @@ public: // element access
   Interest&
   modifyForwardingHint(const Modifier& modifier)
   {
+    resetWire();
     modifier(m_forwardingHint);
-    m_wire.reset();
     return *this;
   }
 
@@ -276,6 +286,7 @@ public: // Selectors (deprecated)
   bool
   hasSelectors() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return !m_selectors.empty();
   }
 
@@ -283,6 +294,7 @@ public: // Selectors (deprecated)
   const Selectors&
   getSelectors() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors;
   }
 
@@ -290,8 +302,8 @@ public: // Selectors (deprecated)
   Interest&
   setSelectors(const Selectors& selectors)
   {
+    resetWire();
     m_selectors = selectors;
-    m_wire.reset();
     return *this;
   }
 
@@ -299,6 +311,7 @@ public: // Selectors (deprecated)
   int
   getMinSuffixComponents() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getMinSuffixComponents();
   }
 
@@ -306,8 +319,8 @@ public: // Selectors (deprecated)
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
+    resetWire();
     m_selectors.setMinSuffixComponents(minSuffixComponents);
-    m_wire.reset();
     return *this;
   }
 
@@ -315,6 +328,7 @@ public: // Selectors (deprecated)
   int
   getMaxSuffixComponents() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getMaxSuffixComponents();
   }
 
@@ -322,8 +336,8 @@ public: // Selectors (deprecated)
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
+    resetWire();
     m_selectors.setMaxSuffixComponents(maxSuffixComponents);
-    m_wire.reset();
     return *this;
   }
 
@@ -331,6 +345,7 @@ public: // Selectors (deprecated)
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getPublisherPublicKeyLocator();
   }
 
@@ -338,8 +353,8 @@ public: // Selectors (deprecated)
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
+    resetWire();
     m_selectors.setPublisherPublicKeyLocator(keyLocator);
-    m_wire.reset();
     return *this;
   }
 
@@ -347,6 +362,7 @@ public: // Selectors (deprecated)
   const Exclude&
   getExclude() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getExclude();
   }
 
@@ -354,8 +370,8 @@ public: // Selectors (deprecated)
   Interest&
   setExclude(const Exclude& exclude)
   {
+    resetWire();
     m_selectors.setExclude(exclude);
-    m_wire.reset();
     return *this;
   }
 
@@ -363,6 +379,7 @@ public: // Selectors (deprecated)
   int
   getChildSelector() const
   {
+    decodeDeferredFields(DEFERRED_SELECTORS);
     return m_selectors.getChildSelector();
   }
 
@@ -370,8 +387,8 @@ public: // Selectors (deprecated)
   Interest&
   setChildSelector(int childSelector)
   {
+    resetWire();
     m_selectors.setChildSelector(childSelector);
-    m_wire.reset();
     return *this;
   }
 
@@ -382,13 +399,41 @@ private:
    *  @throw tlv::Error decoding error within a sub-element.
    */
   bool
-  decode02();
+  decode02(bool wantLazyDecoding);
 
   /** @brief Decode @c m_wire as NDN Packet Format v0.3.
    *  @throw tlv::Error decoding error.
    */
   void
-  decode03();
+  decode03(bool wantLazyDecoding);
+
+  enum : uint8_t {
+    DEFERRED_SELECTORS = 1 << 0,
+    DEFERRED_FORWARDING_HINT = 1 << 1,
+    DEFERRED_ALL = DEFERRED_SELECTORS | DEFERRED_FORWARDING_HINT,
+  };
+
+  /** @brief Decode the specified @p fields if their decoding has been deferred
+   */
+  void
+  decodeDeferredFields(uint8_t fields) const
+  {
+    if ((m_deferredFields & fields) != 0) {
+      const_cast<Interest*>(this)->decodeDeferredFieldsImpl(fields);
+    }
+  }
+
+  void
+  decodeDeferredFieldsImpl(uint8_t fields);
+
+  /** @brief Clear wire encoding, after decoding all deferred fields from it
+   */
+  void
+  resetWire()
+  {
+    decodeDeferredFields(DEFERRED_ALL);
+    m_wire.reset();
+  }
 
 private:
   Name m_name;
@@ -398,6 +443,7 @@ private:
   DelegationList m_forwardingHint;
 
   mutable Block m_wire;
+  uint8_t m_deferredFields; ///< fields not yet decoded from m_wire
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Interest);
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "fragmenter.hpp"
+#include "../util/random.hpp"
+
+#include <limits>
+
+namespace ndn {
+namespace lp {
+
+/** \brief maximum overhead of an LpPacket carrying a fragment, excluding header fields
+ *
+ *  This includes the TLV-TYPE and TLV-LENGTH of LpPacket and Fragment, up to 3 octets each for a
+ *  length below 65536, a Sequence field, and FragIndex and FragCount fields with the largest
+ *  possible value.
+ */
+static const size_t MAX_FRAGMENT_OVERHEAD =
+  1 + 3 + // LpPacket TLV-TYPE and TLV-LENGTH
+  1 + 1 + sizeof(Sequence) + // Sequence
+  1 + 1 + 8 + // FragIndex
+  1 + 1 + 8 + // FragCount
+  1 + 3; // Fragment TLV-TYPE and TLV-LENGTH
+
+Fragmenter::Options::Options()
+  : maxFragments(400)
+{
+}
+
+Fragmenter::Fragmenter(const Options& options)
+  : m_options(options)
+  , m_nextSequence(random::generateWord64())
+{
+}
+
+std::vector<Packet>
+Fragmenter::fragment(const Packet& packet, size_t mtu)
+{
+  if (!packet.has<FragmentField>()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Packet has no Fragment field"));
+  }
+  if (packet.has<FragIndexField>() || packet.has<FragCountField>()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Packet is already fragmented"));
+  }
+
+  Block wire = packet.wireEncode();
+  if (wire.size() <= mtu) {
+    return {packet};
+  }
+
+  Buffer::const_iterator payloadBegin, payloadEnd;
+  std::tie(payloadBegin, payloadEnd) = packet.get<FragmentField>();
+  size_t payloadSize = std::distance(payloadBegin, payloadEnd);
+
+  // header fields are carried by the first fragment only
+  Packet header(packet);
+  header.clear<FragmentField>();
+  header.clear<SequenceField>();
+  size_t headerSize = header.empty() ? 0 : header.wireEncode().value_size();
+
+  // MAX_FRAGMENT_OVERHEAD assumes TLV-LENGTH below 65536
+  mtu = std::min<size_t>(mtu, std::numeric_limits<uint16_t>::max());
+  if (mtu <= MAX_FRAGMENT_OVERHEAD + headerSize) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("MTU is too small to fragment the packet"));
+  }
+  size_t firstPayloadSize = std::min(payloadSize, mtu - MAX_FRAGMENT_OVERHEAD - headerSize);
+  size_t payloadSizePerFragment = mtu - MAX_FRAGMENT_OVERHEAD;
+  size_t nFragments = 1 + (payloadSize - firstPayloadSize + payloadSizePerFragment - 1) /
+                          payloadSizePerFragment;
+  if (nFragments > m_options.maxFragments) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Packet needs " + to_string(nFragments) +
+                                                " fragments, which exceeds the limit"));
+  }
+
+  std::vector<Packet> fragments;
+  fragments.reserve(nFragments);
+  auto begin = payloadBegin;
+  for (size_t i = 0; i < nFragments; ++i) {
+    auto end = begin + std::min<size_t>(std::distance(begin, payloadEnd),
+                                        i == 0 ? firstPayloadSize : payloadSizePerFragment);
+    Packet frag = i == 0 ? header : Packet();
+    frag.add<SequenceField>(m_nextSequence++);
+    frag.add<FragIndexField>(i);
+    frag.add<FragCountField>(nFragments);
+    frag.add<FragmentField>(std::make_pair(begin, end));
+    fragments.push_back(std::move(frag));
+    begin = end;
+  }
+  BOOST_ASSERT(begin == payloadEnd);
+
+  return fragments;
+}
+
+} // namespace lp
+} // namespace ndn
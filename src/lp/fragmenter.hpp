@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_FRAGMENTER_HPP
+#define NDN_CXX_LP_FRAGMENTER_HPP
+
+#include "packet.hpp"
+
+namespace ndn {
+namespace lp {
+
+/** \brief splits an LpPacket into fragments that fit into the MTU of a link
+ *
+ *  Fragments of the same packet carry consecutive Sequence numbers, together with FragIndex and
+ *  FragCount, as required by the NDNLPv2 fragmentation feature.  Header fields of the original
+ *  packet are copied into the first fragment only.
+ *
+ *  \sa Reassembler
+ */
+class Fragmenter : noncopyable
+{
+public:
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    /** \brief maximum number of fragments of a packet
+     */
+    size_t maxFragments;
+  };
+
+  /** \brief construct a fragmenter whose first Sequence number is chosen randomly
+   */
+  explicit
+  Fragmenter(const Options& options = Options());
+
+  /** \brief fragment \p packet so that each fragment encodes into at most \p mtu octets
+   *  \param packet LpPacket with a Fragment field and no fragmentation field
+   *  \param mtu maximum size of an encoded fragment
+   *  \return \p packet itself if it fits into \p mtu, otherwise the fragments in order
+   *  \throw std::invalid_argument \p packet has no Fragment field or is already fragmented,
+   *                               \p mtu is too small, or more than maxFragments fragments are
+   *                               needed
+   */
+  std::vector<Packet>
+  fragment(const Packet& packet, size_t mtu);
+
+  /** \return the Sequence number assigned to the first fragment of the next fragmented packet
+   */
+  Sequence
+  getNextSequence() const
+  {
+    return m_nextSequence;
+  }
+
+private:
+  const Options m_options;
+  Sequence m_nextSequence;
+};
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_FRAGMENTER_HPP
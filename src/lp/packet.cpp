@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -131,7 +131,7 @@ Block
 Packet::wireEncode() const
 {
   // If no header or trailer, return bare network packet
-  Block::element_container elements = m_wire.elements();
+  const Block::element_container& elements = m_wire.elements();
   if (elements.size() == 1 && elements.front().type() == FragmentField::TlvType::value) {
     elements.front().parse();
     return elements.front().elements().front();
@@ -146,6 +146,7 @@ Packet::wireDecode(const Block& wire)
 {
   if (wire.type() == ndn::tlv::Interest || wire.type() == ndn::tlv::Data) {
     m_wire = Block(tlv::LpPacket);
+    m_index.clear();
     add<FragmentField>(make_pair(wire.begin(), wire.end()));
     return;
   }
@@ -156,6 +157,8 @@ Packet::wireDecode(const Block& wire)
 
   wire.parse();
 
+  std::vector<FieldRange> index;
+  size_t pos = 0;
   bool isFirst = true;
   FieldInfo prev;
   for (const Block& element : wire.elements()) {
@@ -175,11 +178,36 @@ Packet::wireDecode(const Block& wire)
       }
     }
 
+    if (isFirst || info.tlvType != prev.tlvType) {
+      index.push_back({info.tlvType, pos, 1});
+    }
+    else {
+      ++index.back().count;
+    }
+
+    ++pos;
     isFirst = false;
     prev = info;
   }
 
   m_wire = wire;
+  m_index = std::move(index);
+}
+
+void
+Packet::rebuildIndex()
+{
+  m_index.clear();
+
+  const Block::element_container& elements = m_wire.elements();
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (m_index.empty() || m_index.back().tlvType != elements[i].type()) {
+      m_index.push_back({elements[i].type(), i, 1});
+    }
+    else {
+      ++m_index.back().count;
+    }
+  }
 }
 
 bool
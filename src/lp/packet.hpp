@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -87,9 +87,8 @@ public: // field access
   size_t
   count() const
   {
-    return std::count_if(m_wire.elements_begin(), m_wire.elements_end(),
-                         [] (const Block& block) {
-                           return block.type() == FIELD::TlvType::value; });
+    const FieldRange* range = findField(FIELD::TlvType::value);
+    return range == nullptr ? 0 : range->count;
   }
 
   /**
@@ -100,17 +99,12 @@ public: // field access
   typename FIELD::ValueType
   get(size_t index = 0) const
   {
-    size_t count = 0;
-    for (const Block& element : m_wire.elements()) {
-      if (element.type() != FIELD::TlvType::value) {
-        continue;
-      }
-      if (count++ == index) {
-        return FIELD::decode(element);
-      }
+    const FieldRange* range = findField(FIELD::TlvType::value);
+    if (range == nullptr || index >= range->count) {
+      BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
     }
 
-    BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
+    return FIELD::decode(m_wire.elements()[range->first + index]);
   }
 
   /**
@@ -122,11 +116,12 @@ public: // field access
   {
     std::vector<typename FIELD::ValueType> output;
 
-    for (const Block& element : m_wire.elements()) {
-      if (element.type() != FIELD::TlvType::value) {
-        continue;
+    const FieldRange* range = findField(FIELD::TlvType::value);
+    if (range != nullptr) {
+      output.reserve(range->count);
+      for (size_t i = range->first; i < range->first + range->count; ++i) {
+        output.push_back(FIELD::decode(m_wire.elements()[i]));
       }
-      output.push_back(FIELD::decode(element));
     }
 
     return output;
@@ -165,6 +160,7 @@ public: // field access
     auto pos = std::upper_bound(m_wire.elements_begin(), m_wire.elements_end(),
                                 FIELD::TlvType::value, comparePos);
     m_wire.insert(pos, block);
+    rebuildIndex();
 
     return *this;
   }
@@ -177,18 +173,14 @@ public: // field access
   Packet&
   remove(size_t index = 0)
   {
-    size_t count = 0;
-    for (auto it = m_wire.elements_begin(); it != m_wire.elements_end(); ++it) {
-      if (it->type() == FIELD::TlvType::value) {
-        if (count == index) {
-          m_wire.erase(it);
-          return *this;
-        }
-        count++;
-      }
+    const FieldRange* range = findField(FIELD::TlvType::value);
+    if (range == nullptr || index >= range->count) {
+      BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
     }
 
-    BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
+    m_wire.erase(m_wire.elements_begin() + range->first + index);
+    rebuildIndex();
+    return *this;
   }
 
   /**
@@ -199,15 +191,51 @@ public: // field access
   clear()
   {
     m_wire.remove(FIELD::TlvType::value);
+    rebuildIndex();
     return *this;
   }
 
 private:
+  /**
+   * \brief position of the occurrences of a field among the elements of m_wire
+   *
+   * Fields are kept in sort order, so that all occurrences of a field are contiguous.
+   */
+  struct FieldRange
+  {
+    uint64_t tlvType;
+    size_t first;
+    size_t count;
+  };
+
+  /**
+   * \return position of the field with TLV-TYPE \p tlvType, or nullptr if it does not occur
+   * \note The index has at most one entry per known field type, so that the lookup takes
+   *       constant time regardless of the number of occurrences.
+   */
+  const FieldRange*
+  findField(uint64_t tlvType) const
+  {
+    for (const FieldRange& range : m_index) {
+      if (range.tlvType == tlvType) {
+        return &range;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * \brief recompute m_index from the elements of m_wire
+   */
+  void
+  rebuildIndex();
+
   static bool
   comparePos(uint64_t first, const Block& second);
 
 private:
   mutable Block m_wire;
+  std::vector<FieldRange> m_index;
 };
 
 } // namespace lp
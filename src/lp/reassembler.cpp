@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "reassembler.hpp"
+#include "../util/logger.hpp"
+
+namespace ndn {
+namespace lp {
+
+NDN_LOG_INIT(ndn.lp.Reassembler);
+
+Reassembler::Options::Options()
+  : maxFragments(400)
+  , maxPartialPackets(256)
+  , reassemblyTimeout(time::milliseconds(500))
+{
+}
+
+Reassembler::Reassembler(util::Scheduler& scheduler, const Options& options)
+  : m_scheduler(scheduler)
+  , m_options(options)
+{
+}
+
+Reassembler::Result
+Reassembler::receiveFragment(EndpointId remoteEndpoint, const Packet& packet)
+{
+  Result result;
+
+  if (!packet.has<FragmentField>()) {
+    NDN_LOG_TRACE("Dropping packet without Fragment from " << remoteEndpoint);
+    return result;
+  }
+
+  size_t fragIndex = packet.has<FragIndexField>() ? packet.get<FragIndexField>() : 0;
+  size_t fragCount = packet.has<FragCountField>() ? packet.get<FragCountField>() : 1;
+
+  if (fragIndex >= fragCount) {
+    NDN_LOG_TRACE("Dropping fragment with FragIndex " << fragIndex << " >= FragCount " <<
+                  fragCount << " from " << remoteEndpoint);
+    return result;
+  }
+  if (fragCount > m_options.maxFragments) {
+    NDN_LOG_TRACE("Dropping fragment with FragCount " << fragCount << " from " << remoteEndpoint);
+    return result;
+  }
+
+  if (fragCount == 1) {
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = packet.get<FragmentField>();
+    try {
+      result.netPkt = Block(&*begin, std::distance(begin, end));
+    }
+    catch (const ndn::tlv::Error&) {
+      NDN_LOG_TRACE("Dropping malformed packet from " << remoteEndpoint);
+      return result;
+    }
+    result.isComplete = true;
+    result.firstFragment = packet;
+    return result;
+  }
+
+  if (!packet.has<SequenceField>()) {
+    NDN_LOG_TRACE("Dropping fragment without Sequence from " << remoteEndpoint);
+    return result;
+  }
+
+  Key key(remoteEndpoint, packet.get<SequenceField>() - fragIndex);
+  auto it = m_partialPackets.find(key);
+  if (it == m_partialPackets.end()) {
+    if (m_partialPackets.size() >= m_options.maxPartialPackets) {
+      NDN_LOG_TRACE("Too many partial packets, evicting the oldest");
+      drop(m_ages.front());
+    }
+
+    it = m_partialPackets.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                                  std::forward_as_tuple(m_scheduler)).first;
+    it->second.fragments.resize(fragCount);
+    it->second.fragCount = fragCount;
+    it->second.agePos = m_ages.insert(m_ages.end(), key);
+  }
+
+  PartialPacket& pp = it->second;
+  if (pp.fragCount != fragCount) {
+    NDN_LOG_TRACE("Dropping fragment with inconsistent FragCount from " << remoteEndpoint);
+    return result;
+  }
+  if (pp.fragments[fragIndex].empty()) {
+    pp.fragments[fragIndex] = packet;
+    ++pp.nReceivedFragments;
+  }
+
+  if (pp.nReceivedFragments == pp.fragCount) {
+    return reassemble(it);
+  }
+
+  pp.dropTimer = m_scheduler.scheduleEvent(m_options.reassemblyTimeout, [this, key] { drop(key); });
+  return result;
+}
+
+Reassembler::Result
+Reassembler::reassemble(std::map<Key, PartialPacket>::iterator it)
+{
+  Result result;
+  PartialPacket& pp = it->second;
+
+  size_t netPktSize = 0;
+  for (const Packet& frag : pp.fragments) {
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = frag.get<FragmentField>();
+    netPktSize += std::distance(begin, end);
+  }
+
+  auto buffer = make_shared<Buffer>();
+  buffer->reserve(netPktSize);
+  for (const Packet& frag : pp.fragments) {
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = frag.get<FragmentField>();
+    buffer->insert(buffer->end(), begin, end);
+  }
+
+  result.firstFragment = std::move(pp.fragments.front());
+  m_ages.erase(pp.agePos);
+  m_partialPackets.erase(it);
+
+  try {
+    result.netPkt = Block(buffer);
+  }
+  catch (const ndn::tlv::Error&) {
+    NDN_LOG_TRACE("Dropping malformed reassembled packet");
+    return Result();
+  }
+  result.isComplete = true;
+  return result;
+}
+
+void
+Reassembler::drop(const Key& key)
+{
+  auto it = m_partialPackets.find(key);
+  if (it == m_partialPackets.end()) {
+    return;
+  }
+
+  NDN_LOG_TRACE("Dropping partial packet " << key.second << " from " << key.first);
+  this->beforeDrop(key.first, it->second.nReceivedFragments);
+  m_ages.erase(it->second.agePos);
+  m_partialPackets.erase(it);
+}
+
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_REASSEMBLER_HPP
+#define NDN_CXX_LP_REASSEMBLER_HPP
+
+#include "packet.hpp"
+#include "../util/scheduler.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/signal.hpp"
+
+#include <list>
+#include <map>
+
+namespace ndn {
+namespace lp {
+
+/** \brief reassembles network-layer packets from NDNLPv2 fragments
+ *
+ *  Fragments are grouped into partial packets by remote endpoint and by the Sequence number of
+ *  the first fragment, i.e. Sequence minus FragIndex.  Memory is bounded by the maximum number
+ *  of partial packets and the maximum number of fragments per packet; when the former is
+ *  reached, the oldest partial packet is dropped.  A partial packet that does not receive a
+ *  fragment within the reassembly timeout is dropped as well.
+ *
+ *  \sa Fragmenter
+ */
+class Reassembler : noncopyable
+{
+public:
+  /** \brief identifies the remote endpoint of a link, e.g. a UDP endpoint in a multicast group
+   */
+  typedef uint64_t EndpointId;
+
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    /** \brief maximum number of fragments of a packet; packets with more fragments are dropped
+     */
+    size_t maxFragments;
+
+    /** \brief maximum number of packets being reassembled at the same time
+     */
+    size_t maxPartialPackets;
+
+    /** \brief time after the last received fragment when a partial packet is dropped
+     */
+    time::nanoseconds reassemblyTimeout;
+  };
+
+  /** \brief outcome of receiveFragment()
+   */
+  class Result
+  {
+  public:
+    /** \brief whether a network-layer packet has been completely received
+     */
+    bool isComplete = false;
+
+    /** \brief the reassembled network-layer packet, valid when isComplete is true
+     */
+    Block netPkt;
+
+    /** \brief the first fragment, which carries the header fields of the packet
+     */
+    Packet firstFragment;
+  };
+
+  explicit
+  Reassembler(util::Scheduler& scheduler, const Options& options = Options());
+
+  /** \brief add a received fragment
+   *
+   *  A packet that is not fragmented is returned immediately.  Invalid fragments, e.g. one
+   *  without a Sequence field or with a FragIndex beyond its FragCount, are dropped.
+   */
+  Result
+  receiveFragment(EndpointId remoteEndpoint, const Packet& packet);
+
+  /** \return number of packets being reassembled
+   */
+  size_t
+  size() const
+  {
+    return m_partialPackets.size();
+  }
+
+public:
+  /** \brief signals before a partial packet is dropped due to timeout or eviction
+   *
+   *  The arguments are the remote endpoint and the number of fragments received for the packet.
+   */
+  util::signal::Signal<Reassembler, EndpointId, size_t> beforeDrop;
+
+private:
+  typedef std::pair<EndpointId, Sequence> Key;
+
+  struct PartialPacket
+  {
+    explicit
+    PartialPacket(util::Scheduler& scheduler)
+      : dropTimer(scheduler)
+    {
+    }
+
+    std::vector<Packet> fragments;
+    size_t fragCount = 0;
+    size_t nReceivedFragments = 0;
+    std::list<Key>::iterator agePos;
+    util::scheduler::ScopedEventId dropTimer;
+  };
+
+  Result
+  reassemble(std::map<Key, PartialPacket>::iterator it);
+
+  void
+  drop(const Key& key);
+
+private:
+  util::Scheduler& m_scheduler;
+  const Options m_options;
+  std::map<Key, PartialPacket> m_partialPackets;
+  std::list<Key> m_ages; ///< keys of partial packets, oldest first
+};
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_REASSEMBLER_HPP
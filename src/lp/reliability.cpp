@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "reliability.hpp"
+#include "../encoding/tlv.hpp"
+#include "../util/logger.hpp"
+#include "../util/random.hpp"
+
+namespace ndn {
+namespace lp {
+
+NDN_LOG_INIT(ndn.lp.Reliability);
+
+/** \brief encoded size of an Ack or TxSequence field
+ */
+static const size_t SEQUENCE_FIELD_SIZE = 3 + 1 + sizeof(Sequence);
+
+Reliability::Options::Options()
+  : idleAckTimerPeriod(time::milliseconds(5))
+  , maxRetx(3)
+  , mtu(MAX_NDN_PACKET_SIZE)
+{
+}
+
+Reliability::Reliability(util::Scheduler& scheduler, const SendFrameCallback& sendFrame,
+                         const Options& options)
+  : m_scheduler(scheduler)
+  , m_sendFrame(sendFrame)
+  , m_options(options)
+  , m_rttEst(options.rttOptions)
+  , m_nextTxSequence(random::generateWord64())
+  , m_idleAckTimer(scheduler)
+{
+  BOOST_ASSERT(m_sendFrame != nullptr);
+}
+
+void
+Reliability::sendFrame(Packet frame)
+{
+  frame.clear<AckField>();
+  frame.clear<TxSequenceField>();
+  transmit(std::move(frame), 0);
+}
+
+void
+Reliability::transmit(Packet frame, size_t nRetx)
+{
+  Sequence txSeq = m_nextTxSequence++;
+  auto it = m_unackedFrames.emplace(std::piecewise_construct, std::forward_as_tuple(txSeq),
+                                    std::forward_as_tuple(m_scheduler)).first;
+  UnackedFrame& unacked = it->second;
+  unacked.frame = frame;
+  unacked.sendTime = time::steady_clock::now();
+  unacked.nRetx = nRetx;
+  unacked.rtoTimer = m_scheduler.scheduleEvent(m_rttEst.getEstimatedRto(),
+                                               [this, txSeq] { onRto(txSeq); });
+
+  frame.set<TxSequenceField>(txSeq);
+  piggybackAcks(frame);
+  m_sendFrame(frame);
+}
+
+void
+Reliability::piggybackAcks(Packet& frame)
+{
+  if (m_pendingAcks.empty()) {
+    return;
+  }
+
+  // the outer TLV-LENGTH may grow by up to 2 octets when Acks are added
+  size_t size = frame.wireEncode().size() + 2;
+  while (!m_pendingAcks.empty() && size + SEQUENCE_FIELD_SIZE <= m_options.mtu) {
+    frame.add<AckField>(m_pendingAcks.front());
+    m_pendingAcks.pop_front();
+    size += SEQUENCE_FIELD_SIZE;
+  }
+
+  if (m_pendingAcks.empty()) {
+    m_idleAckTimer.cancel();
+  }
+}
+
+void
+Reliability::processIncoming(const Packet& frame)
+{
+  auto now = time::steady_clock::now();
+  for (Sequence ack : frame.list<AckField>()) {
+    auto it = m_unackedFrames.find(ack);
+    if (it == m_unackedFrames.end()) {
+      NDN_LOG_TRACE("Ignoring Ack " << ack << " of unknown frame");
+      continue;
+    }
+
+    // Karn's algorithm: the RTT of a retransmitted frame is ambiguous
+    if (it->second.nRetx == 0) {
+      m_rttEst.addMeasurement(now - it->second.sendTime, m_unackedFrames.size());
+    }
+    m_unackedFrames.erase(it);
+  }
+
+  if (frame.has<TxSequenceField>()) {
+    m_pendingAcks.push_back(frame.get<TxSequenceField>());
+    if (m_pendingAcks.size() == 1) {
+      m_idleAckTimer = m_scheduler.scheduleEvent(m_options.idleAckTimerPeriod,
+                                                 [this] { onIdleAckTimer(); });
+    }
+  }
+}
+
+void
+Reliability::onRto(Sequence txSeq)
+{
+  auto it = m_unackedFrames.find(txSeq);
+  BOOST_ASSERT(it != m_unackedFrames.end());
+  Packet frame = std::move(it->second.frame);
+  size_t nRetx = it->second.nRetx;
+  m_unackedFrames.erase(it);
+
+  m_rttEst.backoffRto();
+  if (nRetx >= m_options.maxRetx) {
+    NDN_LOG_DEBUG("Frame " << txSeq << " lost after " << nRetx << " retransmissions");
+    this->onFrameLost(frame);
+    return;
+  }
+
+  NDN_LOG_TRACE("Retransmitting frame " << txSeq);
+  transmit(std::move(frame), nRetx + 1);
+}
+
+void
+Reliability::onIdleAckTimer()
+{
+  while (!m_pendingAcks.empty()) {
+    Packet frame;
+    piggybackAcks(frame);
+    if (!frame.has<AckField>()) {
+      NDN_LOG_WARN("MTU is too small to carry an Ack");
+      m_pendingAcks.clear();
+      return;
+    }
+    m_sendFrame(frame);
+  }
+}
+
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_RELIABILITY_HPP
+#define NDN_CXX_LP_RELIABILITY_HPP
+
+#include "packet.hpp"
+#include "../util/rtt-estimator.hpp"
+#include "../util/scheduler.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/signal.hpp"
+
+#include <deque>
+#include <map>
+
+namespace ndn {
+namespace lp {
+
+/** \brief provides hop-by-hop acknowledgement and retransmission of LpPackets
+ *
+ *  Each outgoing frame is assigned a TxSequence number and kept until the peer acknowledges it.
+ *  Acknowledgements of received frames are piggybacked onto outgoing frames as long as they fit
+ *  into the MTU; if no frame is sent within the idle ack timer period, they are sent in a frame
+ *  of their own.  A frame that is not acknowledged within the retransmission timeout is sent
+ *  again with a new TxSequence, and is reported as lost after the maximum number of
+ *  retransmissions.  RTT is sampled only from frames that have not been retransmitted.
+ */
+class Reliability : noncopyable
+{
+public:
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    /** \brief maximum time to hold an acknowledgement before sending it in a frame of its own
+     */
+    time::nanoseconds idleAckTimerPeriod;
+
+    /** \brief maximum number of retransmissions of a frame
+     */
+    size_t maxRetx;
+
+    /** \brief maximum size of an encoded frame, limits the number of piggybacked Acks
+     */
+    size_t mtu;
+
+    /** \brief options of the RTT estimator that computes the retransmission timeout
+     */
+    util::RttEstimator::Options rttOptions;
+  };
+
+  /** \brief callback to transmit a frame on the link
+   */
+  typedef function<void(const Packet& frame)> SendFrameCallback;
+
+  Reliability(util::Scheduler& scheduler, const SendFrameCallback& sendFrame,
+              const Options& options = Options());
+
+  /** \brief assign a TxSequence to \p frame, piggyback pending Acks, and send it
+   */
+  void
+  sendFrame(Packet frame);
+
+  /** \brief process Acks in a received frame, and schedule the acknowledgement of its TxSequence
+   */
+  void
+  processIncoming(const Packet& frame);
+
+  /** \return number of frames that have been sent but not yet acknowledged
+   */
+  size_t
+  getNUnackedFrames() const
+  {
+    return m_unackedFrames.size();
+  }
+
+  /** \return number of received TxSequences that have not been acknowledged yet
+   */
+  size_t
+  getNPendingAcks() const
+  {
+    return m_pendingAcks.size();
+  }
+
+  const util::RttEstimator&
+  getRttEstimator() const
+  {
+    return m_rttEst;
+  }
+
+public:
+  /** \brief signals when a frame is given up after the maximum number of retransmissions
+   *
+   *  The argument is the frame as last sent, with Ack and TxSequence fields removed.
+   */
+  util::signal::Signal<Reliability, Packet> onFrameLost;
+
+private:
+  struct UnackedFrame
+  {
+    explicit
+    UnackedFrame(util::Scheduler& scheduler)
+      : rtoTimer(scheduler)
+    {
+    }
+
+    Packet frame; ///< frame without Ack and TxSequence fields
+    time::steady_clock::TimePoint sendTime;
+    size_t nRetx = 0;
+    util::scheduler::ScopedEventId rtoTimer;
+  };
+
+  void
+  transmit(Packet frame, size_t nRetx);
+
+  void
+  piggybackAcks(Packet& frame);
+
+  void
+  onRto(Sequence txSeq);
+
+  void
+  onIdleAckTimer();
+
+private:
+  util::Scheduler& m_scheduler;
+  SendFrameCallback m_sendFrame;
+  const Options m_options;
+  util::RttEstimator m_rttEst;
+  Sequence m_nextTxSequence;
+  std::map<Sequence, UnackedFrame> m_unackedFrames;
+  std::deque<Sequence> m_pendingAcks;
+  util::scheduler::ScopedEventId m_idleAckTimer;
+};
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_RELIABILITY_HPP
@@ -21,8 +21,11 @@
 
 #include "dispatcher.hpp"
 #include "../lp/tags.hpp"
+#include "../security/signing-helpers.hpp"
 #include "../util/logger.hpp"
 
+#include <boost/asio/io_service.hpp>
+
 NDN_LOG_INIT(ndn.mgmt.Dispatcher);
 
 namespace ndn {
@@ -30,6 +33,10 @@ namespace mgmt {
 
 const time::milliseconds DEFAULT_FRESHNESS_PERIOD = 1_s;
 
+/** \brief marks a Data packet in the in-memory storage that must be signed before sending
+ */
+using SigningDeferredTag = SimpleTag<bool, 1010>;
+
 Authorization
 makeAcceptAllAuthorization()
 {
@@ -48,6 +55,8 @@ Dispatcher::Dispatcher(Face& face, KeyChain& keyChain,
   : m_face(face)
   , m_keyChain(keyChain)
   , m_signingInfo(signingInfo)
+  , m_segmentSize(MAX_NDN_PACKET_SIZE >> 1)
+  , m_wantDeferredSigning(false)
   , m_storage(m_face.getIoService(), imsCapacity)
 {
 }
@@ -151,6 +160,12 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
     if (missContinuation)
       missContinuation(prefix, interest);
   }
+  else if (data->getTag<SigningDeferredTag>() != nullptr) {
+    Data signedData(*data);
+    signedData.removeTag<SigningDeferredTag>();
+    m_keyChain.sign(signedData, m_signingInfo);
+    sendOnFace(signedData);
+  }
   else {
     // send the fetched data through face if query succeeds.
     sendOnFace(*data);
@@ -159,12 +174,22 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
 
 void
 Dispatcher::sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
-                     SendDestination option, time::milliseconds imsFresh)
+                     SendDestination option, time::milliseconds imsFresh,
+                     bool isSigningDeferred)
 {
+  BOOST_ASSERT(!isSigningDeferred || option == SendDestination::IMS);
+
   auto data = make_shared<Data>(dataName);
   data->setContent(content).setMetaInfo(metaInfo).setFreshnessPeriod(DEFAULT_FRESHNESS_PERIOD);
 
-  m_keyChain.sign(*data, m_signingInfo);
+  if (isSigningDeferred) {
+    // the in-memory storage needs the wire encoding, which requires a signature
+    m_keyChain.sign(*data, security::signingWithSha256());
+    data->setTag(make_shared<SigningDeferredTag>(true));
+  }
+  else {
+    m_keyChain.sign(*data, m_signingInfo);
+  }
 
   if (option == SendDestination::IMS || option == SendDestination::FACE_AND_IMS) {
     lp::CachePolicy policy;
@@ -288,16 +313,72 @@ Dispatcher::processStatusDatasetInterest(const Name& prefix,
   authorization(prefix, interest, nullptr, accept, reject);
 }
 
+void
+Dispatcher::setStatusDatasetSegmentSize(size_t size)
+{
+  if (size == 0 || size > MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("segment size must be in (0, MAX_NDN_PACKET_SIZE]"));
+  }
+  m_segmentSize = size;
+}
+
 void
 Dispatcher::processAuthorizedStatusDatasetInterest(const std::string& requester,
                                                    const Name& prefix,
                                                    const Interest& interest,
                                                    const StatusDatasetHandler& handler)
 {
-  StatusDatasetContext context(interest,
-                               bind(&Dispatcher::sendStatusDatasetSegment, this, _1, _2, _3, _4),
-                               bind(&Dispatcher::sendControlResponse, this, _1, interest, true));
-  handler(prefix, interest, context);
+  // the dataset may have been generated during authorization
+  if (m_storage.find(interest) != nullptr) {
+    queryStorage(prefix, interest, nullptr);
+    return;
+  }
+
+  const Name& interestName = interest.getName();
+  auto it = m_pendingDatasets.find(interestName);
+  if (it != m_pendingDatasets.end()) {
+    if (it->second->expiry > time::steady_clock::now()) {
+      // the first segment of the pending generation will satisfy this Interest
+      NDN_LOG_DEBUG("coalescing " << interest << " with the pending StatusDataset generation");
+      return;
+    }
+    NDN_LOG_DEBUG("abandoning the StatusDataset generation for " << interestName);
+    m_pendingDatasets.erase(it);
+  }
+
+  auto pending = make_shared<PendingStatusDataset>();
+  pending->interest = interest;
+  pending->expiry = time::steady_clock::now() + interest.getInterestLifetime();
+  pending->context.reset(new StatusDatasetContext(pending->interest,
+    [=] (const Name& dataName, const Block& content, time::milliseconds imsFresh, bool isFinalBlock) {
+      sendStatusDatasetSegment(dataName, content, imsFresh, isFinalBlock);
+      if (isFinalBlock) {
+        finishStatusDataset(interestName);
+      }
+    },
+    [=] (const ControlResponse& resp) {
+      sendControlResponse(resp, interest, true);
+      finishStatusDataset(interestName);
+    },
+    m_segmentSize));
+  m_pendingDatasets[interestName] = pending;
+
+  handler(prefix, pending->interest, *pending->context);
+}
+
+void
+Dispatcher::finishStatusDataset(const Name& interestName)
+{
+  auto it = m_pendingDatasets.find(interestName);
+  if (it == m_pendingDatasets.end()) {
+    return;
+  }
+
+  // the context is still executing the call that finished the dataset,
+  // so it is released after that call returns
+  auto pending = std::move(it->second);
+  m_pendingDatasets.erase(it);
+  m_face.getIoService().post([pending] {});
 }
 
 void
@@ -316,7 +397,8 @@ Dispatcher::sendStatusDatasetSegment(const Name& dataName, const Block& content,
     metaInfo.setFinalBlock(dataName[-1]);
   }
 
-  sendData(dataName, content, metaInfo, destination, imsFresh);
+  sendData(dataName, content, metaInfo, destination, imsFresh,
+           m_wantDeferredSigning && destination == SendDestination::IMS);
 }
 
 PostNotification
@@ -113,6 +113,10 @@ typedef std::function<void(const Name& prefix, const Interest& interest,
  *
  *  This function can generate zero or more blocks and pass them to \p append,
  *  and must call \p end upon completion.
+ *
+ *  The function may return before completion, and call \p append, \p end, or \p reject later.
+ *  The dispatcher keeps \p context valid until \p end or \p reject is called, or until
+ *  the InterestLifetime of \p interest has elapsed, whichever comes first.
  */
 typedef std::function<void(const Name& prefix, const Interest& interest,
                            StatusDatasetContext& context)> StatusDatasetHandler;
@@ -224,8 +228,8 @@ public: // StatusDataset
    *  \throw std::out_of_range \p relPrefix overlaps with an existing relPrefix
    *  \throw std::domain_error one or more top-level prefix has been added
    *
-   * The payload of the returned status dataset data packet is at most half of the maximum
-   * data packet size.
+   *  The payload of each status dataset Data packet is at most the size set with
+   *  setStatusDatasetSegmentSize, which defaults to half of the maximum Data packet size.
    *
    *  Procedure for processing a StatusDataset request:
    *  1. if the request Interest contains version or segment components, abort these steps;
@@ -243,12 +247,45 @@ public: // StatusDataset
    *
    *  As an optimization, a Data packet may be sent as soon as enough octets have been collected
    *  through StatusDatasetAppend calls.
+   *
+   *  Concurrent requests share one generation: an authorized request is answered from the
+   *  in-memory storage if the dataset has been generated since the request arrived, and is not
+   *  processed further if a generation for the same Name is in progress, because the first
+   *  segment of that generation will satisfy it.
    */
   void
   addStatusDataset(const PartialName& relPrefix,
                    const Authorization& authorization,
                    const StatusDatasetHandler& handler);
 
+  /** \brief set the maximum payload size of a StatusDataset segment
+   *  \param size maximum number of octets in the Content of each segment
+   *  \throw std::invalid_argument \p size is zero or exceeds MAX_NDN_PACKET_SIZE
+   *
+   *  The new size applies to datasets generated afterwards.
+   */
+  void
+  setStatusDatasetSegmentSize(size_t size);
+
+  size_t
+  getStatusDatasetSegmentSize() const
+  {
+    return m_segmentSize;
+  }
+
+  /** \brief enable or disable deferred signing of StatusDataset segments
+   *
+   *  When enabled, every segment except the first one, which is sent immediately, is placed into
+   *  the in-memory storage with a DigestSha256 signature, and is signed with the signing
+   *  parameters of the dispatcher only when an Interest retrieves it from the storage.
+   *  Segments that are never requested are never signed.
+   */
+  void
+  setDeferredSigning(bool wantDeferredSigning)
+  {
+    m_wantDeferredSigning = wantDeferredSigning;
+  }
+
 public: // NotificationStream
   /** \brief register a NotificationStream
    *  \param relPrefix a prefix for this notification stream, e.g., "faces/events";
@@ -337,10 +374,13 @@ private:
    * @param metaInfo some meta information of this piece of data
    * @param destination where to send this piece of data
    * @param imsFresh freshness period of this piece of data in in-memory storage
+   * @param isSigningDeferred whether to sign with DigestSha256 and mark the Data to be signed
+   *                          when retrieved from the in-memory storage; requires IMS destination
    */
   void
   sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
-           SendDestination destination, time::milliseconds imsFresh);
+           SendDestination destination, time::milliseconds imsFresh,
+           bool isSigningDeferred = false);
 
   /**
    * @brief send out a data packt through the face
@@ -433,6 +473,12 @@ private:
   sendStatusDatasetSegment(const Name& dataName, const Block& content,
                            time::milliseconds imsFresh, bool isFinalBlock);
 
+  /**
+   * @brief release the StatusDataset generation for @p interestName after it finishes
+   */
+  void
+  finishStatusDataset(const Name& interestName);
+
   void
   postNotification(const Block& notification, const PartialName& relPrefix);
 
@@ -454,6 +500,20 @@ private:
   // NotificationStream name => next sequence number
   std::unordered_map<Name, uint64_t> m_streams;
 
+  /** \brief a StatusDataset being generated
+   */
+  struct PendingStatusDataset
+  {
+    Interest interest;
+    unique_ptr<StatusDatasetContext> context;
+    time::steady_clock::TimePoint expiry;
+  };
+
+  // Interest name => StatusDataset being generated for that Interest
+  std::unordered_map<Name, shared_ptr<PendingStatusDataset>> m_pendingDatasets;
+  size_t m_segmentSize;
+  bool m_wantDeferredSigning;
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   InMemoryStorageFifo m_storage;
 };
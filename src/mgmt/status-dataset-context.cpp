@@ -26,6 +26,26 @@ namespace mgmt {
 
 const time::milliseconds DEFAULT_STATUS_DATASET_FRESHNESS_PERIOD = 1_s;
 
+/** \brief create a buffer for the payload of one segment,
+ *         with room in the front for the Type-Length of Content
+ */
+static shared_ptr<EncodingBuffer>
+makeSegmentBuffer(size_t maxPayloadSize)
+{
+  size_t tlSize = tlv::sizeOfVarNumber(tlv::Content) + tlv::sizeOfVarNumber(maxPayloadSize);
+  return make_shared<EncodingBuffer>(tlSize + maxPayloadSize, maxPayloadSize);
+}
+
+/** \brief wrap the payload in \p buffer into a Content element, in place
+ */
+static Block
+makeContentBlock(EncodingBuffer& buffer)
+{
+  buffer.prependVarNumber(buffer.size());
+  buffer.prependVarNumber(tlv::Content);
+  return buffer.block();
+}
+
 const Name&
 StatusDatasetContext::getPrefix() const
 {
@@ -77,16 +97,15 @@ StatusDatasetContext::append(const Block& block)
   size_t nBytesLeft = block.size();
   while (nBytesLeft > 0) {
     size_t nBytesAppend = std::min(nBytesLeft,
-                                   (ndn::MAX_NDN_PACKET_SIZE >> 1) - m_buffer->size());
+                                   m_maxPayloadSize - m_buffer->size());
     m_buffer->appendByteArray(block.wire() + (block.size() - nBytesLeft), nBytesAppend);
     nBytesLeft -= nBytesAppend;
 
     if (nBytesLeft > 0) {
       m_dataSender(Name(m_prefix).appendSegment(m_segmentNo++),
-                   makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
-                   m_expiry, false);
+                   makeContentBlock(*m_buffer), m_expiry, false);
 
-      m_buffer = std::make_shared<EncodingBuffer>();
+      m_buffer = makeSegmentBuffer(m_maxPayloadSize);
     }
   }
 }
@@ -101,8 +120,7 @@ StatusDatasetContext::end()
   m_state = State::FINALIZED;
 
   m_dataSender(Name(m_prefix).appendSegment(m_segmentNo),
-               makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
-               m_expiry, true);
+               makeContentBlock(*m_buffer), m_expiry, true);
 }
 
 void
@@ -118,15 +136,18 @@ StatusDatasetContext::reject(const ControlResponse& resp /*= a ControlResponse w
 
 StatusDatasetContext::StatusDatasetContext(const Interest& interest,
                                            const DataSender& dataSender,
-                                           const NackSender& nackSender)
+                                           const NackSender& nackSender,
+                                           size_t maxPayloadSize)
   : m_interest(interest)
   , m_dataSender(dataSender)
   , m_nackSender(nackSender)
   , m_expiry(DEFAULT_STATUS_DATASET_FRESHNESS_PERIOD)
-  , m_buffer(make_shared<EncodingBuffer>())
+  , m_maxPayloadSize(maxPayloadSize)
+  , m_buffer(makeSegmentBuffer(maxPayloadSize))
   , m_segmentNo(0)
   , m_state(State::INITIAL)
 {
+  BOOST_ASSERT(maxPayloadSize > 0);
   setPrefix(interest.getName());
 }
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2016 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -96,9 +96,12 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
                              bool isFinalBlock)> DataSender;
   typedef std::function<void(const ControlResponse& resp)> NackSender;
 
+  /** \param maxPayloadSize maximum number of octets in the Content of each segment
+   */
   StatusDatasetContext(const Interest& interest,
                        const DataSender& dataSender,
-                       const NackSender& nackSender);
+                       const NackSender& nackSender,
+                       size_t maxPayloadSize = MAX_NDN_PACKET_SIZE >> 1);
 
 private:
   friend class Dispatcher;
@@ -108,6 +111,7 @@ private:
   NackSender m_nackSender;
   Name m_prefix;
   time::milliseconds m_expiry;
+  const size_t m_maxPayloadSize;
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   shared_ptr<EncodingBuffer> m_buffer;
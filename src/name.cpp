@@ -163,6 +163,7 @@ Name::wireDecode(const Block& wire)
 
   m_wire = wire;
   m_wire.parse();
+  m_prefixHashes.clear();
 }
 
 Name
@@ -236,6 +237,34 @@ Name::append(const PartialName& name)
   return *this;
 }
 
+// ---- hashing ----
+
+size_t
+Name::getPrefixHash(ssize_t nComponents) const
+{
+  size_t n = nComponents < 0 ? std::max<ssize_t>(size() + nComponents, 0) :
+                               std::min<size_t>(nComponents, size());
+
+  if (m_prefixHashes.empty()) {
+    // hash value of the empty name
+    m_prefixHashes.push_back(0);
+  }
+
+  m_prefixHashes.reserve(n + 1);
+  for (size_t i = m_prefixHashes.size() - 1; i < n; ++i) {
+    const Component& component = get(i);
+    size_t componentHash = boost::hash_range(component.value(),
+                                             component.value() + component.value_size());
+    boost::hash_combine(componentHash, component.type());
+
+    size_t prefixHash = m_prefixHashes.back();
+    boost::hash_combine(prefixHash, componentHash);
+    m_prefixHashes.push_back(prefixHash);
+  }
+
+  return m_prefixHashes[n];
+}
+
 // ---- algorithms ----
 
 Name
@@ -332,8 +361,7 @@ namespace std {
 size_t
 hash<ndn::Name>::operator()(const ndn::Name& name) const
 {
-  return boost::hash_range(name.wireEncode().wire(),
-                           name.wireEncode().wire() + name.wireEncode().size());
+  return name.getHash();
 }
 
 } // namespace std
@@ -470,6 +470,7 @@ public: // modifiers
   clear()
   {
     m_wire = Block(tlv::Name);
+    m_prefixHashes.clear();
   }
 
 public: // algorithms
@@ -551,6 +552,28 @@ public: // algorithms
   compare(size_t pos1, size_t count1,
           const Name& other, size_t pos2 = 0, size_t count2 = npos) const;
 
+public: // hashing
+  /** @brief Get the hash value of a prefix of this name
+   *  @param nComponents number of components of the prefix; if negative, size()+nComponents
+   *                     (i.e. get a prefix until -nComponents)
+   *
+   *  The result equals std::hash<Name>()(getPrefix(nComponents)). The hash values of all
+   *  prefixes are computed incrementally and memoized in this Name, so that after the first call,
+   *  the hash value of any prefix is available in constant time, without encoding the prefix.
+   *  Appending components keeps the memoized hash values; other modifications discard them.
+   */
+  size_t
+  getPrefixHash(ssize_t nComponents) const;
+
+  /** @brief Get the hash value of this name
+   *  @sa getPrefixHash
+   */
+  size_t
+  getHash() const
+  {
+    return getPrefixHash(size());
+  }
+
 public:
   /** @brief indicates "until the end" in getSubName and compare
    */
@@ -558,6 +581,13 @@ public:
 
 private:
   mutable Block m_wire;
+
+  /** @brief memoized hash values of prefixes
+   *
+   *  m_prefixHashes[i] is the hash value of the prefix with i components.
+   *  It is computed up to the longest prefix that has been requested.
+   */
+  mutable std::vector<size_t> m_prefixHashes;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Name);
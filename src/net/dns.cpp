@@ -73,7 +73,7 @@ private:
   {
     m_scheduler.cancelEvent(m_resolveTimeout);
     // ensure the Resolver isn't destructed while callbacks are still pending, see #2653
-    m_resolver.get_io_service().post(bind([] (const shared_ptr<Resolver>&) {}, self));
+    boost::asio::post(m_resolver.get_executor(), bind([] (const shared_ptr<Resolver>&) {}, self));
 
     if (error) {
       if (error == boost::asio::error::operation_aborted)
@@ -100,7 +100,7 @@ private:
   {
     m_resolver.cancel();
     // ensure the Resolver isn't destructed while callbacks are still pending, see #2653
-    m_resolver.get_io_service().post(bind([] (const shared_ptr<Resolver>&) {}, self));
+    boost::asio::post(m_resolver.get_executor(), bind([] (const shared_ptr<Resolver>&) {}, self));
 
     if (m_onError)
       m_onError("Hostname resolution timed out");
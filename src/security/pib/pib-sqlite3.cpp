@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -33,6 +33,7 @@ namespace security {
 namespace pib {
 
 using util::Sqlite3Statement;
+using util::Sqlite3StatementCache;
 
 static const std::string INITIALIZATION = R"SQL(
 CREATE TABLE IF NOT EXISTS
@@ -235,10 +236,14 @@ PibSqlite3::PibSqlite3(const std::string& location)
     sqlite3_free(errorMessage);
     BOOST_THROW_EXCEPTION(PibImpl::Error("PIB DB cannot be initialized"));
   }
+
+  m_statements = make_unique<Sqlite3StatementCache>(m_database);
 }
 
 PibSqlite3::~PibSqlite3()
 {
+  // prepared statements must be finalized before the database can be closed
+  m_statements.reset();
   sqlite3_close(m_database);
 }
 
@@ -252,25 +257,25 @@ PibSqlite3::getScheme()
 void
 PibSqlite3::setTpmLocator(const std::string& tpmLocator)
 {
-  Sqlite3Statement statement(m_database, "UPDATE tpmInfo SET tpm_locator=?");
-  statement.bind(1, tpmLocator, SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("UPDATE tpmInfo SET tpm_locator=?");
+  statement->bind(1, tpmLocator, SQLITE_TRANSIENT);
+  statement->step();
 
   if (sqlite3_changes(m_database) == 0) {
     // no row is updated, tpm_locator does not exist, insert it directly
-    Sqlite3Statement insertStatement(m_database, "INSERT INTO tpmInfo (tpm_locator) values (?)");
-    insertStatement.bind(1, tpmLocator, SQLITE_TRANSIENT);
-    insertStatement.step();
+    auto insertStatement = m_statements->prepare("INSERT INTO tpmInfo (tpm_locator) values (?)");
+    insertStatement->bind(1, tpmLocator, SQLITE_TRANSIENT);
+    insertStatement->step();
   }
 }
 
 std::string
 PibSqlite3::getTpmLocator() const
 {
-  Sqlite3Statement statement(m_database, "SELECT tpm_locator FROM tpmInfo");
-  int res = statement.step();
+  auto statement = m_statements->prepare("SELECT tpm_locator FROM tpmInfo");
+  int res = statement->step();
   if (res == SQLITE_ROW)
-    return statement.getString(0);
+    return statement->getString(0);
   else
     return "";
 }
@@ -278,18 +283,28 @@ PibSqlite3::getTpmLocator() const
 bool
 PibSqlite3::hasIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM identities WHERE identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-  return (statement.step() == SQLITE_ROW);
+  if (m_identities.count(identity) > 0) {
+    return true;
+  }
+
+  auto statement = m_statements->prepare("SELECT id FROM identities WHERE identity=?");
+  statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  if (statement->step() != SQLITE_ROW) {
+    return false;
+  }
+
+  m_identities.insert(identity);
+  return true;
 }
 
 void
 PibSqlite3::addIdentity(const Name& identity)
 {
   if (!hasIdentity(identity)) {
-    Sqlite3Statement statement(m_database, "INSERT INTO identities (identity) values (?)");
-    statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = m_statements->prepare("INSERT INTO identities (identity) values (?)");
+    statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+    statement->step();
+    m_identities.insert(identity);
   }
 
   if (!hasDefaultIdentity()) {
@@ -300,26 +315,28 @@ PibSqlite3::addIdentity(const Name& identity)
 void
 PibSqlite3::removeIdentity(const Name& identity)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities WHERE identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("DELETE FROM identities WHERE identity=?");
+  statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+  clearCache();
 }
 
 void
 PibSqlite3::clearIdentities()
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities");
-  statement.step();
+  auto statement = m_statements->prepare("DELETE FROM identities");
+  statement->step();
+  clearCache();
 }
 
 std::set<Name>
 PibSqlite3::getIdentities() const
 {
   std::set<Name> identities;
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities");
+  auto statement = m_statements->prepare("SELECT identity FROM identities");
 
-  while (statement.step() == SQLITE_ROW)
-    identities.insert(Name(statement.getBlock(0)));
+  while (statement->step() == SQLITE_ROW)
+    identities.insert(Name(statement->getBlock(0)));
 
   return identities;
 }
@@ -327,36 +344,51 @@ PibSqlite3::getIdentities() const
 void
 PibSqlite3::setDefaultIdentity(const Name& identityName)
 {
-  Sqlite3Statement statement(m_database, "UPDATE identities SET is_default=1 WHERE identity=?");
-  statement.bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("UPDATE identities SET is_default=1 WHERE identity=?");
+  statement->bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+
+  if (sqlite3_changes(m_database) > 0) {
+    m_defaultIdentity = make_unique<Name>(identityName);
+  }
 }
 
 Name
 PibSqlite3::getDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
-
-  if (statement.step() == SQLITE_ROW)
-    return Name(statement.getBlock(0));
-  else
+  if (!hasDefaultIdentity())
     BOOST_THROW_EXCEPTION(Pib::Error("No default identity"));
+
+  return *m_defaultIdentity;
 }
 
 bool
 PibSqlite3::hasDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
-  return (statement.step() == SQLITE_ROW);
+  if (m_defaultIdentity != nullptr) {
+    return true;
+  }
+
+  auto statement = m_statements->prepare("SELECT identity FROM identities WHERE is_default=1");
+  if (statement->step() != SQLITE_ROW) {
+    return false;
+  }
+
+  m_defaultIdentity = make_unique<Name>(statement->getBlock(0));
+  return true;
 }
 
 bool
 PibSqlite3::hasKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  if (m_keyBits.count(keyName) > 0) {
+    return true;
+  }
 
-  return (statement.step() == SQLITE_ROW);
+  auto statement = m_statements->prepare("SELECT id FROM keys WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+
+  return (statement->step() == SQLITE_ROW);
 }
 
 void
@@ -367,21 +399,21 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
   addIdentity(identity);
 
   if (!hasKey(keyName)) {
-    Sqlite3Statement statement(m_database,
-                               "INSERT INTO keys (identity_id, key_name, key_bits) "
-                               "VALUES ((SELECT id FROM identities WHERE identity=?), ?, ?)");
-    statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(3, key, keyLen, SQLITE_STATIC);
-    statement.step();
+    auto statement = m_statements->prepare("INSERT INTO keys (identity_id, key_name, key_bits) "
+                                          "VALUES ((SELECT id FROM identities WHERE identity=?), "
+                                          "?, ?)");
+    statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(3, key, keyLen, SQLITE_STATIC);
+    statement->step();
   }
   else {
-    Sqlite3Statement statement(m_database,
-                               "UPDATE keys SET key_bits=? WHERE key_name=?");
-    statement.bind(1, key, keyLen, SQLITE_STATIC);
-    statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = m_statements->prepare("UPDATE keys SET key_bits=? WHERE key_name=?");
+    statement->bind(1, key, keyLen, SQLITE_STATIC);
+    statement->bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
+    statement->step();
   }
+  m_keyBits[keyName] = Buffer(key, keyLen);
 
   if (!hasDefaultKeyOfIdentity(identity)) {
     setDefaultKeyOfIdentity(identity, keyName);
@@ -391,21 +423,29 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
 void
 PibSqlite3::removeKey(const Name& keyName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("DELETE FROM keys WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+  clearCache();
 }
 
 Buffer
 PibSqlite3::getKeyBits(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT key_bits FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  auto it = m_keyBits.find(keyName);
+  if (it != m_keyBits.end()) {
+    return it->second;
+  }
 
-  if (statement.step() == SQLITE_ROW)
-    return Buffer(statement.getBlob(0), statement.getSize(0));
-  else
+  auto statement = m_statements->prepare("SELECT key_bits FROM keys WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+
+  if (statement->step() != SQLITE_ROW)
     BOOST_THROW_EXCEPTION(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
+
+  Buffer keyBits(statement->getBlob(0), statement->getSize(0));
+  m_keyBits.emplace(keyName, keyBits);
+  return keyBits;
 }
 
 std::set<Name>
@@ -413,14 +453,13 @@ PibSqlite3::getKeysOfIdentity(const Name& identity) const
 {
   std::set<Name> keyNames;
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  auto statement = m_statements->prepare("SELECT key_name "
+                                        "FROM keys JOIN identities ON keys.identity_id=identities.id "
+                                        "WHERE identities.identity=?");
+  statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
 
-  while (statement.step() == SQLITE_ROW) {
-    keyNames.insert(Name(statement.getBlock(0)));
+  while (statement->step() == SQLITE_ROW) {
+    keyNames.insert(Name(statement->getBlock(0)));
   }
 
   return keyNames;
@@ -433,9 +472,10 @@ PibSqlite3::setDefaultKeyOfIdentity(const Name& identity, const Name& keyName)
     BOOST_THROW_EXCEPTION(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database, "UPDATE keys SET is_default=1 WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("UPDATE keys SET is_default=1 WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+  m_defaultKeys[identity] = keyName;
 }
 
 Name
@@ -445,37 +485,37 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
     BOOST_THROW_EXCEPTION(Pib::Error("Identity `" + identity.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW) {
-    return Name(statement.getBlock(0));
-  }
-  else
+  if (!hasDefaultKeyOfIdentity(identity))
     BOOST_THROW_EXCEPTION(Pib::Error("No default key for identity `" + identity.toUri() + "`"));
+
+  return m_defaultKeys.at(identity);
 }
 
 bool
 PibSqlite3::hasDefaultKeyOfIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  if (m_defaultKeys.count(identity) > 0) {
+    return true;
+  }
+
+  auto statement = m_statements->prepare("SELECT key_name "
+                                        "FROM keys JOIN identities ON keys.identity_id=identities.id "
+                                        "WHERE identities.identity=? AND keys.is_default=1");
+  statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  if (statement->step() != SQLITE_ROW) {
+    return false;
+  }
 
-  return (statement.step() == SQLITE_ROW);
+  m_defaultKeys.emplace(identity, Name(statement->getBlock(0)));
+  return true;
 }
 
 bool
 PibSqlite3::hasCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  return (statement.step() == SQLITE_ROW);
+  auto statement = m_statements->prepare("SELECT id FROM certificates WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  return (statement->step() == SQLITE_ROW);
 }
 
 void
@@ -486,21 +526,25 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
   addKey(certificate.getIdentity(), certificate.getKeyName(), content.value(), content.value_size());
 
   if (!hasCertificate(certificate.getName())) {
-    Sqlite3Statement statement(m_database,
-                               "INSERT INTO certificates "
-                               "(key_id, certificate_name, certificate_data) "
-                               "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
-    statement.bind(1, certificate.getKeyName().wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(3, certificate.wireEncode(), SQLITE_STATIC);
-    statement.step();
+    auto statement = m_statements->prepare("INSERT INTO certificates "
+                                          "(key_id, certificate_name, certificate_data) "
+                                          "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
+    statement->bind(1, certificate.getKeyName().wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(3, certificate.wireEncode(), SQLITE_STATIC);
+    statement->step();
   }
   else {
-    Sqlite3Statement statement(m_database,
-                               "UPDATE certificates SET certificate_data=? WHERE certificate_name=?");
-    statement.bind(1, certificate.wireEncode(), SQLITE_STATIC);
-    statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = m_statements->prepare("UPDATE certificates SET certificate_data=? "
+                                          "WHERE certificate_name=?");
+    statement->bind(1, certificate.wireEncode(), SQLITE_STATIC);
+    statement->bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
+    statement->step();
+
+    auto it = m_defaultCerts.find(certificate.getKeyName());
+    if (it != m_defaultCerts.end() && it->second.getName() == certificate.getName()) {
+      it->second = certificate;
+    }
   }
 
   if (!hasDefaultCertificateOfKey(certificate.getKeyName())) {
@@ -511,20 +555,27 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
 void
 PibSqlite3::removeCertificate(const Name& certName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("DELETE FROM certificates WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+
+  for (auto it = m_defaultCerts.begin(); it != m_defaultCerts.end();) {
+    if (it->second.getName() == certName)
+      it = m_defaultCerts.erase(it);
+    else
+      ++it;
+  }
 }
 
 v2::Certificate
 PibSqlite3::getCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  auto statement = m_statements->prepare("SELECT certificate_data FROM certificates "
+                                        "WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
 
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
+  if (statement->step() == SQLITE_ROW)
+    return v2::Certificate(statement->getBlock(0));
   else
     BOOST_THROW_EXCEPTION(Pib::Error("Certificate `" + certName.toUri() + "` does not exit"));
 }
@@ -534,14 +585,13 @@ PibSqlite3::getCertificatesOfKey(const Name& keyName) const
 {
   std::set<Name> certNames;
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_name "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  auto statement = m_statements->prepare("SELECT certificate_name "
+                                        "FROM certificates JOIN keys ON certificates.key_id=keys.id "
+                                        "WHERE keys.key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
 
-  while (statement.step() == SQLITE_ROW)
-    certNames.insert(Name(statement.getBlock(0)));
+  while (statement->step() == SQLITE_ROW)
+    certNames.insert(Name(statement->getBlock(0)));
 
   return certNames;
 }
@@ -553,37 +603,49 @@ PibSqlite3::setDefaultCertificateOfKey(const Name& keyName, const Name& certName
     BOOST_THROW_EXCEPTION(Pib::Error("Certificate `" + certName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
-                             "UPDATE certificates SET is_default=1 WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  auto statement = m_statements->prepare("UPDATE certificates SET is_default=1 "
+                                        "WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  statement->step();
+  m_defaultCerts.erase(keyName);
 }
 
 v2::Certificate
 PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
-  else
+  if (!hasDefaultCertificateOfKey(keyName))
     BOOST_THROW_EXCEPTION(Pib::Error("No default certificate for key `" + keyName.toUri() + "`"));
+
+  return m_defaultCerts.at(keyName);
 }
 
 bool
 PibSqlite3::hasDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  if (m_defaultCerts.count(keyName) > 0) {
+    return true;
+  }
+
+  auto statement = m_statements->prepare("SELECT certificate_data "
+                                        "FROM certificates JOIN keys ON certificates.key_id=keys.id "
+                                        "WHERE certificates.is_default=1 AND keys.key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  if (statement->step() != SQLITE_ROW) {
+    return false;
+  }
 
-  return (statement.step() == SQLITE_ROW);
+  m_defaultCerts.emplace(keyName, v2::Certificate(statement->getBlock(0)));
+  return true;
+}
+
+void
+PibSqlite3::clearCache()
+{
+  m_identities.clear();
+  m_defaultIdentity.reset();
+  m_keyBits.clear();
+  m_defaultKeys.clear();
+  m_defaultCerts.clear();
 }
 
 } // namespace pib
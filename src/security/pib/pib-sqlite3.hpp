@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,9 +24,15 @@
 
 #include "pib-impl.hpp"
 
+#include <map>
+
 struct sqlite3;
 
 namespace ndn {
+namespace util {
+class Sqlite3StatementCache;
+} // namespace util
+
 namespace security {
 namespace pib {
 
@@ -35,6 +41,12 @@ namespace pib {
  *
  * All the contents in Pib are stored in a SQLite3 database file.
  * This backend provides more persistent storage than PibMemory.
+ *
+ * SQL statements are prepared once and reused.  Existing identities, key bits, and the
+ * defaults are additionally cached in memory and kept up to date on every write through this
+ * backend, so that looking up the default signing certificate does not access the database
+ * after the first time.  The database must therefore not be modified by another process
+ * while the PIB is open.
  */
 class PibSqlite3 : public PibImpl
 {
@@ -146,8 +158,22 @@ private:
   bool
   hasDefaultCertificateOfKey(const Name& keyName) const;
 
+  /**
+   * @brief drop all cached entries, used when a removal may cascade to other tables
+   */
+  void
+  clearCache();
+
 private:
   sqlite3* m_database;
+  unique_ptr<util::Sqlite3StatementCache> m_statements;
+
+  // in-memory caches, holding only entries known to exist in the database
+  mutable std::set<Name> m_identities;
+  mutable unique_ptr<Name> m_defaultIdentity;
+  mutable std::map<Name, Buffer> m_keyBits;
+  mutable std::map<Name, Name> m_defaultKeys; ///< identity => default key
+  mutable std::map<Name, v2::Certificate> m_defaultCerts; ///< key => default certificate
 };
 
 } // namespace pib
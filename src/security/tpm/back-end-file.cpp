@@ -27,6 +27,8 @@
 
 #include <cstdlib>
 #include <fstream>
+#include <list>
+#include <unordered_map>
 #include <sys/stat.h>
 
 #include <boost/filesystem.hpp>
@@ -40,8 +42,8 @@ using transform::PrivateKey;
 class BackEndFile::Impl
 {
 public:
-  explicit
-  Impl(const std::string& dir)
+  Impl(const std::string& dir, size_t keyCacheCapacity)
+    : keyCacheCapacity(keyCacheCapacity)
   {
     if (!dir.empty()) {
       keystorePath = boost::filesystem::path(dir);
@@ -74,12 +76,58 @@ public:
     return keystorePath / (os.str() + ".privkey");
   }
 
+  /**
+   * @return the cached key with name @p keyName, or nullptr if it is not cached
+   */
+  shared_ptr<PrivateKey>
+  findCachedKey(const Name& keyName)
+  {
+    auto it = cacheIndex.find(keyName);
+    if (it == cacheIndex.end()) {
+      return nullptr;
+    }
+
+    cachedKeys.splice(cachedKeys.begin(), cachedKeys, it->second);
+    return it->second->second;
+  }
+
+  void
+  cacheKey(const Name& keyName, shared_ptr<PrivateKey> key)
+  {
+    if (keyCacheCapacity == 0) {
+      return;
+    }
+
+    evictKey(keyName);
+    if (cachedKeys.size() >= keyCacheCapacity) {
+      cacheIndex.erase(cachedKeys.back().first);
+      cachedKeys.pop_back();
+    }
+    cachedKeys.emplace_front(keyName, std::move(key));
+    cacheIndex.emplace(keyName, cachedKeys.begin());
+  }
+
+  void
+  evictKey(const Name& keyName)
+  {
+    auto it = cacheIndex.find(keyName);
+    if (it != cacheIndex.end()) {
+      cachedKeys.erase(it->second);
+      cacheIndex.erase(it);
+    }
+  }
+
 public:
   boost::filesystem::path keystorePath;
+
+  using KeyList = std::list<std::pair<Name, shared_ptr<PrivateKey>>>;
+  const size_t keyCacheCapacity;
+  KeyList cachedKeys; ///< most recently used first
+  std::unordered_map<Name, KeyList::iterator> cacheIndex;
 };
 
-BackEndFile::BackEndFile(const std::string& location)
-  : m_impl(new Impl(location))
+BackEndFile::BackEndFile(const std::string& location, size_t keyCacheCapacity)
+  : m_impl(new Impl(location, keyCacheCapacity))
 {
 }
 
@@ -95,9 +143,6 @@ BackEndFile::getScheme()
 bool
 BackEndFile::doHasKey(const Name& keyName) const
 {
-  if (!boost::filesystem::exists(m_impl->toFileName(keyName)))
-    return false;
-
   try {
     loadKey(keyName);
     return true;
@@ -110,10 +155,15 @@ BackEndFile::doHasKey(const Name& keyName) const
 unique_ptr<KeyHandle>
 BackEndFile::doGetKeyHandle(const Name& keyName) const
 {
-  if (!doHasKey(keyName))
+  shared_ptr<PrivateKey> key;
+  try {
+    key = loadKey(keyName);
+  }
+  catch (const std::runtime_error&) {
     return nullptr;
+  }
 
-  return make_unique<KeyHandleMem>(loadKey(keyName));
+  return make_unique<KeyHandleMem>(std::move(key));
 }
 
 unique_ptr<KeyHandle>
@@ -136,8 +186,9 @@ BackEndFile::doCreateKey(const Name& identityName, const KeyParams& params)
 void
 BackEndFile::doDeleteKey(const Name& keyName)
 {
-  boost::filesystem::path keyPath(m_impl->toFileName(keyName));
+  m_impl->evictKey(keyName);
 
+  boost::filesystem::path keyPath(m_impl->toFileName(keyName));
   if (boost::filesystem::exists(keyPath)) {
     try {
       boost::filesystem::remove(keyPath);
@@ -179,9 +230,20 @@ BackEndFile::doImportKey(const Name& keyName, const uint8_t* buf, size_t size, c
 shared_ptr<PrivateKey>
 BackEndFile::loadKey(const Name& keyName) const
 {
-  auto key = make_shared<PrivateKey>();
-  std::fstream is(m_impl->toFileName(keyName).string(), std::ios_base::in);
+  auto key = m_impl->findCachedKey(keyName);
+  if (key != nullptr) {
+    return key;
+  }
+
+  boost::filesystem::path keyPath(m_impl->toFileName(keyName));
+  if (!boost::filesystem::exists(keyPath)) {
+    BOOST_THROW_EXCEPTION(Error("Key `" + keyName.toUri() + "` does not exist"));
+  }
+
+  key = make_shared<PrivateKey>();
+  std::fstream is(keyPath.string(), std::ios_base::in);
   key->loadPkcs1Base64(is);
+  m_impl->cacheKey(keyName, key);
   return key;
 }
 
@@ -194,6 +256,8 @@ BackEndFile::saveKey(const Name& keyName, shared_ptr<PrivateKey> key)
 
   // set file permission
   ::chmod(fileName.c_str(), 0000400);
+
+  m_impl->cacheKey(keyName, std::move(key));
 }
 
 } // namespace tpm
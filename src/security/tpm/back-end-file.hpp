@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -37,6 +37,11 @@ namespace tpm {
  *
  * In this TPM, each private key is stored in a separate file with permission 0400, i.e.,
  * owner read-only.  The key is stored in PKCS #1 format in base64 encoding.
+ *
+ * Parsed private keys are kept in a bounded in-memory cache, so that looking up the same key
+ * again does not read and decode its file.  When the cache is full, the least recently used
+ * key is evicted.  The key directory is assumed not to be modified by another process while
+ * the back-end is in use.
  */
 class BackEndFile : public BackEnd
 {
@@ -55,9 +60,11 @@ public:
   /**
    * @brief Create file-based TPM backend
    * @param location Directory to store private keys
+   * @param keyCacheCapacity Maximum number of parsed private keys kept in memory,
+   *                         0 disables the cache
    */
   explicit
-  BackEndFile(const std::string& location = "");
+  BackEndFile(const std::string& location = "", size_t keyCacheCapacity = 256);
 
   ~BackEndFile() override;
 
@@ -121,7 +128,8 @@ private: // inherited from tpm::BackEnd
 
 private:
   /**
-   * @brief Load a private key with name @p keyName from the key file directory
+   * @brief Load a private key with name @p keyName from the cache or the key file directory
+   * @throw std::runtime_error the key file does not exist or cannot be parsed
    */
   shared_ptr<transform::PrivateKey>
   loadKey(const Name& keyName) const;
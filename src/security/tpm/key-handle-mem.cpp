@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -20,11 +20,7 @@
  */
 
 #include "key-handle-mem.hpp"
-#include "../transform/buffer-source.hpp"
 #include "../transform/private-key.hpp"
-#include "../transform/signer-filter.hpp"
-#include "../transform/stream-sink.hpp"
-#include "../../encoding/buffer-stream.hpp"
 
 namespace ndn {
 namespace security {
@@ -39,11 +35,7 @@ KeyHandleMem::KeyHandleMem(shared_ptr<transform::PrivateKey> key)
 ConstBufferPtr
 KeyHandleMem::doSign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t size) const
 {
-  using namespace transform;
-
-  OBufferStream sigOs;
-  bufferSource(buf, size) >> signerFilter(digestAlgorithm, *m_key) >> streamSink(sigOs);
-  return sigOs.buf();
+  return m_key->sign(digestAlgorithm, buf, size);
 }
 
 ConstBufferPtr
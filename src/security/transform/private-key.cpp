@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -292,6 +292,35 @@ PrivateKey::decrypt(const uint8_t* cipherText, size_t cipherLen) const
   }
 }
 
+ConstBufferPtr
+PrivateKey::sign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t size) const
+{
+  ENSURE_PRIVATE_KEY_LOADED(m_impl->key);
+
+  const EVP_MD* md = detail::digestAlgorithmToEvpMd(digestAlgorithm);
+  if (md == nullptr)
+    BOOST_THROW_EXCEPTION(Error("Unsupported digest algorithm " +
+                                boost::lexical_cast<std::string>(digestAlgorithm)));
+
+  detail::EvpMdCtx ctx;
+  if (EVP_DigestSignInit(ctx, nullptr, md, nullptr, m_impl->key) != 1)
+    BOOST_THROW_EXCEPTION(Error("Failed to initialize signing context"));
+
+  if (EVP_DigestSignUpdate(ctx, buf, size) != 1)
+    BOOST_THROW_EXCEPTION(Error("Failed to accept input"));
+
+  size_t sigLen = 0;
+  if (EVP_DigestSignFinal(ctx, nullptr, &sigLen) != 1)
+    BOOST_THROW_EXCEPTION(Error("Failed to estimate signature length"));
+
+  auto sig = make_shared<Buffer>(sigLen);
+  if (EVP_DigestSignFinal(ctx, sig->data(), &sigLen) != 1)
+    BOOST_THROW_EXCEPTION(Error("Failed to finalize signature"));
+
+  sig->resize(sigLen);
+  return sig;
+}
+
 void*
 PrivateKey::getEvpPkey() const
 {
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -220,6 +220,16 @@ public:
   ConstBufferPtr
   decrypt(const uint8_t* cipherText, size_t cipherLen) const;
 
+  /**
+   * @return Signature of @p buf signed using this private key with @p digestAlgorithm.
+   *
+   * Unlike a signerFilter chain, this does not set up any transformation or output stream.
+   * Each call uses its own signing context, so that the same key can sign from several threads
+   * at once.
+   */
+  ConstBufferPtr
+  sign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t size) const;
+
 private:
   friend class SignerFilter;
 
@@ -419,6 +419,45 @@ KeyChain::importSafeBag(const SafeBag& safeBag, const char* pw, size_t pwLen)
 
 // public: signing
 
+/**
+ * @brief Upper bound of the encoded SignatureValue size for @p signatureType,
+ *        assuming the largest key size in common use
+ */
+static size_t
+estimateSignatureValueSize(uint32_t signatureType)
+{
+  switch (signatureType) {
+    case tlv::DigestSha256:
+      return 2 + 32;
+    case tlv::SignatureSha256WithEcdsa:
+      // DER-encoded ECDSA signature on P-521
+      return 2 + 139;
+    default:
+      // RSA-4096
+      return 4 + 512;
+  }
+}
+
+/**
+ * @brief Assign SignatureInfo @p sigInfo to @p data, and encode the unsigned portion of @p data
+ *
+ * The returned encoder reserves exactly the unsigned portion, plus room for SignatureValue in
+ * the back and the outermost Type-Length in the front.
+ */
+static unique_ptr<EncodingBuffer>
+encodeUnsignedPortion(Data& data, const SignatureInfo& sigInfo)
+{
+  data.setSignature(Signature(sigInfo));
+
+  EncodingEstimator estimator;
+  size_t unsignedSize = data.wireEncode(estimator, true);
+  size_t sigValueSize = estimateSignatureValueSize(sigInfo.getSignatureType());
+  size_t tlSize = tlv::sizeOfVarNumber(tlv::Data) + tlv::sizeOfVarNumber(unsignedSize + sigValueSize);
+  auto encoder = make_unique<EncodingBuffer>(tlSize + unsignedSize + sigValueSize, sigValueSize);
+  data.wireEncode(*encoder, true);
+  return encoder;
+}
+
 void
 KeyChain::sign(Data& data, const SigningInfo& params)
 {
@@ -426,14 +465,57 @@ KeyChain::sign(Data& data, const SigningInfo& params)
   SignatureInfo sigInfo;
   std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
 
-  data.setSignature(Signature(sigInfo));
+  auto encoder = encodeUnsignedPortion(data, sigInfo);
+  Block sigValue = sign(encoder->buf(), encoder->size(), keyName, params.getDigestAlgorithm());
+  data.wireEncode(*encoder, sigValue);
+}
 
-  EncodingBuffer encoder;
-  data.wireEncode(encoder, true);
+void
+KeyChain::signAsync(std::vector<Data>& packets, const SigningInfo& params,
+                    const function<void()>& onSuccess,
+                    const function<void(const std::string& reason)>& onFailure)
+{
+  Name keyName;
+  SignatureInfo sigInfo;
+  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
 
-  Block sigValue = sign(encoder.buf(), encoder.size(), keyName, params.getDigestAlgorithm());
+  if (m_signingPool == nullptr || keyName == SigningInfo::getDigestSha256Identity()) {
+    for (auto& data : packets) {
+      auto encoder = encodeUnsignedPortion(data, sigInfo);
+      Block sigValue = sign(encoder->buf(), encoder->size(), keyName, params.getDigestAlgorithm());
+      data.wireEncode(*encoder, sigValue);
+    }
+    onSuccess();
+    return;
+  }
 
-  data.wireEncode(encoder, sigValue);
+  // a separate handle, so that the key stays usable by the workers even if the TPM drops it
+  shared_ptr<tpm::KeyHandle> key = m_tpm->m_backEnd->getKeyHandle(keyName);
+  if (key == nullptr) {
+    BOOST_THROW_EXCEPTION(Error("Private key `" + keyName.toUri() + "` does not exist"));
+  }
+  key->setKeyName(keyName);
+
+  auto encoders = make_shared<std::vector<unique_ptr<EncodingBuffer>>>();
+  encoders->reserve(packets.size());
+  std::vector<std::pair<const uint8_t*, size_t>> buffers;
+  buffers.reserve(packets.size());
+  for (auto& data : packets) {
+    encoders->push_back(encodeUnsignedPortion(data, sigInfo));
+    buffers.emplace_back(encoders->back()->buf(), encoders->back()->size());
+  }
+
+  m_signingPool->sign(std::move(key), params.getDigestAlgorithm(), std::move(buffers),
+    [&packets, encoders, onSuccess, onFailure] (const std::vector<ConstBufferPtr>& signatures) {
+      for (size_t i = 0; i < signatures.size(); ++i) {
+        if (signatures[i] == nullptr) {
+          onFailure("Failed to sign Data " + packets[i].getName().toUri());
+          return;
+        }
+        packets[i].wireEncode(*(*encoders)[i], Block(tlv::SignatureValue, signatures[i]));
+      }
+      onSuccess();
+    });
 }
 
 void
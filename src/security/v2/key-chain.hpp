@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,6 +24,7 @@
 
 #include "../security-common.hpp"
 #include "certificate.hpp"
+#include "signing-pool.hpp"
 #include "../key-params.hpp"
 #include "../pib/pib.hpp"
 #include "../safe-bag.hpp"
@@ -294,6 +295,41 @@ public: // signing
   Block
   sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params = getDefaultSigningInfo());
 
+  /**
+   * @brief Sign a batch of data packets according to the supplied signing information
+   *
+   * The signing key and SignatureInfo are selected once for the whole batch, as in
+   * sign(Data&, const SigningInfo&).  With a signing pool, signatures are generated by worker
+   * threads of the pool, and @p onSuccess or @p onFailure is invoked from the io_service of the
+   * pool after all packets are signed.  Without a signing pool, or when signing with
+   * DigestSha256, the packets are signed on the calling thread and @p onSuccess is invoked
+   * before this method returns.
+   *
+   * @param packets The data packets to sign; they must stay alive and unmodified until either
+   *                callback is invoked
+   * @param params The signing parameters.
+   * @param onSuccess Invoked when all packets are signed
+   * @param onFailure Invoked with the reason when a signature cannot be generated; packets
+   *                  after the first failure are left unsigned
+   * @throw Error the signing key cannot be selected, or signing fails on the calling thread
+   * @see setSigningPool
+   */
+  void
+  signAsync(std::vector<Data>& packets, const SigningInfo& params,
+            const function<void()>& onSuccess,
+            const function<void(const std::string& reason)>& onFailure);
+
+  /**
+   * @brief Offload signature generation of signAsync() to worker threads of @p pool
+   *
+   * @param pool the pool, or nullptr to sign on the calling thread
+   */
+  void
+  setSigningPool(shared_ptr<SigningPool> pool)
+  {
+    m_signingPool = std::move(pool);
+  }
+
 public: // export & import
   /**
    * @brief Export a certificate and its corresponding private key.
@@ -435,6 +471,7 @@ public:
 private:
   std::unique_ptr<Pib> m_pib;
   std::unique_ptr<Tpm> m_tpm;
+  shared_ptr<SigningPool> m_signingPool;
 
   static std::string s_defaultPibLocator;
   static std::string s_defaultTpmLocator;
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "public-key-cache.hpp"
+#include "../transform/public-key.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+PublicKeyCache::PublicKeyCache(size_t capacity, const time::nanoseconds& maxVerifiedLifetime)
+  : m_capacity(capacity)
+  , m_maxVerifiedLifetime(maxVerifiedLifetime)
+  , m_nHits(0)
+  , m_nMisses(0)
+  , m_nVerifiedHits(0)
+{
+  if (capacity == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("capacity must be positive"));
+  }
+}
+
+shared_ptr<const PublicKey>
+PublicKeyCache::get(const Certificate& cert)
+{
+  Entry& entry = lookup(cert);
+  if (entry.key != nullptr) {
+    ++m_nHits;
+    return entry.key;
+  }
+
+  ++m_nMisses;
+  auto key = make_shared<PublicKey>();
+  try {
+    key->loadPkcs8(cert.getContent().value(), cert.getContent().value_size());
+  }
+  catch (const PublicKey::Error&) {
+    return nullptr;
+  }
+  entry.key = key;
+  return key;
+}
+
+void
+PublicKeyCache::markVerified(const Certificate& cert)
+{
+  auto notAfter = cert.getValidityPeriod().getPeriod().second;
+  lookup(cert).verifiedUntil = std::min(notAfter, time::system_clock::now() + m_maxVerifiedLifetime);
+}
+
+bool
+PublicKeyCache::isVerified(const Certificate& cert)
+{
+  auto it = m_index.find(cert.getFullName());
+  if (it == m_index.end() || it->second->verifiedUntil <= time::system_clock::now()) {
+    return false;
+  }
+
+  ++m_nVerifiedHits;
+  return true;
+}
+
+void
+PublicKeyCache::clear()
+{
+  m_index.clear();
+  m_entries.clear();
+}
+
+PublicKeyCache::Entry&
+PublicKeyCache::lookup(const Certificate& cert)
+{
+  const Name& fullName = cert.getFullName();
+  auto it = m_index.find(fullName);
+  if (it != m_index.end()) {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return m_entries.front();
+  }
+
+  if (m_entries.size() >= m_capacity) {
+    m_index.erase(m_entries.back().fullName);
+    m_entries.pop_back();
+  }
+  m_entries.push_front({fullName, nullptr, time::system_clock::TimePoint::min()});
+  m_index.emplace(fullName, m_entries.begin());
+  return m_entries.front();
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_PUBLIC_KEY_CACHE_HPP
+#define NDN_SECURITY_V2_PUBLIC_KEY_CACHE_HPP
+
+#include "certificate.hpp"
+#include "../security-common.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Represents a cache of public keys parsed from certificates
+ *
+ * Entries are keyed by the full name of the certificate, so that a different certificate with
+ * the same name never hits an entry of another.  Besides the parsed key, an entry records
+ * until when the signature of the certificate itself is known to be verified, which allows
+ * certificates in a chain to be accepted without repeating cryptographic verification.
+ *
+ * When the cache is full, the least recently used entry is evicted.
+ */
+class PublicKeyCache : noncopyable
+{
+public:
+  /**
+   * @brief Create a public key cache
+   *
+   * @param capacity            the maximum number of entries, must be positive
+   * @param maxVerifiedLifetime the maximum time a certificate stays marked as verified
+   *                            (default: 1 hour)
+   * @throw std::invalid_argument @p capacity is zero
+   */
+  explicit
+  PublicKeyCache(size_t capacity = 1024,
+                 const time::nanoseconds& maxVerifiedLifetime = time::hours(1));
+
+  /**
+   * @brief Get the public key in @p cert, parsing and caching it on a miss
+   * @return the public key, or nullptr if the key cannot be parsed
+   */
+  shared_ptr<const PublicKey>
+  get(const Certificate& cert);
+
+  /**
+   * @brief Mark the signature of @p cert as verified
+   *
+   * The mark expires at the NotAfter time of @p cert, or after the maximum lifetime specified
+   * during cache construction, whichever comes first.
+   */
+  void
+  markVerified(const Certificate& cert);
+
+  /**
+   * @brief Check whether the signature of @p cert has been marked as verified
+   */
+  bool
+  isVerified(const Certificate& cert);
+
+  /**
+   * @brief Remove all entries, but keep the counters
+   */
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /**
+   * @return number of public key lookups that found a parsed key
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /**
+   * @return number of public key lookups that needed to parse the key
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  /**
+   * @return number of certificates accepted as verified without signature verification
+   */
+  uint64_t
+  getNVerifiedHits() const
+  {
+    return m_nVerifiedHits;
+  }
+
+private:
+  struct Entry
+  {
+    Name fullName;
+    shared_ptr<const PublicKey> key;
+    time::system_clock::TimePoint verifiedUntil;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  /**
+   * @brief Find or create the entry of @p cert, and make it the most recently used one
+   */
+  Entry&
+  lookup(const Certificate& cert);
+
+private:
+  const size_t m_capacity;
+  const time::nanoseconds m_maxVerifiedLifetime;
+  EntryList m_entries; ///< most recently used first
+  std::unordered_map<Name, EntryList::iterator> m_index;
+
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+  uint64_t m_nVerifiedHits;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_PUBLIC_KEY_CACHE_HPP
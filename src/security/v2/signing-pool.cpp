@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "signing-pool.hpp"
+#include "../../util/logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+NDN_LOG_INIT(ndn.security.v2.SigningPool);
+
+SigningPool::SigningPool(boost::asio::io_service& ioService, size_t nThreads, size_t maxBatchSize)
+  : m_ioService(ioService)
+  , m_maxBatchSize(maxBatchSize)
+  , m_shouldStop(false)
+{
+  if (nThreads == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("nThreads must be positive"));
+  }
+  if (maxBatchSize == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("maxBatchSize must be positive"));
+  }
+
+  m_workers.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_workers.emplace_back(&SigningPool::runWorker, this);
+  }
+}
+
+SigningPool::~SigningPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shouldStop = true;
+  }
+  m_cv.notify_all();
+
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void
+SigningPool::sign(shared_ptr<const tpm::KeyHandle> key, DigestAlgorithm digestAlgorithm,
+                  std::vector<std::pair<const uint8_t*, size_t>> buffers, const SigningCallback& cb)
+{
+  BOOST_ASSERT(key != nullptr);
+  BOOST_ASSERT(cb != nullptr);
+
+  if (buffers.empty()) {
+    m_ioService.post([cb] { cb({}); });
+    return;
+  }
+
+  auto request = make_shared<Request>();
+  request->key = std::move(key);
+  request->digestAlgorithm = digestAlgorithm;
+  request->buffers = std::move(buffers);
+  request->signatures.resize(request->buffers.size());
+  request->nRemainingChunks = (request->buffers.size() + m_maxBatchSize - 1) / m_maxBatchSize;
+  request->cb = cb;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t begin = 0; begin < request->buffers.size(); begin += m_maxBatchSize) {
+      m_queue.push_back({request, begin, std::min(begin + m_maxBatchSize, request->buffers.size())});
+    }
+  }
+  m_cv.notify_all();
+}
+
+void
+SigningPool::runWorker()
+{
+  while (true) {
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_shouldStop || !m_queue.empty(); });
+      if (m_shouldStop) {
+        return;
+      }
+
+      chunk = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    processChunk(chunk);
+  }
+}
+
+void
+SigningPool::processChunk(const Chunk& chunk)
+{
+  Request& request = *chunk.request;
+  NDN_LOG_TRACE("Signing " << chunk.end - chunk.begin << " buffers with " <<
+                request.key->getKeyName());
+
+  // each worker writes distinct elements of the signatures vector
+  for (size_t i = chunk.begin; i < chunk.end; ++i) {
+    try {
+      request.signatures[i] = request.key->sign(request.digestAlgorithm,
+                                                request.buffers[i].first,
+                                                request.buffers[i].second);
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_DEBUG("Signing failed: " << e.what());
+    }
+  }
+
+  {
+    // the mutex also makes signatures written by other workers visible to the last one
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--request.nRemainingChunks > 0) {
+      return;
+    }
+  }
+
+  auto completed = chunk.request;
+  m_ioService.post([completed] {
+    completed->cb(completed->signatures);
+    // release the callback, and anything it captures, on the io_service thread
+    completed->cb = nullptr;
+  });
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
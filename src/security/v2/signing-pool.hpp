@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_SIGNING_POOL_HPP
+#define NDN_SECURITY_V2_SIGNING_POOL_HPP
+
+#include "../security-common.hpp"
+#include "../tpm/key-handle.hpp"
+#include "../../net/asio-fwd.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Pool of worker threads that sign buffers
+ *
+ * A signing request covering many buffers is split into chunks of at most maxBatchSize
+ * buffers, so that several workers sign parts of the same request at once.  When all buffers
+ * of a request have been signed, its callback is invoked from the io_service passed to the
+ * constructor.
+ *
+ * The key handle of a request is used by several workers concurrently, which requires the TPM
+ * back-end to support signing from multiple threads.  The in-memory and file back-ends do.
+ *
+ * All public methods must be called from the thread running the io_service.
+ *
+ * @sa KeyChain::setSigningPool
+ */
+class SigningPool : noncopyable
+{
+public:
+  /**
+   * @brief Callback that receives the signatures of a request, in the order of the buffers
+   *
+   * A signature is nullptr if signing the corresponding buffer failed.
+   */
+  typedef function<void(const std::vector<ConstBufferPtr>& signatures)> SigningCallback;
+
+  /**
+   * @brief Start worker threads
+   *
+   * @param ioService    io_service from which signing callbacks are invoked
+   * @param nThreads     number of worker threads, must be positive
+   * @param maxBatchSize maximum number of buffers signed by a worker at once, must be positive
+   * @throw std::invalid_argument @p nThreads or @p maxBatchSize is zero
+   */
+  SigningPool(boost::asio::io_service& ioService, size_t nThreads, size_t maxBatchSize = 32);
+
+  /**
+   * @brief Stop and join worker threads
+   *
+   * Requests not yet completed are abandoned: their callbacks are destroyed without being
+   * invoked.
+   */
+  ~SigningPool();
+
+  /**
+   * @brief Asynchronously sign each of @p buffers using @p key with @p digestAlgorithm
+   * @pre every buffer stays valid until @p cb is invoked
+   */
+  void
+  sign(shared_ptr<const tpm::KeyHandle> key, DigestAlgorithm digestAlgorithm,
+       std::vector<std::pair<const uint8_t*, size_t>> buffers, const SigningCallback& cb);
+
+private:
+  struct Request
+  {
+    shared_ptr<const tpm::KeyHandle> key;
+    DigestAlgorithm digestAlgorithm;
+    std::vector<std::pair<const uint8_t*, size_t>> buffers;
+    std::vector<ConstBufferPtr> signatures;
+    size_t nRemainingChunks; ///< protected by m_mutex
+    SigningCallback cb;
+  };
+
+  struct Chunk
+  {
+    shared_ptr<Request> request;
+    size_t begin;
+    size_t end;
+  };
+
+  void
+  runWorker();
+
+  void
+  processChunk(const Chunk& chunk);
+
+private:
+  boost::asio::io_service& m_ioService;
+  const size_t m_maxBatchSize;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Chunk> m_queue;
+  bool m_shouldStop;
+
+  std::vector<std::thread> m_workers;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_SIGNING_POOL_HPP
@@ -38,6 +38,8 @@ namespace validator_config {
 ValidationPolicyConfig::ValidationPolicyConfig()
   : m_shouldBypass(false)
   , m_isConfigured(false)
+  , m_dataRuleIndex(tlv::Data)
+  , m_interestRuleIndex(tlv::Interest)
 {
 }
 
@@ -77,6 +79,8 @@ ValidationPolicyConfig::load(const ConfigSection& configSection, const std::stri
 {
   if (m_isConfigured) {
     m_shouldBypass = false;
+    m_dataRuleIndex.clear();
+    m_interestRuleIndex.clear();
     m_dataRules.clear();
     m_interestRules.clear();
     m_validator->resetAnchors();
@@ -97,9 +101,11 @@ ValidationPolicyConfig::load(const ConfigSection& configSection, const std::stri
     if (boost::iequals(sectionName, "rule")) {
       auto rule = Rule::create(section, filename);
       if (rule->getPktType() == tlv::Data) {
+        m_dataRuleIndex.insert(*rule);
         m_dataRules.push_back(std::move(rule));
       }
       else if (rule->getPktType() == tlv::Interest) {
+        m_interestRuleIndex.insert(*rule);
         m_interestRules.push_back(std::move(rule));
       }
     }
@@ -252,14 +258,13 @@ ValidationPolicyConfig::checkPolicy(const Data& data, const shared_ptr<Validatio
     return;
   }
 
-  for (const auto& rule : m_dataRules) {
-    if (rule->match(tlv::Data, data.getName())) {
-      if (rule->check(tlv::Data, data.getName(), klName, state)) {
-        return continueValidation(make_shared<CertificateRequest>(Interest(klName)), state);
-      }
-      // rule->check calls state->fail(...) if the check fails
-      return;
+  const Rule* rule = m_dataRuleIndex.find(data.getName());
+  if (rule != nullptr) {
+    if (rule->check(tlv::Data, data.getName(), klName, state)) {
+      return continueValidation(make_shared<CertificateRequest>(Interest(klName)), state);
     }
+    // rule->check calls state->fail(...) if the check fails
+    return;
   }
 
   return state->fail({ValidationError::POLICY_ERROR,
@@ -281,14 +286,13 @@ ValidationPolicyConfig::checkPolicy(const Interest& interest, const shared_ptr<V
     return;
   }
 
-  for (const auto& rule : m_interestRules) {
-    if (rule->match(tlv::Interest, interest.getName())) {
-      if (rule->check(tlv::Interest, interest.getName(), klName, state)) {
-        return continueValidation(make_shared<CertificateRequest>(Interest(klName)), state);
-      }
-      // rule->check calls state->fail(...) if the check fails
-      return;
+  const Rule* rule = m_interestRuleIndex.find(interest.getName());
+  if (rule != nullptr) {
+    if (rule->check(tlv::Interest, interest.getName(), klName, state)) {
+      return continueValidation(make_shared<CertificateRequest>(Interest(klName)), state);
     }
+    // rule->check calls state->fail(...) if the check fails
+    return;
   }
 
   return state->fail({ValidationError::POLICY_ERROR,
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,6 +24,7 @@
 
 #include "validation-policy.hpp"
 #include "validator-config/rule.hpp"
+#include "validator-config/rule-index.hpp"
 #include "validator-config/common.hpp"
 
 namespace ndn {
@@ -86,6 +87,8 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   std::vector<unique_ptr<Rule>> m_dataRules;
   std::vector<unique_ptr<Rule>> m_interestRules;
+  RuleIndex m_dataRuleIndex;
+  RuleIndex m_interestRuleIndex;
 };
 
 } // namespace validator_config
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -20,7 +20,9 @@
  */
 
 #include "validation-state.hpp"
+#include "public-key-cache.hpp"
 #include "validator.hpp"
+#include "verification-pool.hpp"
 #include "../verification-helpers.hpp"
 #include "util/logger.hpp"
 
@@ -63,13 +65,20 @@ ValidationState::addCertificate(const Certificate& cert)
 }
 
 const Certificate*
-ValidationState::verifyCertificateChain(const Certificate& trustedCert)
+ValidationState::verifyCertificateChain(const Certificate& trustedCert, PublicKeyCache& keyCache)
 {
   const Certificate* validatedCert = &trustedCert;
   for (auto it = m_certificateChain.begin(); it != m_certificateChain.end(); ++it) {
     const auto& certToValidate = *it;
 
-    if (!verifySignature(certToValidate, *validatedCert)) {
+    if (keyCache.isVerified(certToValidate)) {
+      NDN_LOG_TRACE_DEPTH("Previously verified certificate `" << certToValidate.getName() << "`");
+      validatedCert = &certToValidate;
+      continue;
+    }
+
+    auto key = keyCache.get(*validatedCert);
+    if (key == nullptr || !verifySignature(certToValidate, *key)) {
       this->fail({ValidationError::Code::INVALID_SIGNATURE, "Invalid signature of certificate `" +
                   certToValidate.getName().toUri() + "`"});
       m_certificateChain.erase(it, m_certificateChain.end());
@@ -77,6 +86,7 @@ ValidationState::verifyCertificateChain(const Certificate& trustedCert)
     }
     else {
       NDN_LOG_TRACE_DEPTH("OK signature for certificate `" << certToValidate.getName() << "`");
+      keyCache.markVerified(certToValidate);
       validatedCert = &certToValidate;
     }
   }
@@ -105,9 +115,24 @@ DataValidationState::~DataValidationState()
 }
 
 void
-DataValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+DataValidationState::verifyOriginalPacket(const Certificate& trustedCert, PublicKeyCache& keyCache)
+{
+  auto key = keyCache.get(trustedCert);
+  finishVerification(key != nullptr && verifySignature(m_data, *key));
+}
+
+void
+DataValidationState::verifyOriginalPacket(const Certificate& trustedCert, VerificationPool& pool,
+                                          const shared_ptr<ValidationState>& self)
 {
-  if (verifySignature(m_data, trustedCert)) {
+  BOOST_ASSERT(self.get() == this);
+  pool.verify(m_data, trustedCert, [this, self] (bool isValid) { finishVerification(isValid); });
+}
+
+void
+DataValidationState::finishVerification(bool isValid)
+{
+  if (isValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for data `" << m_data.getName() << "`");
     m_successCb(m_data);
     BOOST_ASSERT(boost::logic::indeterminate(m_outcome));
@@ -165,9 +190,26 @@ InterestValidationState::~InterestValidationState()
 }
 
 void
-InterestValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+InterestValidationState::verifyOriginalPacket(const Certificate& trustedCert,
+                                              PublicKeyCache& keyCache)
+{
+  auto key = keyCache.get(trustedCert);
+  finishVerification(key != nullptr && verifySignature(m_interest, *key));
+}
+
+void
+InterestValidationState::verifyOriginalPacket(const Certificate& trustedCert,
+                                              VerificationPool& pool,
+                                              const shared_ptr<ValidationState>& self)
+{
+  BOOST_ASSERT(self.get() == this);
+  pool.verify(m_interest, trustedCert, [this, self] (bool isValid) { finishVerification(isValid); });
+}
+
+void
+InterestValidationState::finishVerification(bool isValid)
 {
-  if (verifySignature(m_interest, trustedCert)) {
+  if (isValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for interest `" << m_interest.getName() << "`");
     this->afterSuccess(m_interest);
     BOOST_ASSERT(boost::logic::indeterminate(m_outcome));
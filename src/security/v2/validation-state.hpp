@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -36,6 +36,8 @@ namespace security {
 namespace v2 {
 
 class Validator;
+class PublicKeyCache;
+class VerificationPool;
 
 /**
  * @brief Validation state
@@ -108,9 +110,23 @@ private: // Interface intended to be used only by Validator class
    * @brief Verify signature of the original packet
    *
    * @param trustCert The certificate that signs the original packet
+   * @param keyCache  Cache from which the public key of @p trustedCert is obtained
    */
   virtual void
-  verifyOriginalPacket(const Certificate& trustedCert) = 0;
+  verifyOriginalPacket(const Certificate& trustedCert, PublicKeyCache& keyCache) = 0;
+
+  /**
+   * @brief Verify signature of the original packet on a worker thread of @p pool
+   *
+   * Success or failure callback is invoked later from the io_service of @p pool.
+   *
+   * @param trustCert The certificate that signs the original packet
+   * @param pool      The pool that performs the verification
+   * @param self      Pointer to this state, which is kept alive until the verification completes
+   */
+  virtual void
+  verifyOriginalPacket(const Certificate& trustedCert, VerificationPool& pool,
+                       const shared_ptr<ValidationState>& self) = 0;
 
   /**
    * @brief Call success callback of the original packet without signature validation
@@ -129,11 +145,14 @@ private: // Interface intended to be used only by Validator class
    * @retval Certificate to validate original data packet, either m_certificateChain.back() or
    *         trustedCert if the certificate chain is empty.
    *
+   * Certificates marked as verified in @p keyCache are accepted without verifying their
+   * signatures again, and the others are marked after successful verification.
+   *
    * @post m_certificateChain includes a list of certificates successfully verified by
    *       @p trustedCert.
    */
   const Certificate*
-  verifyCertificateChain(const Certificate& trustedCert);
+  verifyCertificateChain(const Certificate& trustedCert, PublicKeyCache& keyCache);
 
 protected:
   boost::logic::tribool m_outcome;
@@ -187,7 +206,17 @@ public:
 
 private:
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  verifyOriginalPacket(const Certificate& trustedCert, PublicKeyCache& keyCache) final;
+
+  void
+  verifyOriginalPacket(const Certificate& trustedCert, VerificationPool& pool,
+                       const shared_ptr<ValidationState>& self) final;
+
+  /**
+   * @brief Call success or failure callback according to the signature verification result
+   */
+  void
+  finishVerification(bool isValid);
 
   void
   bypassValidation() final;
@@ -236,7 +265,17 @@ public:
 
 private:
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  verifyOriginalPacket(const Certificate& trustedCert, PublicKeyCache& keyCache) final;
+
+  void
+  verifyOriginalPacket(const Certificate& trustedCert, VerificationPool& pool,
+                       const shared_ptr<ValidationState>& self) final;
+
+  /**
+   * @brief Call success or failure callback according to the signature verification result
+   */
+  void
+  finishVerification(bool isValid);
 
   void
   bypassValidation() final;
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -92,6 +92,18 @@ class RelationNameFilter : public Filter
 public:
   RelationNameFilter(const Name& name, NameRelation relation);
 
+  const Name&
+  getName() const
+  {
+    return m_name;
+  }
+
+  NameRelation
+  getRelation() const
+  {
+    return m_relation;
+  }
+
 private:
   bool
   matchName(const Name& pktName) override;
@@ -126,6 +138,12 @@ public:
   explicit
   RegexNameFilter(const Regex& regex);
 
+  const std::string&
+  getExpr() const
+  {
+    return m_regex.getExpr();
+  }
+
 private:
   bool
   matchName(const Name& pktName) override;
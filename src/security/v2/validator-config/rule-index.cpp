@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "rule-index.hpp"
+#include "security/security-common.hpp"
+#include "util/logger.hpp"
+
+NDN_LOG_INIT(ndn.security.validator_config.RuleIndex);
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+
+/**
+ * @brief Maximum number of RegexNameFilters merged into one automaton
+ *
+ * A larger group shares more predicates, but its state sets are wider.
+ */
+static const size_t MAX_REGEX_GROUP_SIZE = 64;
+
+RuleIndex::RuleIndex(uint32_t pktType)
+  : m_pktType(pktType)
+{
+}
+
+void
+RuleIndex::insert(const Rule& rule)
+{
+  BOOST_ASSERT(rule.getPktType() == m_pktType);
+
+  size_t position = m_rules.size();
+  m_rules.push_back(&rule);
+
+  const auto& filters = rule.getFilters();
+  bool isIndexable = !filters.empty();
+  for (const auto& filter : filters) {
+    if (dynamic_cast<RelationNameFilter*>(filter.get()) == nullptr &&
+        dynamic_cast<RegexNameFilter*>(filter.get()) == nullptr) {
+      isIndexable = false;
+    }
+  }
+  if (!isIndexable) {
+    m_otherRules.push_back(position);
+    return;
+  }
+
+  for (const auto& filter : filters) {
+    if (auto relationFilter = dynamic_cast<RelationNameFilter*>(filter.get())) {
+      getNode(relationFilter->getName()).relations.emplace_back(position,
+                                                                relationFilter->getRelation());
+    }
+    else {
+      insertRegex(position, static_cast<RegexNameFilter&>(*filter));
+    }
+  }
+}
+
+RuleIndex::Node&
+RuleIndex::getNode(const Name& prefix)
+{
+  Node* node = &m_root;
+  for (const auto& component : prefix) {
+    auto& child = node->children[component];
+    if (child == nullptr) {
+      child = make_unique<Node>();
+    }
+    node = child.get();
+  }
+  return *node;
+}
+
+void
+RuleIndex::insertRegex(size_t position, RegexNameFilter& filter)
+{
+  Name prefix;
+  auto automaton = RegexAutomaton::compileTop(filter.getExpr());
+  if (automaton != nullptr) {
+    prefix = automaton->getRequiredPrefix();
+  }
+
+  auto& groups = getNode(prefix).regexGroups;
+  if (groups.empty() || groups.back().filters.size() >= MAX_REGEX_GROUP_SIZE) {
+    groups.emplace_back();
+  }
+
+  RegexGroup& group = groups.back();
+  group.positions.push_back(position);
+  group.filters.push_back(&filter);
+  group.exprs.push_back(filter.getExpr());
+  group.automaton = nullptr;
+  group.isCompiled = false;
+}
+
+void
+RuleIndex::clear()
+{
+  m_rules.clear();
+  m_otherRules.clear();
+  m_root.children.clear();
+  m_root.relations.clear();
+  m_root.regexGroups.clear();
+}
+
+const Rule*
+RuleIndex::find(const Name& pktName)
+{
+  size_t best = m_rules.size();
+
+  for (size_t position : m_otherRules) {
+    if (m_rules[position]->match(m_pktType, pktName)) {
+      best = position;
+      break;
+    }
+  }
+
+  // filters match the name without the signed Interest components, as in Filter::match
+  if (m_pktType != tlv::Interest || pktName.size() >= signed_interest::MIN_SIZE) {
+    size_t nameLen = pktName.size() - (m_pktType == tlv::Interest ? signed_interest::MIN_SIZE : 0);
+
+    Node* node = &m_root;
+    for (size_t depth = 0; ; ++depth) {
+      for (const auto& relation : node->relations) {
+        // the filter name, of length depth, is a prefix of the name
+        if (relation.first < best &&
+            (relation.second == NameRelation::IS_PREFIX_OF ||
+             (relation.second == NameRelation::EQUAL && depth == nameLen) ||
+             (relation.second == NameRelation::IS_STRICT_PREFIX_OF && depth < nameLen))) {
+          best = relation.first;
+        }
+      }
+      findInRegexGroups(node->regexGroups, pktName, nameLen, best);
+
+      if (depth == nameLen) {
+        break;
+      }
+      auto it = node->children.find(pktName[depth]);
+      if (it == node->children.end()) {
+        break;
+      }
+      node = it->second.get();
+    }
+  }
+
+  if (best == m_rules.size()) {
+    NDN_LOG_TRACE("No rule matches " << pktName);
+    return nullptr;
+  }
+  NDN_LOG_TRACE(pktName << " matches rule " << m_rules[best]->getId());
+  return m_rules[best];
+}
+
+void
+RuleIndex::findInRegexGroups(std::vector<RegexGroup>& groups, const Name& pktName,
+                             size_t nameLen, size_t& best)
+{
+  for (RegexGroup& group : groups) {
+    if (group.positions.front() >= best) {
+      // groups are in ascending order of rule position
+      break;
+    }
+
+    if (!group.isCompiled) {
+      group.automaton = RegexAutomaton::compileUnion(group.exprs);
+      group.isCompiled = true;
+    }
+
+    if (group.automaton != nullptr) {
+      size_t i = group.automaton->findFirst(pktName, 0, nameLen);
+      if (i != RegexAutomaton::NO_MATCH) {
+        best = std::min(best, group.positions[i]);
+        return;
+      }
+      continue;
+    }
+
+    for (size_t i = 0; i < group.filters.size() && group.positions[i] < best; ++i) {
+      if (group.filters[i]->match(m_pktType, pktName)) {
+        best = group.positions[i];
+        return;
+      }
+    }
+  }
+}
+
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
+#define NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
+
+#include "rule.hpp"
+#include "../../../util/regex/regex-automaton.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+
+/**
+ * @brief Finds the first rule whose filters match a packet name
+ *
+ * The result is the same as calling Rule::match on each rule in insertion order, but the
+ * filters are stored in a name tree, which is walked along the packet name, so that only
+ * the filters under a prefix of the packet name are considered:
+ *  - a RelationNameFilter is stored under its name;
+ *  - a RegexNameFilter is stored under the prefix that every name it matches starts with,
+ *    and consecutive ones under the same prefix are merged into a RegexAutomaton union,
+ *    which reports the first matching rule in a single pass over the packet name.
+ *
+ * Rules without filters, or with filters of other types, are matched with Rule::match.
+ * Candidates are pruned by position, so that filters of rules after the best match found
+ * so far are not evaluated.
+ */
+class RuleIndex : noncopyable
+{
+public:
+  explicit
+  RuleIndex(uint32_t pktType);
+
+  /**
+   * @brief Append @p rule after the previously inserted rules
+   * @pre @p rule is for the packet type of the index, and remains valid until clear()
+   */
+  void
+  insert(const Rule& rule);
+
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_rules.size();
+  }
+
+  /**
+   * @brief Find the first rule that matches @p pktName
+   * @param pktName packet name, for signed Interests the last two components are not removed
+   * @return the rule, or nullptr if no rule matches
+   */
+  const Rule*
+  find(const Name& pktName);
+
+private:
+  /**
+   * @brief RegexNameFilters of consecutive rules
+   */
+  struct RegexGroup
+  {
+    std::vector<size_t> positions; ///< rule position of each filter, in ascending order
+    std::vector<Filter*> filters;
+    std::vector<std::string> exprs;
+    shared_ptr<const RegexAutomaton> automaton; ///< union of exprs, nullptr if unsupported
+    bool isCompiled = false;
+  };
+
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<std::pair<size_t, NameRelation>> relations; ///< rule position and relation
+    std::vector<RegexGroup> regexGroups;
+  };
+
+  Node&
+  getNode(const Name& prefix);
+
+  void
+  insertRegex(size_t position, RegexNameFilter& filter);
+
+  /**
+   * @brief Lower @p best to the position of the first rule whose regex filter in @p groups
+   *        matches the first @p nameLen components of @p pktName
+   */
+  void
+  findInRegexGroups(std::vector<RegexGroup>& groups, const Name& pktName, size_t nameLen,
+                    size_t& best);
+
+private:
+  const uint32_t m_pktType;
+  std::vector<const Rule*> m_rules;
+  std::vector<size_t> m_otherRules; ///< positions of rules matched with Rule::match
+  Node m_root;
+};
+
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
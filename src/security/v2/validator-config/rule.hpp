@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -50,6 +50,12 @@ public:
     return m_pktType;
   }
 
+  const std::vector<unique_ptr<Filter>>&
+  getFilters() const
+  {
+    return m_filters;
+  }
+
   void
   addFilter(unique_ptr<Filter> filter);
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -71,6 +71,18 @@ Validator::getMaxDepth() const
   return m_maxDepth;
 }
 
+void
+Validator::setVerificationPool(shared_ptr<VerificationPool> pool)
+{
+  m_verificationPool = std::move(pool);
+}
+
+const PublicKeyCache&
+Validator::getPublicKeyCache() const
+{
+  return m_keyCache;
+}
+
 void
 Validator::validate(const Data& data,
                     const DataValidationSuccessCallback& successCb,
@@ -158,9 +170,14 @@ Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
   if (cert != nullptr) {
     NDN_LOG_TRACE_DEPTH("Found trusted certificate " << cert->getName());
 
-    cert = state->verifyCertificateChain(*cert);
+    cert = state->verifyCertificateChain(*cert, m_keyCache);
     if (cert != nullptr) {
-      state->verifyOriginalPacket(*cert);
+      if (m_verificationPool != nullptr) {
+        state->verifyOriginalPacket(*cert, *m_verificationPool, state);
+      }
+      else {
+        state->verifyOriginalPacket(*cert, m_keyCache);
+      }
     }
     for (auto trustedCert = std::make_move_iterator(state->m_certificateChain.begin());
          trustedCert != std::make_move_iterator(state->m_certificateChain.end());
@@ -198,6 +215,7 @@ void
 Validator::resetAnchors()
 {
   CertificateStorage::resetAnchors();
+  m_keyCache.clear();
 }
 
 void
@@ -210,6 +228,7 @@ void
 Validator::resetVerifiedCertificates()
 {
   CertificateStorage::resetVerifiedCerts();
+  m_keyCache.clear();
 }
 
 } // namespace v2
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -25,9 +25,11 @@
 #include "certificate-fetcher.hpp"
 #include "certificate-request.hpp"
 #include "certificate-storage.hpp"
+#include "public-key-cache.hpp"
 #include "validation-callback.hpp"
 #include "validation-policy.hpp"
 #include "validation-state.hpp"
+#include "verification-pool.hpp"
 
 namespace ndn {
 
@@ -89,6 +91,28 @@ public:
   size_t
   getMaxDepth() const;
 
+  /**
+   * @brief Offload signature verification of validated packets to worker threads of @p pool
+   *
+   * With a pool, success and failure callbacks of validations whose certificate chain is
+   * already trusted are invoked asynchronously from the io_service of @p pool, rather than
+   * from within validate().  Signatures of certificates in the chain are still verified on the
+   * calling thread, as they are cached once verified.
+   *
+   * @param pool the pool, or nullptr to verify all signatures on the calling thread
+   */
+  void
+  setVerificationPool(shared_ptr<VerificationPool> pool);
+
+  /**
+   * @brief Get the cache of public keys parsed from certificates
+   *
+   * The cache also remembers verified certificates of the chain, and provides hit and miss
+   * counters of both kinds of lookups.
+   */
+  const PublicKeyCache&
+  getPublicKeyCache() const;
+
   /**
    * @brief Asynchronously validate @p data
    *
@@ -180,6 +204,8 @@ private:
   unique_ptr<ValidationPolicy> m_policy;
   unique_ptr<CertificateFetcher> m_certFetcher;
   size_t m_maxDepth;
+  shared_ptr<VerificationPool> m_verificationPool;
+  PublicKeyCache m_keyCache;
 };
 
 } // namespace v2
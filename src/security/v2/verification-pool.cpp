@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "verification-pool.hpp"
+#include "../transform/public-key.hpp"
+#include "../../util/logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+NDN_LOG_INIT(ndn.security.v2.VerificationPool);
+
+VerificationPool::VerificationPool(boost::asio::io_service& ioService, size_t nThreads,
+                                   size_t maxBatchSize)
+  : m_ioService(ioService)
+  , m_maxBatchSize(maxBatchSize)
+  , m_shouldStop(false)
+{
+  if (nThreads == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("nThreads must be positive"));
+  }
+  if (maxBatchSize == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("maxBatchSize must be positive"));
+  }
+
+  m_workers.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_workers.emplace_back(&VerificationPool::runWorker, this);
+  }
+}
+
+VerificationPool::~VerificationPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shouldStop = true;
+  }
+  m_cv.notify_all();
+
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void
+VerificationPool::verify(const Data& data, const Certificate& cert, const VerificationCallback& cb)
+{
+  // parsing may decode lazily decoded fields, so it must happen on the calling thread
+  auto parsed = detail::parseSignedPortion(data);
+  enqueue(data.wireEncode(), parsed, cert, cb);
+}
+
+void
+VerificationPool::verify(const Interest& interest, const Certificate& cert,
+                         const VerificationCallback& cb)
+{
+  auto parsed = detail::parseSignedPortion(interest);
+  enqueue(interest.getName().wireEncode(), parsed, cert, cb);
+}
+
+void
+VerificationPool::enqueue(const Block& wire, const detail::SignedPortion& parsed,
+                          const Certificate& cert, const VerificationCallback& cb)
+{
+  BOOST_ASSERT(cb != nullptr);
+
+  Job job;
+  bool isParsable = false;
+  std::tie(isParsable, job.buf, job.bufLen, job.sig, job.sigLen) = parsed;
+  if (!isParsable) {
+    m_ioService.post([cb] { cb(false); });
+    return;
+  }
+  job.wire = wire;
+  job.cb = cb;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_openBatches.find(cert.getName());
+    if (it == m_openBatches.end() || it->second->jobs.size() >= m_maxBatchSize) {
+      m_queue.push_back({cert.getName(), cert.getContent(), {}});
+      m_queue.back().jobs.reserve(m_maxBatchSize);
+      m_openBatches[cert.getName()] = std::prev(m_queue.end());
+      it = m_openBatches.find(cert.getName());
+    }
+    it->second->jobs.push_back(std::move(job));
+  }
+  m_cv.notify_one();
+}
+
+void
+VerificationPool::runWorker()
+{
+  while (true) {
+    Batch batch;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_shouldStop || !m_queue.empty(); });
+      if (m_shouldStop) {
+        return;
+      }
+
+      auto it = m_openBatches.find(m_queue.front().certName);
+      if (it != m_openBatches.end() && it->second == m_queue.begin()) {
+        m_openBatches.erase(it);
+      }
+      batch = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    processBatch(batch);
+  }
+}
+
+void
+VerificationPool::processBatch(Batch& batch)
+{
+  NDN_LOG_TRACE("Verifying " << batch.jobs.size() << " signatures by " << batch.certName);
+
+  PublicKey key;
+  bool isKeyLoaded = true;
+  try {
+    key.loadPkcs8(batch.keyBits.value(), batch.keyBits.value_size());
+  }
+  catch (const PublicKey::Error&) {
+    isKeyLoaded = false;
+  }
+
+  auto results = make_shared<std::vector<std::pair<VerificationCallback, bool>>>();
+  results->reserve(batch.jobs.size());
+  for (auto& job : batch.jobs) {
+    bool isValid = isKeyLoaded && verifySignature(job.buf, job.bufLen, job.sig, job.sigLen, key);
+    results->emplace_back(std::move(job.cb), isValid);
+  }
+
+  m_ioService.post([results] {
+    for (const auto& result : *results) {
+      result.first(result.second);
+    }
+    // release the callbacks, and anything they capture, on the io_service thread
+    results->clear();
+  });
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_VERIFICATION_POOL_HPP
+#define NDN_SECURITY_V2_VERIFICATION_POOL_HPP
+
+#include "certificate.hpp"
+#include "../verification-helpers.hpp"
+#include "../../interest.hpp"
+#include "../../net/asio-fwd.hpp"
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Pool of worker threads that verify packet signatures
+ *
+ * Signature verification requests are queued per signing certificate, so that a worker loads
+ * a public key once and verifies a whole batch of packets signed by that key.  The outcome of
+ * each verification is delivered by a callback invoked from the io_service passed to the
+ * constructor; callbacks of a batch are dispatched together in the original request order.
+ *
+ * All public methods must be called from the thread running the io_service.
+ *
+ * @sa Validator::setVerificationPool
+ */
+class VerificationPool : noncopyable
+{
+public:
+  /**
+   * @brief Callback that receives the outcome of a verification
+   */
+  typedef function<void(bool isValid)> VerificationCallback;
+
+  /**
+   * @brief Start worker threads
+   *
+   * @param ioService    io_service from which verification callbacks are invoked
+   * @param nThreads     number of worker threads, must be positive
+   * @param maxBatchSize maximum number of verifications processed by a worker at once,
+   *                     must be positive
+   * @throw std::invalid_argument @p nThreads or @p maxBatchSize is zero
+   */
+  VerificationPool(boost::asio::io_service& ioService, size_t nThreads, size_t maxBatchSize = 32);
+
+  /**
+   * @brief Stop and join worker threads
+   *
+   * Verifications not yet started by a worker are abandoned: their callbacks are destroyed
+   * without being invoked.
+   */
+  ~VerificationPool();
+
+  /**
+   * @brief Asynchronously verify the signature of @p data using the key in @p cert
+   */
+  void
+  verify(const Data& data, const Certificate& cert, const VerificationCallback& cb);
+
+  /**
+   * @brief Asynchronously verify the signature of signed @p interest using the key in @p cert
+   * @sa docs/specs/signed-interest.rst
+   */
+  void
+  verify(const Interest& interest, const Certificate& cert, const VerificationCallback& cb);
+
+private:
+  struct Job
+  {
+    Block wire; ///< keeps the signed portion and the signature value alive
+    const uint8_t* buf;
+    size_t bufLen;
+    const uint8_t* sig;
+    size_t sigLen;
+    VerificationCallback cb;
+  };
+
+  struct Batch
+  {
+    Name certName;
+    Block keyBits;
+    std::vector<Job> jobs;
+  };
+
+  void
+  enqueue(const Block& wire, const detail::SignedPortion& parsed, const Certificate& cert,
+          const VerificationCallback& cb);
+
+  void
+  runWorker();
+
+  void
+  processBatch(Batch& batch);
+
+private:
+  boost::asio::io_service& m_ioService;
+  const size_t m_maxBatchSize;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::list<Batch> m_queue;
+  /// batch accepting more jobs for each certificate, protected by m_mutex
+  std::unordered_map<Name, std::list<Batch>::iterator> m_openBatches;
+  bool m_shouldStop;
+
+  std::vector<std::thread> m_workers;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VERIFICATION_POOL_HPP
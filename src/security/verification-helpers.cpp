@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -68,8 +68,10 @@ verifySignature(const uint8_t* data, size_t dataLen, const uint8_t* sig, size_t
   return verifySignature(data, dataLen, sig, sigLen, pKey);
 }
 
-static std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t>
-parse(const Data& data)
+namespace detail {
+
+SignedPortion
+parseSignedPortion(const Data& data)
 {
   try {
     return std::make_tuple(true,
@@ -83,8 +85,8 @@ parse(const Data& data)
   }
 }
 
-static std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t>
-parse(const Interest& interest)
+SignedPortion
+parseSignedPortion(const Interest& interest)
 {
   const Name& interestName = interest.getName();
 
@@ -104,8 +106,10 @@ parse(const Interest& interest)
   }
 }
 
+} // namespace detail
+
 static bool
-verifySignature(const std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t>& params,
+verifySignature(const detail::SignedPortion& params,
                 const v2::PublicKey& pKey)
 {
   bool isParsable = false;
@@ -123,7 +127,7 @@ verifySignature(const std::tuple<bool, const uint8_t*, size_t, const uint8_t*, s
 }
 
 static bool
-verifySignature(const std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t>& params,
+verifySignature(const detail::SignedPortion& params,
                 const uint8_t* key, size_t keyLen)
 {
   bool isParsable = false;
@@ -143,49 +147,53 @@ verifySignature(const std::tuple<bool, const uint8_t*, size_t, const uint8_t*, s
 bool
 verifySignature(const Data& data, const v2::PublicKey& key)
 {
-  return verifySignature(parse(data), key);
+  return verifySignature(detail::parseSignedPortion(data), key);
 }
 
 bool
 verifySignature(const Interest& interest, const v2::PublicKey& key)
 {
-  return verifySignature(parse(interest), key);
+  return verifySignature(detail::parseSignedPortion(interest), key);
 }
 
 bool
 verifySignature(const Data& data, const pib::Key& key)
 {
-  return verifySignature(parse(data), key.getPublicKey().data(), key.getPublicKey().size());
+  return verifySignature(detail::parseSignedPortion(data),
+                         key.getPublicKey().data(), key.getPublicKey().size());
 }
 
 bool
 verifySignature(const Interest& interest, const pib::Key& key)
 {
-  return verifySignature(parse(interest), key.getPublicKey().data(), key.getPublicKey().size());
+  return verifySignature(detail::parseSignedPortion(interest),
+                         key.getPublicKey().data(), key.getPublicKey().size());
 }
 
 bool
 verifySignature(const Data& data, const uint8_t* key, size_t keyLen)
 {
-  return verifySignature(parse(data), key, keyLen);
+  return verifySignature(detail::parseSignedPortion(data), key, keyLen);
 }
 
 bool
 verifySignature(const Interest& interest, const uint8_t* key, size_t keyLen)
 {
-  return verifySignature(parse(interest), key, keyLen);
+  return verifySignature(detail::parseSignedPortion(interest), key, keyLen);
 }
 
 bool
 verifySignature(const Data& data, const v2::Certificate& cert)
 {
-  return verifySignature(parse(data), cert.getContent().value(), cert.getContent().value_size());
+  return verifySignature(detail::parseSignedPortion(data),
+                         cert.getContent().value(), cert.getContent().value_size());
 }
 
 bool
 verifySignature(const Interest& interest, const v2::Certificate& cert)
 {
-  return verifySignature(parse(interest), cert.getContent().value(), cert.getContent().value_size());
+  return verifySignature(detail::parseSignedPortion(interest),
+                         cert.getContent().value(), cert.getContent().value_size());
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -221,7 +229,7 @@ verifyDigest(const Data& data, DigestAlgorithm algorithm)
   const uint8_t* sig = nullptr;
   size_t sigLen = 0;
 
-  std::tie(isParsable, buf, bufLen, sig, sigLen) = parse(data);
+  std::tie(isParsable, buf, bufLen, sig, sigLen) = detail::parseSignedPortion(data);
 
   if (isParsable) {
     return verifyDigest(buf, bufLen, sig, sigLen, algorithm);
@@ -240,7 +248,7 @@ verifyDigest(const Interest& interest, DigestAlgorithm algorithm)
   const uint8_t* sig = nullptr;
   size_t sigLen = 0;
 
-  std::tie(isParsable, buf, bufLen, sig, sigLen) = parse(interest);
+  std::tie(isParsable, buf, bufLen, sig, sigLen) = detail::parseSignedPortion(interest);
 
   if (isParsable) {
     return verifyDigest(buf, bufLen, sig, sigLen, algorithm);
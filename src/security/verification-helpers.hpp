@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,6 +24,8 @@
 
 #include "security-common.hpp"
 
+#include <tuple>
+
 namespace ndn {
 
 class Interest;
@@ -138,6 +140,31 @@ verifyDigest(const Data& data, DigestAlgorithm algorithm);
 bool
 verifyDigest(const Interest& interest, DigestAlgorithm algorithm);
 
+namespace detail {
+
+/**
+ * @brief Whether the packet is parsable, followed by the location and length of its signed
+ *        portion and of its signature value
+ *
+ * The pointers refer to the wire encoding of the packet, which must outlive them.
+ */
+using SignedPortion = std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t>;
+
+/**
+ * @brief Locate the signed portion and the signature value of @p data
+ */
+SignedPortion
+parseSignedPortion(const Data& data);
+
+/**
+ * @brief Locate the signed portion and the signature value of signed @p interest
+ * @sa docs/specs/signed-interest.rst
+ */
+SignedPortion
+parseSignedPortion(const Interest& interest);
+
+} // namespace detail
+
 } // namespace security
 } // namespace ndn
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -23,11 +23,13 @@
 #define NDN_TRANSPORT_STREAM_TRANSPORT_IMPL_HPP
 
 #include "transport.hpp"
+#include "../encoding/buffer-pool.hpp"
 
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/write.hpp>
 
 #include <list>
+#include <vector>
 
 namespace ndn {
 
@@ -43,11 +45,24 @@ public:
   typedef StreamTransportImpl<BaseTransport, Protocol> Impl;
   typedef std::list<Block> BlockSequence;
   typedef std::list<BlockSequence> TransmissionQueue;
+  typedef Transport::SendMetrics SendMetrics;
+
+  /** \brief maximum number of Blocks gathered into one write operation
+   *
+   *  This matches the number of buffers that Boost.Asio passes to one sendmsg call.
+   */
+  static constexpr size_t MAX_GATHERED_BLOCKS = 64;
 
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
     , m_socket(ioService)
+    , m_receiveOptions(transport.getReceiveOptions())
+    , m_inputBuffer(BufferPool::get().allocate(m_receiveOptions.bufferSize))
+    , m_inputBufferBegin(0)
     , m_inputBufferSize(0)
+    , m_isReadPending(false)
+    , m_isProcessingPending(false)
+    , m_nWritingItems(0)
     , m_isConnecting(false)
     , m_connectTimer(ioService)
   {
@@ -82,6 +97,9 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isReceiving = false;
     m_transmissionQueue.clear();
+    m_nWritingItems = 0;
+    m_transport.m_sendMetrics.nQueuedPackets = 0;
+    m_transport.m_sendMetrics.nBytesInFlight = 0;
   }
 
   void
@@ -104,8 +122,8 @@ public:
 
     if (!m_transport.m_isReceiving) {
       m_transport.m_isReceiving = true;
-      m_inputBufferSize = 0;
-      asyncReceive();
+      // complete elements may have been left in the buffer when the transport was paused
+      scheduleProcessing();
     }
   }
 
@@ -161,26 +179,51 @@ protected:
   void
   send(BlockSequence&& sequence)
   {
-    m_transmissionQueue.emplace_back(sequence);
+    m_transmissionQueue.emplace_back(std::move(sequence));
+    m_transport.m_sendMetrics.nQueuedPackets = m_transmissionQueue.size();
 
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
+    if (m_transport.m_isConnected && m_nWritingItems == 0) {
       asyncWrite();
     }
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
+    // if not connected or there is transmission in progress (m_nWritingItems > 0),
     // next write will be scheduled either in connectHandler or in asyncWriteHandler
   }
 
+  /** \brief start a write operation that gathers as many queued items as possible
+   *
+   *  Items are taken from the front of the transmission queue, up to MAX_GATHERED_BLOCKS Blocks
+   *  in total, and written with a single scatter/gather operation. An item is never split across
+   *  write operations. The items stay in the queue, keeping the Blocks alive, until the write
+   *  operation completes.
+   */
   void
   asyncWrite()
   {
     BOOST_ASSERT(!m_transmissionQueue.empty());
-    boost::asio::async_write(m_socket, m_transmissionQueue.front(),
-      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.begin()));
+    BOOST_ASSERT(m_nWritingItems == 0);
+
+    std::vector<boost::asio::const_buffer> buffers;
+    size_t nBytes = 0;
+    for (const BlockSequence& item : m_transmissionQueue) {
+      if (m_nWritingItems > 0 && buffers.size() + item.size() > MAX_GATHERED_BLOCKS) {
+        break;
+      }
+      for (const Block& block : item) {
+        buffers.emplace_back(block.wire(), block.size());
+        nBytes += block.size();
+      }
+      ++m_nWritingItems;
+    }
+
+    ++m_transport.m_sendMetrics.nWrites;
+    m_transport.m_sendMetrics.nBytesInFlight = nBytes;
+    boost::asio::async_write(m_socket, buffers,
+                             bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1));
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error, TransmissionQueue::iterator queueItem)
+  handleAsyncWrite(const boost::system::error_code& error)
   {
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
@@ -196,7 +239,15 @@ protected:
       return; // queue has been already cleared
     }
 
-    m_transmissionQueue.erase(queueItem);
+    BOOST_ASSERT(m_nWritingItems <= m_transmissionQueue.size());
+    m_transmissionQueue.erase(m_transmissionQueue.begin(),
+                              std::next(m_transmissionQueue.begin(), m_nWritingItems));
+
+    SendMetrics& metrics = m_transport.m_sendMetrics;
+    metrics.nSentPackets += m_nWritingItems;
+    metrics.nQueuedPackets = m_transmissionQueue.size();
+    metrics.nBytesInFlight = 0;
+    m_nWritingItems = 0;
 
     if (!m_transmissionQueue.empty()) {
       asyncWrite();
@@ -206,17 +257,27 @@ protected:
   void
   asyncReceive()
   {
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
+    if (m_isReadPending)
+      return;
+
+    BOOST_ASSERT(m_inputBuffer->size() - m_inputBufferSize >= MAX_NDN_PACKET_SIZE);
+    m_isReadPending = true;
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer->data() + m_inputBufferSize,
+                                               m_inputBuffer->size() - m_inputBufferSize), 0,
                            bind(&Impl::handleAsyncReceive, this->shared_from_this(), _1, _2));
   }
 
   void
   handleAsyncReceive(const boost::system::error_code& error, std::size_t nBytesRecvd)
   {
+    m_isReadPending = false;
+
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
-        // async receive has been explicitly cancelled (e.g., socket close)
+        // async receive has been explicitly cancelled (e.g., socket close or pause)
+        if (m_transport.m_isConnected && m_transport.m_isReceiving) {
+          asyncReceive(); // resumed before the cancellation was delivered
+        }
         return;
       }
 
@@ -225,59 +286,137 @@ protected:
     }
 
     m_inputBufferSize += nBytesRecvd;
-    // do magic
+    processReceived();
+  }
+
+  /** \brief continue delivering buffered elements after yielding to the io_service
+   */
+  void
+  scheduleProcessing()
+  {
+    if (m_isProcessingPending)
+      return;
+
+    m_isProcessingPending = true;
+    m_transport.m_ioService->post(bind(&Impl::handleScheduledProcessing, this->shared_from_this()));
+  }
+
+  void
+  handleScheduledProcessing()
+  {
+    m_isProcessingPending = false;
+
+    if (!m_transport.m_isConnected || !m_transport.m_isReceiving)
+      return;
 
-    std::size_t offset = 0;
-    bool hasProcessedSome = processAllReceived(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0) {
+    processReceived();
+  }
+
+  /** \brief deliver complete TLV elements in the input buffer, then continue receiving
+   *
+   *  At most ReceiveOptions::packetBudget elements are delivered in one invocation. If more
+   *  elements remain, processing is rescheduled through the io_service, so that a flood of
+   *  incoming packets does not starve other handlers such as timers.
+   *
+   *  Each element is a slice of the input buffer that shares its ownership, so that received
+   *  packets are decoded without copying. Later reads append to the unused tail of the same
+   *  buffer; the unprocessed remainder is moved to the front only when the tail can no longer
+   *  hold a packet of maximum size.
+   */
+  void
+  processReceived()
+  {
+    size_t nDelivered = 0;
+    while (m_inputBufferBegin < m_inputBufferSize) {
+      if (nDelivered == m_receiveOptions.packetBudget) {
+        scheduleProcessing();
+        return;
+      }
+
+      bool isOk = false;
+      Block element;
+      std::tie(isOk, element) = Block::fromBuffer(m_inputBuffer,
+                                                  m_inputBuffer->begin() + m_inputBufferBegin,
+                                                  m_inputBuffer->begin() + m_inputBufferSize);
+      if (!isOk)
+        break;
+
+      m_inputBufferBegin += element.size();
+      ++nDelivered;
+      m_transport.receive(element);
+
+      if (!m_transport.m_isConnected) {
+        return; // transport has been closed by the receive callback
+      }
+    }
+
+    if (m_inputBufferSize - m_inputBufferBegin >= MAX_NDN_PACKET_SIZE) {
       m_transport.close();
       BOOST_THROW_EXCEPTION(Transport::Error(boost::system::error_code(),
                                              "input buffer full, but a valid TLV cannot be "
                                              "decoded"));
     }
 
-    if (offset > 0) {
-      if (offset != m_inputBufferSize) {
-        std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize, m_inputBuffer);
-        m_inputBufferSize -= offset;
-      }
-      else {
-        m_inputBufferSize = 0;
-      }
+    if (m_inputBuffer->size() - m_inputBufferSize < MAX_NDN_PACKET_SIZE ||
+        m_inputBufferBegin == m_inputBufferSize) {
+      compactInputBuffer();
     }
 
-    asyncReceive();
+    if (m_transport.m_isReceiving) {
+      asyncReceive();
+    }
   }
 
-  bool
-  processAllReceived(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
+  /** \brief move the unprocessed remainder to the front of the input buffer
+   *
+   *  If received elements are still referencing the buffer, the remainder is copied into a
+   *  new buffer instead, unless the buffer is otherwise empty.
+   */
+  void
+  compactInputBuffer()
   {
-    while (offset < nBytesAvailable) {
-      bool isOk = false;
-      Block element;
-      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
-      if (!isOk)
-        return false;
+    if (m_inputBufferBegin == 0)
+      return;
 
-      m_transport.receive(element);
-      offset += element.size();
+    size_t nRemaining = m_inputBufferSize - m_inputBufferBegin;
+    if (m_inputBuffer.use_count() > 1) {
+      if (nRemaining == 0 && m_inputBuffer->size() - m_inputBufferSize >= MAX_NDN_PACKET_SIZE) {
+        return; // keep appending to the unused tail
+      }
+      auto buffer = BufferPool::get().allocate(m_receiveOptions.bufferSize);
+      std::copy(m_inputBuffer->begin() + m_inputBufferBegin,
+                m_inputBuffer->begin() + m_inputBufferSize, buffer->begin());
+      m_inputBuffer = std::move(buffer);
     }
-    return true;
+    else if (nRemaining > 0) {
+      std::copy(m_inputBuffer->begin() + m_inputBufferBegin,
+                m_inputBuffer->begin() + m_inputBufferSize, m_inputBuffer->begin());
+    }
+    m_inputBufferBegin = 0;
+    m_inputBufferSize = nRemaining;
   }
 
 protected:
   BaseTransport& m_transport;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
+  const Transport::ReceiveOptions m_receiveOptions;
+  shared_ptr<Buffer> m_inputBuffer; ///< may be shared with received elements
+  size_t m_inputBufferBegin;        ///< offset of the first unprocessed octet
+  size_t m_inputBufferSize;         ///< offset past the last received octet
+  bool m_isReadPending;
+  bool m_isProcessingPending;
 
   TransmissionQueue m_transmissionQueue;
+  size_t m_nWritingItems; ///< number of items at the front of queue in the write in progress
   bool m_isConnecting;
 
   boost::asio::deadline_timer m_connectTimer;
 };
 
+template<typename BaseTransport, typename Protocol>
+constexpr size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_GATHERED_BLOCKS;
+
 } // namespace ndn
 
 #endif // NDN_TRANSPORT_STREAM_TRANSPORT_IMPL_HPP
@@ -54,7 +54,7 @@ public:
     this->m_connectTimer.expires_from_now(boost::posix_time::seconds(4));
     this->m_connectTimer.async_wait(bind(&Impl::connectTimeoutHandler, this->shared_from_this(), _1));
 
-    auto resolver = make_shared<typename Protocol::resolver>(ref(this->m_socket.get_io_service()));
+    auto resolver = make_shared<typename Protocol::resolver>(this->m_socket.get_executor());
     resolver->async_resolve(query, bind(&Impl::resolveHandler, this->shared_from_base(), _1, _2, resolver));
   }
 
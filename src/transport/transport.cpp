@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2016 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -33,6 +33,20 @@ Transport::Error::Error(const std::string& msg)
 {
 }
 
+Transport::SendMetrics::SendMetrics()
+  : nQueuedPackets(0)
+  , nBytesInFlight(0)
+  , nWrites(0)
+  , nSentPackets(0)
+{
+}
+
+Transport::ReceiveOptions::ReceiveOptions()
+  : bufferSize(8 * MAX_NDN_PACKET_SIZE)
+  , packetBudget(64)
+{
+}
+
 Transport::Transport()
   : m_ioService(nullptr)
   , m_isConnected(false)
@@ -50,4 +64,16 @@ Transport::connect(boost::asio::io_service& ioService,
   m_receiveCallback = receiveCallback;
 }
 
+void
+Transport::setReceiveOptions(const ReceiveOptions& options)
+{
+  if (options.bufferSize < MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("receive buffer must hold at least one packet"));
+  }
+  if (options.packetBudget == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("packet budget must be positive"));
+  }
+  m_receiveOptions = options;
+}
+
 } // namespace ndn
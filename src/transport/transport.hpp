@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -47,6 +47,42 @@ public:
   typedef function<void(const Block& wire)> ReceiveCallback;
   typedef function<void()> ErrorCallback;
 
+  /** \brief metrics of the send path of a Transport
+   */
+  class SendMetrics
+  {
+  public:
+    SendMetrics();
+
+  public:
+    size_t nQueuedPackets;  ///< number of packets in the send queue, including those being written
+    size_t nBytesInFlight;  ///< number of octets in the write operation in progress
+    uint64_t nWrites;       ///< number of write operations started
+    uint64_t nSentPackets;  ///< number of packets completely written
+  };
+
+  /** \brief options of the receive path of a Transport
+   */
+  class ReceiveOptions
+  {
+  public:
+    ReceiveOptions();
+
+  public:
+    /** \brief size of the receive buffer, in octets
+     *
+     *  Each read fills as much of the buffer as the socket has available, so that a burst of
+     *  small packets is received with few reads. Must be at least MAX_NDN_PACKET_SIZE.
+     */
+    size_t bufferSize;
+
+    /** \brief maximum number of packets delivered before yielding to other io_service handlers
+     *
+     *  Must be positive.
+     */
+    size_t packetBudget;
+  };
+
   Transport();
 
   virtual
@@ -106,6 +142,25 @@ public:
   bool
   isReceiving() const;
 
+  const SendMetrics&
+  getSendMetrics() const
+  {
+    return m_sendMetrics;
+  }
+
+  const ReceiveOptions&
+  getReceiveOptions() const
+  {
+    return m_receiveOptions;
+  }
+
+  /** \brief change the receive options
+   *  \note The new options take effect when the connection is (re-)established.
+   *  \throw std::invalid_argument options are invalid
+   */
+  void
+  setReceiveOptions(const ReceiveOptions& options);
+
 protected:
   /** \brief invoke the receive callback
    */
@@ -117,6 +172,8 @@ protected:
   bool m_isConnected;
   bool m_isReceiving;
   ReceiveCallback m_receiveCallback;
+  SendMetrics m_sendMetrics;
+  ReceiveOptions m_receiveOptions;
 };
 
 inline bool
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "content-encoding.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../encoding/buffer-stream.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+namespace ndn {
+namespace util {
+
+namespace bio = boost::iostreams;
+
+std::ostream&
+operator<<(std::ostream& os, ContentEncoding encoding)
+{
+  switch (encoding) {
+    case ContentEncoding::IDENTITY:
+      return os << "identity";
+    case ContentEncoding::DEFLATE:
+      return os << "deflate";
+  }
+  return os << static_cast<uint64_t>(encoding);
+}
+
+static void
+checkEncoding(ContentEncoding encoding)
+{
+  if (encoding != ContentEncoding::IDENTITY && encoding != ContentEncoding::DEFLATE) {
+    BOOST_THROW_EXCEPTION(ContentEncodingError("Unsupported content encoding " +
+                                               to_string(static_cast<uint64_t>(encoding))));
+  }
+}
+
+ConstBufferPtr
+encodeContent(ContentEncoding encoding, const uint8_t* buf, size_t size)
+{
+  checkEncoding(encoding);
+  if (encoding == ContentEncoding::IDENTITY) {
+    return make_shared<Buffer>(buf, size);
+  }
+
+  OBufferStream output;
+  {
+    bio::filtering_ostream os;
+    os.push(bio::zlib_compressor());
+    os.push(output);
+    os.write(reinterpret_cast<const char*>(buf), size);
+  } // the compressor is flushed when the stream is destroyed
+  return output.buf();
+}
+
+ConstBufferPtr
+decodeContent(ContentEncoding encoding, const uint8_t* buf, size_t size, size_t maxSize)
+{
+  checkEncoding(encoding);
+  if (encoding == ContentEncoding::IDENTITY) {
+    if (size > maxSize) {
+      BOOST_THROW_EXCEPTION(ContentEncodingError("Content exceeds the size limit"));
+    }
+    return make_shared<Buffer>(buf, size);
+  }
+
+  auto output = make_shared<Buffer>();
+  try {
+    bio::filtering_istream is;
+    is.push(bio::zlib_decompressor());
+    is.push(bio::array_source(reinterpret_cast<const char*>(buf), size));
+    // the stream is bad until the chain is complete
+    is.exceptions(std::ios::badbit);
+
+    // decompress in chunks, so that the size limit is enforced before memory is allocated
+    char chunk[8192];
+    while (is.read(chunk, sizeof(chunk)) || is.gcount() > 0) {
+      if (output->size() + is.gcount() > maxSize) {
+        BOOST_THROW_EXCEPTION(ContentEncodingError("Decoded content exceeds the size limit"));
+      }
+      output->insert(output->end(), chunk, chunk + is.gcount());
+    }
+  }
+  catch (const std::ios_base::failure& e) {
+    BOOST_THROW_EXCEPTION(ContentEncodingError(std::string("Cannot decode content (") +
+                                               e.what() + ")"));
+  }
+  return output;
+}
+
+ContentEncoding
+setEncodedContent(Data& data, const uint8_t* buf, size_t size, ContentEncoding encoding)
+{
+  MetaInfo metaInfo = data.getMetaInfo();
+  metaInfo.removeAppMetaInfo(CONTENT_ENCODING_TLV_TYPE);
+
+  ConstBufferPtr encoded;
+  if (encoding != ContentEncoding::IDENTITY) {
+    encoded = encodeContent(encoding, buf, size);
+  }
+
+  // the AppMetaInfo element costs up to 3 octets
+  if (encoded == nullptr || encoded->size() + 3 >= size) {
+    data.setMetaInfo(metaInfo);
+    data.setContent(buf, size);
+    return ContentEncoding::IDENTITY;
+  }
+
+  metaInfo.addAppMetaInfo(makeNonNegativeIntegerBlock(CONTENT_ENCODING_TLV_TYPE,
+                                                      static_cast<uint64_t>(encoding)));
+  data.setMetaInfo(metaInfo);
+  data.setContent(encoded);
+  return encoding;
+}
+
+ContentEncoding
+getContentEncoding(const Data& data)
+{
+  const Block* element = data.getMetaInfo().findAppMetaInfo(CONTENT_ENCODING_TLV_TYPE);
+  if (element == nullptr) {
+    return ContentEncoding::IDENTITY;
+  }
+
+  try {
+    return static_cast<ContentEncoding>(readNonNegativeInteger(*element));
+  }
+  catch (const tlv::Error&) {
+    BOOST_THROW_EXCEPTION(ContentEncodingError("Malformed content encoding element"));
+  }
+}
+
+Block
+getDecodedContent(const Data& data, size_t maxSize)
+{
+  ContentEncoding encoding = getContentEncoding(data);
+  if (encoding == ContentEncoding::IDENTITY) {
+    return data.getContent();
+  }
+
+  const Block& content = data.getContent();
+  ConstBufferPtr decoded = decodeContent(encoding, content.value(), content.value_size(), maxSize);
+  return Block(tlv::Content, decoded);
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_CONTENT_ENCODING_HPP
+#define NDN_UTIL_CONTENT_ENCODING_HPP
+
+#include "../data.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief TLV-TYPE of the AppMetaInfo element that indicates the encoding of Data content
+ *
+ * The element is a NonNegativeInteger holding a ContentEncoding value.  Data without this
+ * element carries its content verbatim.
+ */
+const uint32_t CONTENT_ENCODING_TLV_TYPE = 200;
+
+/**
+ * @brief Indicates how the Content of a Data packet is encoded
+ */
+enum class ContentEncoding : uint64_t {
+  IDENTITY = 0, ///< content is carried verbatim
+  DEFLATE = 1   ///< content is compressed in zlib format (RFC 1950)
+};
+
+std::ostream&
+operator<<(std::ostream& os, ContentEncoding encoding);
+
+/**
+ * @brief Indicates that content cannot be decoded
+ */
+class ContentEncodingError : public std::runtime_error
+{
+public:
+  explicit
+  ContentEncodingError(const std::string& what)
+    : std::runtime_error(what)
+  {
+  }
+};
+
+/**
+ * @brief Default limit on the size of decoded content, guarding against decompression bombs
+ */
+const size_t MAX_DECODED_CONTENT_SIZE = 64 * 1024 * 1024;
+
+/**
+ * @brief Compress a buffer
+ * @throw ContentEncodingError @p encoding is not supported
+ */
+ConstBufferPtr
+encodeContent(ContentEncoding encoding, const uint8_t* buf, size_t size);
+
+/**
+ * @brief Decompress a buffer
+ * @param maxSize maximum size of the decompressed buffer
+ * @throw ContentEncodingError @p encoding is not supported, the buffer is corrupted,
+ *                             or the decompressed size exceeds @p maxSize
+ */
+ConstBufferPtr
+decodeContent(ContentEncoding encoding, const uint8_t* buf, size_t size,
+              size_t maxSize = MAX_DECODED_CONTENT_SIZE);
+
+/**
+ * @brief Set the content of @p data, compressed with @p encoding
+ *
+ * The encoding is recorded in an AppMetaInfo element of type CONTENT_ENCODING_TLV_TYPE.  If
+ * compression does not reduce the size, the content is set verbatim and the element is omitted,
+ * so that consumers unaware of content encoding can still use the packet.
+ *
+ * This must be called before the packet is signed.
+ *
+ * @return the encoding that has been applied
+ */
+ContentEncoding
+setEncodedContent(Data& data, const uint8_t* buf, size_t size,
+                  ContentEncoding encoding = ContentEncoding::DEFLATE);
+
+/**
+ * @brief Get the content encoding of @p data
+ * @throw ContentEncodingError the AppMetaInfo element is malformed
+ */
+ContentEncoding
+getContentEncoding(const Data& data);
+
+/**
+ * @brief Get the decoded content of @p data
+ *
+ * This should be called after the packet has been validated, as the signature covers the
+ * encoded content.
+ *
+ * @return the Content element holding the decoded content; the Content element of @p data
+ *         itself if the content is not encoded
+ * @throw ContentEncodingError the content cannot be decoded
+ */
+Block
+getDecodedContent(const Data& data, size_t maxSize = MAX_DECODED_CONTENT_SIZE);
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_CONTENT_ENCODING_HPP
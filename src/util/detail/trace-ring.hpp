@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_DETAIL_TRACE_RING_HPP
+#define NDN_UTIL_DETAIL_TRACE_RING_HPP
+
+#include "../../common.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+/** @brief A single-producer single-consumer byte ring for binary trace records
+ *
+ *  The producer builds a record with a Writer and publishes it with commit(). A record that
+ *  does not fit into the free space is dropped as a whole. The consumer takes all published
+ *  bytes with consume(). Neither side blocks or takes a lock.
+ */
+class TraceRing : noncopyable
+{
+public:
+  class Writer
+  {
+  public:
+    void
+    write(const void* data, size_t size)
+    {
+      if (!m_isOk || size > m_limit - m_pos) {
+        m_isOk = false;
+        return;
+      }
+
+      size_t offset = static_cast<size_t>(m_pos) & m_ring.m_mask;
+      size_t firstPart = std::min(size, m_ring.m_mask + 1 - offset);
+      std::memcpy(m_ring.m_buffer.get() + offset, data, firstPart);
+      std::memcpy(m_ring.m_buffer.get(), reinterpret_cast<const uint8_t*>(data) + firstPart,
+                  size - firstPart);
+      m_pos += size;
+    }
+
+    template<typename T>
+    void
+    writeValue(T value)
+    {
+      static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+      write(&value, sizeof(value));
+    }
+
+  private:
+    Writer(TraceRing& ring, uint64_t pos, uint64_t limit)
+      : m_ring(ring)
+      , m_pos(pos)
+      , m_limit(limit)
+      , m_isOk(true)
+    {
+    }
+
+  private:
+    TraceRing& m_ring;
+    uint64_t m_pos;
+    uint64_t m_limit;
+    bool m_isOk;
+
+    friend TraceRing;
+  };
+
+  /** @param capacity ring size in octets, must be a power of two
+   */
+  explicit
+  TraceRing(size_t capacity)
+    : m_buffer(new uint8_t[capacity])
+    , m_mask(capacity - 1)
+    , m_head(0)
+    , m_tail(0)
+    , m_nDropped(0)
+  {
+    BOOST_ASSERT(capacity > 0 && (capacity & m_mask) == 0);
+  }
+
+  /** @brief start a record (producer)
+   */
+  Writer
+  startRecord()
+  {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    uint64_t tail = m_tail.load(std::memory_order_acquire);
+    return Writer(*this, head, tail + m_mask + 1);
+  }
+
+  /** @brief publish the record built by @p writer, or drop it if it did not fit (producer)
+   */
+  void
+  commit(const Writer& writer)
+  {
+    if (writer.m_isOk) {
+      m_head.store(writer.m_pos, std::memory_order_release);
+    }
+    else {
+      // only the producer modifies the counter
+      m_nDropped.store(m_nDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  }
+
+  /** @brief append all published octets to @p output and release them (consumer)
+   */
+  void
+  consume(std::vector<uint8_t>& output)
+  {
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    size_t size = static_cast<size_t>(head - tail);
+    size_t offset = static_cast<size_t>(tail) & m_mask;
+    size_t firstPart = std::min(size, m_mask + 1 - offset);
+    output.insert(output.end(), m_buffer.get() + offset, m_buffer.get() + offset + firstPart);
+    output.insert(output.end(), m_buffer.get(), m_buffer.get() + (size - firstPart));
+    m_tail.store(head, std::memory_order_release);
+  }
+
+  /** @brief release all published octets without reading them (consumer)
+   */
+  void
+  discard()
+  {
+    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  /** @return number of records dropped because the ring was full
+   */
+  uint64_t
+  getNDropped() const
+  {
+    return m_nDropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  unique_ptr<uint8_t[]> m_buffer;
+  const size_t m_mask;
+
+  std::atomic<uint64_t> m_head; ///< end of published octets, written by the producer
+  char m_padding[64]; ///< keeps m_head and m_tail in different cache lines
+  std::atomic<uint64_t> m_tail; ///< end of consumed octets, written by the consumer
+  std::atomic<uint64_t> m_nDropped;
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DETAIL_TRACE_RING_HPP
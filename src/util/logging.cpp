@@ -21,6 +21,7 @@
 
 #include "logging.hpp"
 #include "logger.hpp"
+#include "trace.hpp"
 
 #include <boost/log/expressions.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -28,6 +29,7 @@
 #include <boost/range/iterator_range.hpp>
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -58,6 +60,14 @@ Logging::Logging()
   if (environ != nullptr) {
     this->setLevelImpl(environ);
   }
+
+  const char* traceFile = std::getenv("NDN_LOG_TRACE_FILE");
+  if (traceFile != nullptr) {
+    auto os = make_shared<std::ofstream>(traceFile, std::ios::binary | std::ios::trunc);
+    if (*os) {
+      Trace::enable(std::move(os));
+    }
+  }
 }
 
 void
@@ -0,0 +1,652 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "regex-automaton.hpp"
+
+#include <map>
+
+namespace ndn {
+
+/**
+ * @brief Upper bound of the number of states, e.g., when expanding bounded repetitions
+ */
+static const size_t MAX_STATES = 4096;
+
+static const size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief Parses an expression in the same way as the RegexMatcher tree, and builds the automaton
+ *
+ * Parsing mirrors RegexPatternListMatcher, RegexRepeatMatcher, and RegexComponentSetMatcher.
+ * Because the expression has already been compiled by those matchers, a construct that does not
+ * parse here is reported as unsupported rather than as an error.
+ */
+class RegexAutomaton::Compiler
+{
+public:
+  class Unsupported
+  {
+  };
+
+  explicit
+  Compiler(RegexAutomaton& automaton)
+    : m_automaton(automaton)
+  {
+  }
+
+  void
+  compile(const std::vector<std::string>& patternLists)
+  {
+    if (patternLists.size() == 1) {
+      Fragment fragment = build(parsePatternList(patternLists.front()));
+      m_automaton.m_start = fragment.first;
+      m_automaton.m_accepts.push_back(fragment.second);
+    }
+    else {
+      m_automaton.m_start = addState();
+      for (const auto& patternList : patternLists) {
+        Fragment fragment = build(parsePatternList(patternList));
+        m_epsilons[m_automaton.m_start].push_back(fragment.first);
+        m_automaton.m_accepts.push_back(fragment.second);
+      }
+    }
+    computeClosures();
+  }
+
+private:
+  struct Node
+  {
+    enum Kind {
+      SEQUENCE,
+      COMPONENT,
+      REPEAT
+    };
+
+    Kind kind;
+    std::vector<Node> children;
+    int predicate = -1;
+    size_t min = 1;
+    size_t max = 1;
+    bool isNullable = false;
+  };
+
+  /// start and end state
+  using Fragment = std::pair<size_t, size_t>;
+
+  Node
+  parsePatternList(const std::string& expr)
+  {
+    Node sequence;
+    sequence.kind = Node::SEQUENCE;
+    sequence.isNullable = true;
+
+    size_t index = 0;
+    while (index < expr.size()) {
+      Node item = parseItem(expr, index);
+      sequence.isNullable = sequence.isNullable && item.isNullable;
+      sequence.children.push_back(std::move(item));
+    }
+    return sequence;
+  }
+
+  Node
+  parseItem(const std::string& expr, size_t& index)
+  {
+    size_t start = index;
+    Node atom;
+    switch (expr[index]) {
+      case '(': {
+        index = findClosing(expr, '(', ')', index + 1);
+        atom = parsePatternList(expr.substr(start + 1, index - start - 2));
+        m_automaton.m_hasBackrefs = true;
+        break;
+      }
+      case '<':
+      case '[': {
+        index = findClosing(expr, expr[start], expr[start] == '<' ? '>' : ']', index + 1);
+        atom.kind = Node::COMPONENT;
+        atom.predicate = getPredicate(expr.substr(start, index - start));
+        break;
+      }
+      default:
+        throw Unsupported();
+    }
+
+    size_t min = 1;
+    size_t max = 1;
+    if (index < expr.size()) {
+      switch (expr[index]) {
+        case '?':
+          min = 0;
+          ++index;
+          break;
+        case '*':
+          min = 0;
+          max = UNBOUNDED;
+          ++index;
+          break;
+        case '+':
+          max = UNBOUNDED;
+          ++index;
+          break;
+        case '{':
+          std::tie(min, max) = parseRepetition(expr, index);
+          break;
+      }
+    }
+
+    if (expr[start] == '(' && min == 1 && max == 1) {
+      // a parenthesized sub-pattern without repetition is a RegexBackrefMatcher
+      return atom;
+    }
+
+    // RegexRepeatMatcher never matches zero components when its minimum is positive,
+    // even if the repeated pattern matches zero components
+    if (min > 0 && atom.isNullable) {
+      throw Unsupported();
+    }
+
+    Node repeat;
+    repeat.kind = Node::REPEAT;
+    repeat.min = min;
+    repeat.max = max;
+    repeat.isNullable = min == 0;
+    repeat.children.push_back(std::move(atom));
+    return repeat;
+  }
+
+  static size_t
+  findClosing(const std::string& expr, char left, char right, size_t index)
+  {
+    size_t depth = 1;
+    for (; index < expr.size() && depth > 0; ++index) {
+      if (expr[index] == left) {
+        ++depth;
+      }
+      else if (expr[index] == right) {
+        --depth;
+      }
+    }
+    if (depth > 0) {
+      throw Unsupported();
+    }
+    return index;
+  }
+
+  static std::pair<size_t, size_t>
+  parseRepetition(const std::string& expr, size_t& index)
+  {
+    size_t end = expr.find('}', index);
+    if (end == std::string::npos) {
+      throw Unsupported();
+    }
+    std::string body = expr.substr(index + 1, end - index - 1);
+    index = end + 1;
+
+    auto parseNumber = [] (const std::string& str) -> size_t {
+      if (str.empty() || str.size() > 9 ||
+          str.find_first_not_of("0123456789") != std::string::npos) {
+        throw Unsupported();
+      }
+      return std::stoul(str);
+    };
+
+    size_t comma = body.find(',');
+    if (comma == std::string::npos) {
+      size_t n = parseNumber(body);
+      return {n, n};
+    }
+    size_t min = comma == 0 ? 0 : parseNumber(body.substr(0, comma));
+    size_t max = comma + 1 == body.size() ? UNBOUNDED : parseNumber(body.substr(comma + 1));
+    if (min > max) {
+      throw Unsupported();
+    }
+    return {min, max};
+  }
+
+  /**
+   * @brief Get the predicate of a component set expression, i.e., "<...>" or "[...]"
+   */
+  int
+  getPredicate(const std::string& setExpr)
+  {
+    auto it = m_predicateIndex.find(setExpr);
+    if (it != m_predicateIndex.end()) {
+      return it->second;
+    }
+
+    Predicate predicate;
+    predicate.isNegated = false;
+    if (setExpr[0] == '<') {
+      predicate.tests.push_back(makeTest(setExpr.substr(1, setExpr.size() - 2)));
+    }
+    else {
+      size_t index = 1;
+      size_t last = setExpr.size() - 1;
+      if (setExpr[index] == '^') {
+        predicate.isNegated = true;
+        ++index;
+      }
+      while (index < last) {
+        if (setExpr[index] != '<') {
+          throw Unsupported();
+        }
+        size_t end = findClosing(setExpr, '<', '>', index + 1);
+        predicate.tests.push_back(makeTest(setExpr.substr(index + 1, end - index - 2)));
+        index = end;
+      }
+    }
+
+    m_automaton.m_predicates.push_back(std::move(predicate));
+    int id = static_cast<int>(m_automaton.m_predicates.size() - 1);
+    m_predicateIndex[setExpr] = id;
+    return id;
+  }
+
+  /**
+   * @brief Create the test of a component expression, i.e., the content between '<' and '>'
+   */
+  ComponentTest
+  makeTest(const std::string& expr)
+  {
+    ComponentTest test;
+    test.kind = ComponentTest::REGEX;
+    try {
+      test.regex = boost::regex(expr);
+    }
+    catch (const boost::regex_error&) {
+      throw Unsupported();
+    }
+    if (test.regex.mark_count() > 0) {
+      m_automaton.m_hasBackrefs = true;
+    }
+
+    // the URI representation of a name component is never empty
+    if (expr.empty() || expr == ".*" || expr == ".+") {
+      test.kind = ComponentTest::ANY;
+      return test;
+    }
+
+    std::string literal;
+    if (!unescapeLiteral(expr, literal)) {
+      return test;
+    }
+    try {
+      name::Component component = name::Component::fromEscapedString(literal);
+      // the URI representation is unique, so comparing components is equivalent to comparing
+      // URIs, as long as the literal is the URI representation of the component
+      if (component.toUri() == literal) {
+        test.kind = ComponentTest::LITERAL;
+        test.literal = std::move(component);
+      }
+    }
+    catch (const name::Component::Error&) {
+    }
+    return test;
+  }
+
+  /**
+   * @brief Convert a regular expression without metacharacters into the string it matches
+   */
+  static bool
+  unescapeLiteral(const std::string& expr, std::string& literal)
+  {
+    static const std::string METACHARACTERS = ".[]{}()\\*+?|^$";
+    for (size_t i = 0; i < expr.size(); ++i) {
+      char c = expr[i];
+      if (c == '\\') {
+        if (++i == expr.size() || METACHARACTERS.find(expr[i]) == std::string::npos) {
+          // an escape sequence such as \d denotes a character class
+          return false;
+        }
+        literal.push_back(expr[i]);
+      }
+      else if (METACHARACTERS.find(c) != std::string::npos) {
+        return false;
+      }
+      else {
+        literal.push_back(c);
+      }
+    }
+    return true;
+  }
+
+  size_t
+  addState()
+  {
+    if (m_automaton.m_states.size() >= MAX_STATES) {
+      throw Unsupported();
+    }
+    m_automaton.m_states.emplace_back();
+    m_epsilons.emplace_back();
+    return m_automaton.m_states.size() - 1;
+  }
+
+  Fragment
+  build(const Node& node)
+  {
+    switch (node.kind) {
+      case Node::COMPONENT: {
+        size_t start = addState();
+        size_t end = addState();
+        m_automaton.m_states[start].predicate = node.predicate;
+        m_automaton.m_states[start].next = end;
+        return {start, end};
+      }
+      case Node::SEQUENCE: {
+        size_t start = addState();
+        size_t end = start;
+        for (const Node& child : node.children) {
+          Fragment fragment = build(child);
+          m_epsilons[end].push_back(fragment.first);
+          end = fragment.second;
+        }
+        return {start, end};
+      }
+      case Node::REPEAT: {
+        const Node& child = node.children.front();
+        size_t start = addState();
+        size_t end = start;
+        for (size_t i = 0; i < node.min; ++i) {
+          Fragment fragment = build(child);
+          m_epsilons[end].push_back(fragment.first);
+          end = fragment.second;
+        }
+
+        if (node.max == UNBOUNDED) {
+          size_t loop = addState();
+          m_epsilons[end].push_back(loop);
+          Fragment fragment = build(child);
+          m_epsilons[loop].push_back(fragment.first);
+          m_epsilons[fragment.second].push_back(loop);
+          return {start, loop};
+        }
+
+        std::vector<size_t> skips;
+        for (size_t i = node.min; i < node.max; ++i) {
+          Fragment fragment = build(child);
+          skips.push_back(end);
+          m_epsilons[end].push_back(fragment.first);
+          end = fragment.second;
+        }
+        for (size_t skip : skips) {
+          m_epsilons[skip].push_back(end);
+        }
+        return {start, end};
+      }
+    }
+    throw Unsupported();
+  }
+
+  void
+  computeClosures()
+  {
+    size_t nStates = m_automaton.m_states.size();
+    m_automaton.m_nWords = (nStates + 63) / 64;
+    m_automaton.m_closures.assign(nStates, StateSet(m_automaton.m_nWords, 0));
+
+    for (size_t state = 0; state < nStates; ++state) {
+      StateSet& closure = m_automaton.m_closures[state];
+      std::vector<size_t> stack{state};
+      while (!stack.empty()) {
+        size_t s = stack.back();
+        stack.pop_back();
+        uint64_t bit = uint64_t(1) << (s % 64);
+        if (closure[s / 64] & bit) {
+          continue;
+        }
+        closure[s / 64] |= bit;
+        stack.insert(stack.end(), m_epsilons[s].begin(), m_epsilons[s].end());
+      }
+    }
+  }
+
+private:
+  RegexAutomaton& m_automaton;
+  std::vector<std::vector<size_t>> m_epsilons;
+  std::map<std::string, int> m_predicateIndex;
+};
+
+constexpr size_t RegexAutomaton::NO_MATCH;
+
+RegexAutomaton::RegexAutomaton()
+  : m_nWords(0)
+  , m_start(0)
+  , m_hasBackrefs(false)
+{
+}
+
+/**
+ * @brief Convert a top-level expression into a pattern list, as RegexTopMatcher::compile does
+ *
+ * The secondary matcher, used when the expression is not anchored at the beginning, accepts
+ * a superset of the primary matcher, so only the former is needed to decide a match.
+ */
+static bool
+makePatternList(const std::string& expr, std::string& pattern)
+{
+  if (expr.empty()) {
+    return false;
+  }
+
+  pattern = expr;
+  if (pattern.back() != '$') {
+    pattern += "<.*>*";
+  }
+  else {
+    pattern.pop_back();
+  }
+
+  if (pattern.empty()) {
+    return false;
+  }
+  if (pattern.front() != '^') {
+    pattern = "<.*>*" + pattern;
+  }
+  else {
+    pattern.erase(0, 1);
+  }
+  return true;
+}
+
+shared_ptr<const RegexAutomaton>
+RegexAutomaton::compileTop(const std::string& expr)
+{
+  std::string pattern;
+  if (!makePatternList(expr, pattern)) {
+    return nullptr;
+  }
+  return compilePatternList(pattern);
+}
+
+shared_ptr<const RegexAutomaton>
+RegexAutomaton::compilePatternList(const std::string& expr)
+{
+  shared_ptr<RegexAutomaton> automaton(new RegexAutomaton);
+  try {
+    Compiler(*automaton).compile({expr});
+  }
+  catch (const Compiler::Unsupported&) {
+    return nullptr;
+  }
+  return automaton;
+}
+
+shared_ptr<const RegexAutomaton>
+RegexAutomaton::compileUnion(const std::vector<std::string>& exprs)
+{
+  if (exprs.empty()) {
+    return nullptr;
+  }
+
+  std::vector<std::string> patterns(exprs.size());
+  for (size_t i = 0; i < exprs.size(); ++i) {
+    if (!makePatternList(exprs[i], patterns[i])) {
+      return nullptr;
+    }
+  }
+
+  shared_ptr<RegexAutomaton> automaton(new RegexAutomaton);
+  try {
+    Compiler(*automaton).compile(patterns);
+  }
+  catch (const Compiler::Unsupported&) {
+    return nullptr;
+  }
+  return automaton;
+}
+
+bool
+RegexAutomaton::evaluate(const Predicate& predicate, const name::Component& component) const
+{
+  bool isMatched = false;
+  for (const ComponentTest& test : predicate.tests) {
+    switch (test.kind) {
+      case ComponentTest::ANY:
+        isMatched = true;
+        break;
+      case ComponentTest::LITERAL:
+        isMatched = component == test.literal;
+        break;
+      case ComponentTest::REGEX:
+        isMatched = boost::regex_match(component.toUri(), test.regex);
+        break;
+    }
+    if (isMatched) {
+      break;
+    }
+  }
+  return isMatched != predicate.isNegated;
+}
+
+Name
+RegexAutomaton::getRequiredPrefix() const
+{
+  Name prefix;
+  StateSet current = m_closures[m_start];
+  // every component of the prefix consumes at least one state, so the loop is bounded
+  while (prefix.size() < m_states.size()) {
+    for (size_t accept : m_accepts) {
+      if ((current[accept / 64] >> (accept % 64)) & 1) {
+        return prefix;
+      }
+    }
+
+    // all reached states must have the same predicate, which tests a single literal
+    int predicate = -1;
+    for (size_t w = 0; w < m_nWords; ++w) {
+      for (uint64_t bits = current[w]; bits != 0; bits &= bits - 1) {
+        int p = m_states[w * 64 + __builtin_ctzll(bits)].predicate;
+        if (p >= 0 && predicate >= 0 && p != predicate) {
+          return prefix;
+        }
+        predicate = std::max(predicate, p);
+      }
+    }
+    if (predicate < 0 || m_predicates[predicate].isNegated ||
+        m_predicates[predicate].tests.size() != 1 ||
+        m_predicates[predicate].tests.front().kind != ComponentTest::LITERAL) {
+      return prefix;
+    }
+    prefix.append(m_predicates[predicate].tests.front().literal);
+
+    StateSet next(m_nWords);
+    for (size_t w = 0; w < m_nWords; ++w) {
+      for (uint64_t bits = current[w]; bits != 0; bits &= bits - 1) {
+        const State& state = m_states[w * 64 + __builtin_ctzll(bits)];
+        if (state.predicate >= 0) {
+          for (size_t v = 0; v < m_nWords; ++v) {
+            next[v] |= m_closures[state.next][v];
+          }
+        }
+      }
+    }
+    current.swap(next);
+  }
+  return prefix;
+}
+
+bool
+RegexAutomaton::simulate(const Name& name, size_t offset, size_t len, StateSet& current) const
+{
+  current = m_closures[m_start];
+  StateSet next(m_nWords);
+  // result of each predicate for the current component: 0 if not evaluated, 1 if true, -1 if false
+  std::vector<int8_t> results(m_predicates.size());
+
+  for (size_t i = offset; i < offset + len; ++i) {
+    const name::Component& component = name[i];
+    std::fill(next.begin(), next.end(), 0);
+    std::fill(results.begin(), results.end(), 0);
+    bool isAlive = false;
+
+    for (size_t w = 0; w < m_nWords; ++w) {
+      for (uint64_t bits = current[w]; bits != 0; bits &= bits - 1) {
+        const State& state = m_states[w * 64 + __builtin_ctzll(bits)];
+        if (state.predicate < 0) {
+          continue;
+        }
+        int8_t& result = results[state.predicate];
+        if (result == 0) {
+          result = evaluate(m_predicates[state.predicate], component) ? 1 : -1;
+        }
+        if (result < 0) {
+          continue;
+        }
+        const StateSet& closure = m_closures[state.next];
+        for (size_t v = 0; v < m_nWords; ++v) {
+          next[v] |= closure[v];
+        }
+        isAlive = true;
+      }
+    }
+
+    if (!isAlive) {
+      return false;
+    }
+    current.swap(next);
+  }
+  return true;
+}
+
+bool
+RegexAutomaton::match(const Name& name, size_t offset, size_t len) const
+{
+  return findFirst(name, offset, len) != NO_MATCH;
+}
+
+size_t
+RegexAutomaton::findFirst(const Name& name, size_t offset, size_t len) const
+{
+  StateSet current;
+  if (!simulate(name, offset, len, current)) {
+    return NO_MATCH;
+  }
+
+  for (size_t i = 0; i < m_accepts.size(); ++i) {
+    if ((current[m_accepts[i] / 64] >> (m_accepts[i] % 64)) & 1) {
+      return i;
+    }
+  }
+  return NO_MATCH;
+}
+
+} // namespace ndn
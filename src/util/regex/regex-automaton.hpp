@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+#define NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+
+#include "../../name.hpp"
+
+#include <boost/regex.hpp>
+
+#include <limits>
+
+namespace ndn {
+
+/**
+ * @brief A compiled NDN regular expression that decides whether a name matches
+ *
+ * The expression is lowered into a nondeterministic finite automaton whose transitions consume
+ * one name component each and are labeled with component predicates.  A predicate that only
+ * tests a literal component compares the TLV-TYPE and TLV-VALUE directly; a predicate that
+ * accepts any component does no work; only a predicate with a general regular expression
+ * converts the component to its URI representation.  Matching simulates the automaton over
+ * state sets, so its cost is linear in the name length, without the backtracking performed by
+ * the RegexMatcher tree.
+ *
+ * The automaton does not record back references.  RegexTopMatcher uses it to reject names and
+ * to accept names for expressions without back references, and falls back to the RegexMatcher
+ * tree to capture back references.
+ */
+class RegexAutomaton : noncopyable
+{
+public:
+  /**
+   * @brief Compile a top-level expression, as accepted by RegexTopMatcher
+   * @return the automaton, or nullptr if the expression uses a construct whose semantics
+   *         in the RegexMatcher tree the automaton does not reproduce
+   * @pre the expression has been successfully compiled by RegexTopMatcher
+   */
+  static shared_ptr<const RegexAutomaton>
+  compileTop(const std::string& expr);
+
+  /**
+   * @brief Compile a pattern list, as accepted by RegexPatternListMatcher
+   * @return the automaton, or nullptr as in compileTop()
+   */
+  static shared_ptr<const RegexAutomaton>
+  compilePatternList(const std::string& expr);
+
+  /**
+   * @brief Compile the union of top-level expressions into a single automaton
+   *
+   * Identical component predicates are shared among the expressions, so that each of them is
+   * evaluated at most once per component regardless of how many expressions use it.
+   *
+   * @return the automaton, or nullptr if any expression is unsupported as in compileTop(),
+   *         or the union is too large
+   */
+  static shared_ptr<const RegexAutomaton>
+  compileUnion(const std::vector<std::string>& exprs);
+
+  /**
+   * @brief Check whether components [offset, offset + len) of @p name match the expression
+   */
+  bool
+  match(const Name& name, size_t offset, size_t len) const;
+
+  bool
+  match(const Name& name) const
+  {
+    return match(name, 0, name.size());
+  }
+
+  /**
+   * @brief Find the first expression matching components [offset, offset + len) of @p name
+   * @return index of the expression in the order given to compileUnion(), or NO_MATCH
+   */
+  size_t
+  findFirst(const Name& name, size_t offset, size_t len) const;
+
+  size_t
+  findFirst(const Name& name) const
+  {
+    return findFirst(name, 0, name.size());
+  }
+
+  static constexpr size_t NO_MATCH = std::numeric_limits<size_t>::max();
+
+  /**
+   * @return whether the expression has back references, i.e., parenthesized sub-patterns or
+   *         marked sub-expressions in a component expression
+   */
+  bool
+  hasBackrefs() const
+  {
+    return m_hasBackrefs;
+  }
+
+  /**
+   * @brief Get the components that every matching name starts with
+   *
+   * For example, the required prefix of "^<ndn><edu>[^<KEY>]*<KEY>$" is "/ndn/edu".
+   */
+  Name
+  getRequiredPrefix() const;
+
+  size_t
+  getNStates() const
+  {
+    return m_states.size();
+  }
+
+private:
+  RegexAutomaton();
+
+  class Compiler;
+
+  /**
+   * @brief Tests a single name component
+   */
+  struct ComponentTest
+  {
+    enum Kind {
+      ANY,     ///< matches any component
+      LITERAL, ///< matches the component equal to literal
+      REGEX    ///< matches a component whose URI representation matches regex
+    };
+
+    Kind kind;
+    name::Component literal;
+    boost::regex regex;
+  };
+
+  /**
+   * @brief A set of component tests, true if any test is true, or none if negated
+   */
+  struct Predicate
+  {
+    std::vector<ComponentTest> tests;
+    bool isNegated;
+  };
+
+  struct State
+  {
+    int predicate = -1; ///< index into m_predicates, or -1 if the state has no transition
+    size_t next = 0;    ///< target state of the transition
+  };
+
+  using StateSet = std::vector<uint64_t>;
+
+  bool
+  evaluate(const Predicate& predicate, const name::Component& component) const;
+
+  /**
+   * @brief Run the automaton over components [offset, offset + len) of @p name
+   *
+   * The predicate of each reached state is evaluated at most once per component.
+   *
+   * @param[out] current the reached states
+   * @return false if no state is reached
+   */
+  bool
+  simulate(const Name& name, size_t offset, size_t len, StateSet& current) const;
+
+private:
+  std::vector<Predicate> m_predicates;
+  std::vector<State> m_states;
+  std::vector<StateSet> m_closures;         ///< epsilon closure of each state
+  size_t m_nWords;                          ///< number of 64-bit words in a StateSet
+  size_t m_start;
+  std::vector<size_t> m_accepts;            ///< accept state of each expression
+  bool m_hasBackrefs;
+};
+
+} // namespace ndn
+
+#endif // NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
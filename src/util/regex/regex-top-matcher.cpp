@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -59,6 +59,8 @@ RegexTopMatcher::compile()
   }
 
   m_primaryMatcher = make_shared<RegexPatternListMatcher>(expr, m_primaryBackrefManager);
+
+  m_automaton = RegexAutomaton::compileTop(m_expr);
 }
 
 bool
@@ -68,6 +70,17 @@ RegexTopMatcher::match(const Name& name)
 
   m_matchResult.clear();
 
+  if (m_automaton != nullptr) {
+    if (!m_automaton->match(name)) {
+      return false;
+    }
+    if (!m_automaton->hasBackrefs()) {
+      // without back references, both matchers would capture the whole name
+      m_matchResult.assign(name.begin(), name.end());
+      return true;
+    }
+  }
+
   if (m_primaryMatcher->match(name, 0, name.size())) {
     m_matchResult = m_primaryMatcher->getMatchResult();
     return true;
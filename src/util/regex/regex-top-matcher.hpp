@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -25,6 +25,7 @@
 #define NDN_UTIL_REGEX_REGEX_TOP_MATCHER_HPP
 
 #include "regex-matcher.hpp"
+#include "regex-automaton.hpp"
 
 namespace ndn {
 
@@ -67,6 +68,8 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   shared_ptr<RegexBackrefManager> m_primaryBackrefManager;
   shared_ptr<RegexBackrefManager> m_secondaryBackrefManager;
   bool m_isSecondaryUsed;
+  /// decides whether a name matches, nullptr if the expression is not supported by the automaton
+  shared_ptr<const RegexAutomaton> m_automaton;
 };
 
 } // namespace ndn
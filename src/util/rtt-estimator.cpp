@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "rtt-estimator.hpp"
+
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+RttEstimator::Options::Options()
+  : alpha(0.125)
+  , beta(0.25)
+  , k(4)
+  , initialRto(1_s)
+  , minRto(200_ms)
+  , maxRto(1_min)
+  , rtoBackoffMultiplier(2)
+{
+}
+
+RttEstimator::RttEstimator(const Options& options)
+  : m_options(options)
+  , m_sRtt(-1)
+  , m_rttVar(0)
+  , m_rto(options.initialRto)
+{
+  BOOST_ASSERT(m_options.alpha > 0 && m_options.alpha <= 1);
+  BOOST_ASSERT(m_options.beta > 0 && m_options.beta <= 1);
+  BOOST_ASSERT(m_options.minRto <= m_options.maxRto);
+}
+
+void
+RttEstimator::addMeasurement(time::nanoseconds rtt, size_t nExpectedSamples)
+{
+  BOOST_ASSERT(nExpectedSamples > 0);
+
+  if (m_sRtt < time::nanoseconds::zero()) {
+    m_sRtt = rtt;
+    m_rttVar = rtt / 2;
+  }
+  else {
+    double alpha = m_options.alpha / nExpectedSamples;
+    double beta = m_options.beta / nExpectedSamples;
+    auto diff = time::nanoseconds(std::abs((m_sRtt - rtt).count()));
+    m_rttVar = time::duration_cast<time::nanoseconds>((1 - beta) * m_rttVar + beta * diff);
+    m_sRtt = time::duration_cast<time::nanoseconds>((1 - alpha) * m_sRtt + alpha * rtt);
+  }
+
+  m_rto = m_sRtt + m_options.k * m_rttVar;
+  m_rto = std::max(m_rto, m_options.minRto);
+  m_rto = std::min(m_rto, m_options.maxRto);
+}
+
+void
+RttEstimator::backoffRto()
+{
+  m_rto = std::min(m_rto * m_options.rtoBackoffMultiplier, m_options.maxRto);
+}
+
+} // namespace util
+} // namespace ndn
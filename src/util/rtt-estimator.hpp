@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_RTT_ESTIMATOR_HPP
+#define NDN_UTIL_RTT_ESTIMATOR_HPP
+
+#include "time.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief RTT estimator and retransmission timeout calculator
+ *
+ * The smoothed RTT, RTT variation, and RTO are computed as in RFC 6298, with the gains divided
+ * by the number of samples expected within one RTT, so that a window of measurements has the
+ * same weight as one measurement in a stop-and-wait exchange.
+ */
+class RttEstimator
+{
+public:
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    double alpha;                  ///< weight of the exponential moving average of RTT
+    double beta;                   ///< weight of the exponential moving average of RTT variation
+    int k;                         ///< RTT variation multiplier in RTO calculation
+    time::nanoseconds initialRto;  ///< RTO before the first measurement
+    time::nanoseconds minRto;      ///< lower bound of RTO
+    time::nanoseconds maxRto;      ///< upper bound of RTO
+    int rtoBackoffMultiplier;      ///< RTO multiplier applied by backoffRto()
+  };
+
+  explicit
+  RttEstimator(const Options& options = Options());
+
+  /**
+   * @brief record a new RTT measurement
+   * @param rtt the sampled RTT
+   * @param nExpectedSamples number of measurements expected to be taken during one RTT,
+   *                         e.g., the number of packets in flight; must be positive
+   */
+  void
+  addMeasurement(time::nanoseconds rtt, size_t nExpectedSamples);
+
+  /**
+   * @brief multiply the RTO by the backoff multiplier, up to the maximum RTO
+   *
+   * This should be invoked after a retransmission timer expires.
+   */
+  void
+  backoffRto();
+
+  /**
+   * @return the current retransmission timeout
+   */
+  time::nanoseconds
+  getEstimatedRto() const
+  {
+    return m_rto;
+  }
+
+  /**
+   * @return the smoothed RTT, or a negative value if no measurement has been taken
+   */
+  time::nanoseconds
+  getSmoothedRtt() const
+  {
+    return m_sRtt;
+  }
+
+  /**
+   * @return the RTT variation
+   */
+  time::nanoseconds
+  getRttVariation() const
+  {
+    return m_rttVar;
+  }
+
+private:
+  const Options m_options;
+  time::nanoseconds m_sRtt;
+  time::nanoseconds m_rttVar;
+  time::nanoseconds m_rto;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_RTT_ESTIMATOR_HPP
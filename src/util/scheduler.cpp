@@ -24,6 +24,9 @@
 
 #include <boost/scope_exit.hpp>
 
+#include <array>
+#include <limits>
+
 namespace ndn {
 namespace util {
 namespace scheduler {
@@ -48,7 +51,16 @@ public:
   time::steady_clock::TimePoint expireTime;
   bool isExpired;
   EventCallback callback;
+
+  // used by OrderedEventQueue
   EventQueue::const_iterator queueIt;
+
+  // used by TimerWheel
+  shared_ptr<EventInfo> self; ///< keeps the event alive while it is linked into a slot
+  EventInfo* prev = nullptr;
+  EventInfo* next = nullptr;
+  uint64_t tick = 0;
+  size_t slot = 0;
 };
 
 EventId::operator bool() const
@@ -75,8 +87,361 @@ EventQueueCompare::operator()(const shared_ptr<EventInfo>& a, const shared_ptr<E
   return a->expireTime < b->expireTime;
 }
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+std::ostream&
+operator<<(std::ostream& os, EventQueueType type)
+{
+  switch (type) {
+    case EventQueueType::ORDERED_SET:
+      return os << "ordered-set";
+    case EventQueueType::TIMER_WHEEL:
+      return os << "timer-wheel";
+  }
+  return os << static_cast<int>(type);
+}
+
+class EventQueueBackend : noncopyable
+{
+public:
+  virtual
+  ~EventQueueBackend() = default;
+
+  virtual bool
+  empty() const = 0;
+
+  /** \brief get the earliest time at which a pending event may become due
+   *  \pre !empty()
+   */
+  virtual time::steady_clock::TimePoint
+  getNextDeadline() const = 0;
+
+  virtual void
+  insert(shared_ptr<EventInfo> info) = 0;
+
+  /** \pre \p info is pending in this queue
+   */
+  virtual void
+  erase(EventInfo& info) = 0;
+
+  virtual void
+  clear() = 0;
+
+  /** \brief dequeue an event that is due at \p now
+   *  \return the event, or nullptr if no event is due
+   */
+  virtual shared_ptr<EventInfo>
+  popExpired(time::steady_clock::TimePoint now) = 0;
+};
+
+class OrderedEventQueue : public EventQueueBackend
+{
+public:
+  bool
+  empty() const final
+  {
+    return m_queue.empty();
+  }
+
+  time::steady_clock::TimePoint
+  getNextDeadline() const final
+  {
+    return (*m_queue.begin())->expireTime;
+  }
+
+  void
+  insert(shared_ptr<EventInfo> info) final
+  {
+    EventQueue::iterator i = m_queue.insert(std::move(info));
+    (*i)->queueIt = i;
+  }
+
+  void
+  erase(EventInfo& info) final
+  {
+    m_queue.erase(info.queueIt);
+  }
+
+  void
+  clear() final
+  {
+    m_queue.clear();
+  }
+
+  shared_ptr<EventInfo>
+  popExpired(time::steady_clock::TimePoint now) final
+  {
+    if (m_queue.empty() || (*m_queue.begin())->expireTime > now) {
+      return nullptr;
+    }
+
+    shared_ptr<EventInfo> info = *m_queue.begin();
+    m_queue.erase(m_queue.begin());
+    return info;
+  }
+
+private:
+  EventQueue m_queue;
+};
+
+/** \brief hierarchical timing wheel
+ *
+ *  There are N_LEVELS levels of N_SLOTS slots each. A slot on level L covers N_SLOTS^L ticks,
+ *  so that the wheel spans N_SLOTS^N_LEVELS ticks (2^32 ms, or 49.7 days). An event is placed on
+ *  the lowest level where its tick is less than N_SLOTS slots ahead of the current tick. When the
+ *  current tick reaches the start of a slot on a higher level, that slot is cascaded, i.e., its
+ *  events are re-inserted and thus move to lower levels. Events beyond the span of the wheel are
+ *  parked in the farthest slot of the top level, and re-inserted when it is cascaded.
+ *
+ *  Each slot is an intrusive doubly linked list of EventInfo, and a bitmap of non-empty slots
+ *  lets the next deadline be found without visiting empty slots.
+ */
+class TimerWheel : public EventQueueBackend
+{
+public:
+  TimerWheel()
+    : m_tick(toTick(time::steady_clock::now()))
+    , m_size(0)
+  {
+    m_occupied.fill(0);
+  }
+
+  ~TimerWheel() final
+  {
+    clear();
+  }
+
+  bool
+  empty() const final
+  {
+    return m_size == 0;
+  }
+
+  time::steady_clock::TimePoint
+  getNextDeadline() const final
+  {
+    return time::steady_clock::TimePoint(TICK * findNextTick());
+  }
+
+  void
+  insert(shared_ptr<EventInfo> info) final
+  {
+    EventInfo* event = info.get();
+    event->self = std::move(info);
+    // round up, so that an event is never executed early
+    event->tick = std::max(toTick(event->expireTime + TICK - time::nanoseconds(1)), m_tick);
+    link(*event);
+    ++m_size;
+  }
+
+  void
+  erase(EventInfo& info) final
+  {
+    unlink(info);
+    --m_size;
+    info.self.reset();
+  }
+
+  void
+  clear() final
+  {
+    for (Slot& slot : m_slots) {
+      EventInfo* event = slot.head;
+      slot.head = slot.tail = nullptr;
+      while (event != nullptr) {
+        EventInfo* next = event->next;
+        event->prev = event->next = nullptr;
+        event->self.reset();
+        event = next;
+      }
+    }
+    m_occupied.fill(0);
+    m_size = 0;
+  }
+
+  shared_ptr<EventInfo>
+  popExpired(time::steady_clock::TimePoint now) final
+  {
+    uint64_t nowTick = toTick(now);
+    while (m_size > 0) {
+      // every event on level 0 is due at or after m_tick, so the slot of m_tick holds due events
+      Slot& current = m_slots[m_tick & SLOT_MASK];
+      if (current.head != nullptr) {
+        if (m_tick > nowTick) {
+          break;
+        }
+        EventInfo& event = *current.head;
+        unlink(event);
+        --m_size;
+        return std::move(event.self);
+      }
+
+      uint64_t next = findNextTick();
+      if (next > nowTick) {
+        break;
+      }
+      advanceTo(next);
+    }
+    return nullptr;
+  }
+
+private:
+  struct Slot
+  {
+    EventInfo* head = nullptr;
+    EventInfo* tail = nullptr;
+  };
+
+  static uint64_t
+  toTick(time::steady_clock::TimePoint t)
+  {
+    return static_cast<uint64_t>(t.time_since_epoch() / TICK);
+  }
+
+  static size_t
+  levelShift(size_t level)
+  {
+    return SLOT_BITS * level;
+  }
+
+  void
+  link(EventInfo& event)
+  {
+    size_t level = 0;
+    uint64_t granule = event.tick;
+    for (; level < N_LEVELS; ++level) {
+      granule = event.tick >> levelShift(level);
+      if (granule - (m_tick >> levelShift(level)) < N_SLOTS) {
+        break;
+      }
+    }
+    if (level == N_LEVELS) {
+      // beyond the span of the wheel: park in the farthest slot of the top level
+      level = N_LEVELS - 1;
+      granule = (m_tick >> levelShift(level)) + N_SLOTS - 1;
+    }
+
+    size_t index = level * N_SLOTS + (granule & SLOT_MASK);
+    Slot& slot = m_slots[index];
+    event.slot = index;
+    event.prev = slot.tail;
+    event.next = nullptr;
+    if (slot.tail == nullptr) {
+      slot.head = &event;
+      m_occupied[index / 64] |= uint64_t(1) << (index % 64);
+    }
+    else {
+      slot.tail->next = &event;
+    }
+    slot.tail = &event;
+  }
+
+  void
+  unlink(EventInfo& event)
+  {
+    Slot& slot = m_slots[event.slot];
+    (event.prev == nullptr ? slot.head : event.prev->next) = event.next;
+    (event.next == nullptr ? slot.tail : event.next->prev) = event.prev;
+    event.prev = event.next = nullptr;
+    if (slot.head == nullptr) {
+      m_occupied[event.slot / 64] &= ~(uint64_t(1) << (event.slot % 64));
+    }
+  }
+
+  /** \return offset from \p start to the first non-empty slot on \p level, scanning circularly,
+   *          or N_SLOTS if the level is empty
+   */
+  size_t
+  findOccupiedSlot(size_t level, size_t start) const
+  {
+    for (size_t offset = 0; offset < N_SLOTS;) {
+      size_t index = level * N_SLOTS + ((start + offset) & SLOT_MASK);
+      uint64_t word = m_occupied[index / 64] >> (index % 64);
+      if (word != 0) {
+        return std::min(offset + __builtin_ctzll(word), N_SLOTS);
+      }
+      offset += 64 - index % 64;
+    }
+    return N_SLOTS;
+  }
+
+  /** \return the next tick at which an event is due or a slot needs to be cascaded
+   *  \pre m_size > 0
+   */
+  uint64_t
+  findNextTick() const
+  {
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (size_t level = 0; level < N_LEVELS; ++level) {
+      uint64_t base = m_tick >> levelShift(level);
+      size_t offset = findOccupiedSlot(level, base & SLOT_MASK);
+      if (offset < N_SLOTS) {
+        next = std::min(next, std::max((base + offset) << levelShift(level), m_tick));
+      }
+    }
+    BOOST_ASSERT(next != std::numeric_limits<uint64_t>::max());
+    return next;
+  }
+
+  /** \brief move the current tick forward, cascading the higher-level slots that start at \p tick
+   */
+  void
+  advanceTo(uint64_t tick)
+  {
+    BOOST_ASSERT(tick > m_tick);
+    m_tick = tick;
+
+    for (size_t level = N_LEVELS - 1; level > 0; --level) {
+      if ((tick & ((uint64_t(1) << levelShift(level)) - 1)) != 0) {
+        continue;
+      }
+
+      size_t index = level * N_SLOTS + ((tick >> levelShift(level)) & SLOT_MASK);
+      Slot& slot = m_slots[index];
+      EventInfo* event = slot.head;
+      slot.head = slot.tail = nullptr;
+      m_occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+      while (event != nullptr) {
+        EventInfo* next = event->next;
+        link(*event);
+        event = next;
+      }
+    }
+  }
+
+private:
+  static const time::nanoseconds TICK;
+  static constexpr size_t SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS = 1 << SLOT_BITS;
+  static constexpr size_t SLOT_MASK = N_SLOTS - 1;
+  static constexpr size_t N_LEVELS = 4;
+
+  std::array<Slot, N_LEVELS * N_SLOTS> m_slots;
+  std::array<uint64_t, N_LEVELS * N_SLOTS / 64> m_occupied;
+  uint64_t m_tick; ///< current tick; no pending event is due before this tick
+  size_t m_size;
+};
+
+const time::nanoseconds TimerWheel::TICK = 1_ms;
+constexpr size_t TimerWheel::SLOT_BITS;
+constexpr size_t TimerWheel::N_SLOTS;
+constexpr size_t TimerWheel::SLOT_MASK;
+constexpr size_t TimerWheel::N_LEVELS;
+
+static unique_ptr<EventQueueBackend>
+makeEventQueue(EventQueueType type)
+{
+  switch (type) {
+    case EventQueueType::ORDERED_SET:
+      return make_unique<OrderedEventQueue>();
+    case EventQueueType::TIMER_WHEEL:
+      return make_unique<TimerWheel>();
+  }
+  BOOST_THROW_EXCEPTION(std::invalid_argument("unknown EventQueueType"));
+}
+
+Scheduler::Scheduler(boost::asio::io_service& ioService,
+                     EventQueueType queueType/* = EventQueueType::ORDERED_SET*/)
   : m_timer(make_unique<detail::SteadyTimer>(ioService))
+  , m_queue(makeEventQueue(queueType))
   , m_isEventExecuting(false)
 {
 }
@@ -88,15 +453,22 @@ Scheduler::scheduleEvent(time::nanoseconds after, const EventCallback& callback)
 {
   BOOST_ASSERT(callback != nullptr);
 
-  EventQueue::iterator i = m_queue.insert(make_shared<EventInfo>(after, callback));
-  (*i)->queueIt = i;
+  bool wasEmpty = m_queue->empty();
+  time::steady_clock::TimePoint oldDeadline;
+  if (!wasEmpty) {
+    oldDeadline = m_queue->getNextDeadline();
+  }
+
+  auto info = make_shared<EventInfo>(after, callback);
+  EventId eventId(info);
+  m_queue->insert(std::move(info));
 
-  if (!m_isEventExecuting && i == m_queue.begin()) {
+  if (!m_isEventExecuting && (wasEmpty || m_queue->getNextDeadline() < oldDeadline)) {
     // the new event is the first one to expire
     this->scheduleNext();
   }
 
-  return EventId(*i);
+  return eventId;
 }
 
 void
@@ -107,12 +479,11 @@ Scheduler::cancelEvent(const EventId& eventId)
     return; // event already expired or cancelled
   }
 
-  if (info->queueIt == m_queue.begin()) {
-    m_timer->cancel();
-  }
-  m_queue.erase(info->queueIt);
+  time::steady_clock::TimePoint oldDeadline = m_queue->getNextDeadline();
+  m_queue->erase(*info);
 
-  if (!m_isEventExecuting) {
+  // the timer needs to be rearmed only if the cancelled event was the first one to expire
+  if (!m_isEventExecuting && (m_queue->empty() || m_queue->getNextDeadline() != oldDeadline)) {
     this->scheduleNext();
   }
 }
@@ -120,17 +491,21 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
-  m_queue.clear();
+  m_queue->clear();
   m_timer->cancel();
 }
 
 void
 Scheduler::scheduleNext()
 {
-  if (!m_queue.empty()) {
-    m_timer->expires_from_now((*m_queue.begin())->expiresFromNow());
-    m_timer->async_wait(bind(&Scheduler::executeEvent, this, _1));
+  if (m_queue->empty()) {
+    m_timer->cancel();
+    return;
   }
+
+  m_timer->expires_from_now(std::max(m_queue->getNextDeadline() - time::steady_clock::now(),
+                                     time::nanoseconds::zero()));
+  m_timer->async_wait(bind(&Scheduler::executeEvent, this, _1));
 }
 
 void
@@ -149,14 +524,7 @@ Scheduler::executeEvent(const boost::system::error_code& error)
 
   // process all expired events
   auto now = time::steady_clock::now();
-  while (!m_queue.empty()) {
-    auto head = m_queue.begin();
-    shared_ptr<EventInfo> info = *head;
-    if (info->expireTime > now) {
-      break;
-    }
-
-    m_queue.erase(head);
+  while (shared_ptr<EventInfo> info = m_queue->popExpired(now)) {
     info->isExpired = true;
     info->callback();
   }
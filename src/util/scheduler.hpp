@@ -117,6 +117,34 @@ public:
 
 using EventQueue = std::multiset<shared_ptr<EventInfo>, EventQueueCompare>;
 
+/**
+ * \brief Selects the data structure that stores pending events of a Scheduler
+ */
+enum class EventQueueType {
+  /** \brief ordered set keyed by expiration time
+   *
+   *  Scheduling and cancellation cost O(log n). Events are executed in the order of their
+   *  expiration times, as soon as they expire.
+   */
+  ORDERED_SET,
+  /** \brief hierarchical timing wheel with intrusive event nodes
+   *
+   *  Scheduling and cancellation cost O(1), which suits applications with a very large number
+   *  of outstanding timeouts. Expiration times are rounded up to a 1ms tick, so that an event
+   *  may be executed up to 1ms late; events due in the same tick are executed in the order
+   *  they were placed into the tick's slot.
+   */
+  TIMER_WHEEL
+};
+
+std::ostream&
+operator<<(std::ostream& os, EventQueueType type);
+
+/**
+ * \brief Stores pending events of a Scheduler
+ */
+class EventQueueBackend;
+
 /**
  * \brief Generic scheduler
  */
@@ -124,7 +152,8 @@ class Scheduler : noncopyable
 {
 public:
   explicit
-  Scheduler(boost::asio::io_service& ioService);
+  Scheduler(boost::asio::io_service& ioService,
+            EventQueueType queueType = EventQueueType::ORDERED_SET);
 
   ~Scheduler();
 
@@ -149,7 +178,7 @@ public:
 
 private:
   /**
-   * \brief Schedule the next event on the deadline timer
+   * \brief Schedule the next event on the deadline timer, or cancel the timer if no event is pending
    */
   void
   scheduleNext();
@@ -165,7 +194,7 @@ private:
 
 private:
   unique_ptr<detail::SteadyTimer> m_timer;
-  EventQueue m_queue;
+  unique_ptr<EventQueueBackend> m_queue;
   bool m_isEventExecuting;
 };
 
@@ -19,7 +19,9 @@
  * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
  */
 
+
 #include "segment-fetcher.hpp"
+#include "content-encoding.hpp"
 #include "../encoding/buffer-stream.hpp"
 #include "../name-component.hpp"
 #include "../lp/nack.hpp"
@@ -27,25 +29,94 @@
 
 #include <boost/lexical_cast.hpp>
 #include <cmath>
+#include <limits>
 
 namespace ndn {
 namespace util {
 
 const uint32_t SegmentFetcher::MAX_INTEREST_REEXPRESS = 3;
 
+/**
+ * @brief lower bound of the slow start threshold after a window decrease
+ */
+static const double MIN_SSTHRESH = 2.0;
+
+SegmentFetcher::Options::Options()
+  : useConstantCwnd(false)
+  , useConstantInterestTimeout(false)
+  , maxTimeout(60_s)
+  , interestLifetime(4_s)
+  , initCwnd(1.0)
+  , initSsthresh(std::numeric_limits<double>::max())
+  , aiStep(1.0)
+  , mdCoef(0.5)
+  , resetCwndToInit(false)
+  , ignoreCongMarks(false)
+  , inOrder(false)
+  , reorderWindow(1024)
+  , decodeContent(true)
+{
+}
+
+void
+SegmentFetcher::Options::validate() const
+{
+  if (maxTimeout < 1_ms) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("maxTimeout must be at least 1 ms"));
+  }
+  if (interestLifetime < 1_ms) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("interestLifetime must be at least 1 ms"));
+  }
+  if (initCwnd < 1.0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("initCwnd must be at least 1"));
+  }
+  if (initSsthresh < 0.0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("initSsthresh must be non-negative"));
+  }
+  if (aiStep < 0.0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("aiStep must be non-negative"));
+  }
+  if (mdCoef <= 0.0 || mdCoef > 1.0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("mdCoef must be in range (0, 1]"));
+  }
+  if (reorderWindow == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("reorderWindow must be positive"));
+  }
+}
+
 SegmentFetcher::SegmentFetcher(Face& face,
                                shared_ptr<security::v2::Validator> validator,
-                               const CompleteCallback& completeCallback,
-                               const ErrorCallback& errorCallback)
+                               const Options& options)
   : m_face(face)
   , m_scheduler(m_face.getIoService())
   , m_validator(validator)
-  , m_completeCallback(completeCallback)
-  , m_errorCallback(errorCallback)
+  , m_options(options)
+  , m_rttEstimator(options.rttOptions)
+  , m_isStopped(false)
+  , m_isPaused(false)
+  , m_timeLastSegmentReceived(time::steady_clock::now())
+  , m_cwnd(options.initCwnd)
+  , m_ssthresh(options.initSsthresh)
+  , m_nSegmentsInFlight(0)
+  , m_nextSegmentNo(0)
+  , m_highInterest(0)
+  , m_highData(0)
+  , m_recPoint(0)
+  , m_nextSegmentToDeliver(0)
   , m_buffer(make_shared<OBufferStream>())
 {
 }
 
+shared_ptr<SegmentFetcher>
+SegmentFetcher::start(Face& face,
+                      const Interest& baseInterest,
+                      security::v2::Validator& validator,
+                      const Options& options)
+{
+  shared_ptr<security::v2::Validator> validatorPtr(&validator, [] (security::v2::Validator*) {});
+  return startWithValidator(face, baseInterest, validatorPtr, options);
+}
+
 shared_ptr<SegmentFetcher>
 SegmentFetcher::fetch(Face& face,
                       const Interest& baseInterest,
@@ -64,139 +135,404 @@ SegmentFetcher::fetch(Face& face,
                       const CompleteCallback& completeCallback,
                       const ErrorCallback& errorCallback)
 {
-  shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher(face, validator, completeCallback,
-                                                        errorCallback));
+  // one segment at a time, failing at the first timeout
+  Options options;
+  options.useConstantCwnd = true;
+  options.useConstantInterestTimeout = true;
+  options.interestLifetime = baseInterest.getInterestLifetime();
+  options.maxTimeout = baseInterest.getInterestLifetime();
 
-  fetcher->fetchFirstSegment(baseInterest, fetcher);
+  shared_ptr<SegmentFetcher> fetcher = startWithValidator(face, baseInterest, validator, options);
+  fetcher->onComplete.connect(completeCallback);
+  fetcher->onError.connect(errorCallback);
+  return fetcher;
+}
 
+shared_ptr<SegmentFetcher>
+SegmentFetcher::startWithValidator(Face& face, const Interest& baseInterest,
+                                   shared_ptr<security::v2::Validator> validator,
+                                   const Options& options)
+{
+  options.validate();
+
+  shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher(face, validator, options));
+  fetcher->m_baseInterest = baseInterest;
+  fetcher->m_baseInterest.setInterestLifetime(options.interestLifetime);
+  fetcher->sendInterest(0, false);
   return fetcher;
 }
 
 void
-SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
-                                  shared_ptr<SegmentFetcher> self)
+SegmentFetcher::stop()
+{
+  if (m_isStopped)
+    return;
+
+  m_isStopped = true;
+  for (const auto& pending : m_pendingSegments) {
+    if (pending.second.interestId != nullptr) {
+      m_face.removePendingInterest(pending.second.interestId);
+    }
+  }
+  m_pendingSegments.clear();
+  m_scheduler.cancelAllEvents();
+}
+
+void
+SegmentFetcher::pause()
+{
+  m_isPaused = true;
+}
+
+void
+SegmentFetcher::resume()
 {
-  Interest interest(baseInterest);
-  interest.setChildSelector(1);
-  interest.setMustBeFresh(true);
+  if (!m_isPaused || m_isStopped)
+    return;
 
-  m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceivedCb, this, _1, _2, true, self),
-                         bind(&SegmentFetcher::afterNackReceivedCb, this, _1, _2, 0, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+  m_isPaused = false;
+  m_timeLastSegmentReceived = time::steady_clock::now();
+  deliverInOrder();
+  if (!finishIfComplete()) {
+    fetchSegmentsInWindow();
+  }
 }
 
 void
-SegmentFetcher::fetchNextSegment(const Interest& origInterest, const Name& dataName,
-                                 uint64_t segmentNo,
-                                 shared_ptr<SegmentFetcher> self)
+SegmentFetcher::fetchSegmentsInWindow()
 {
-  Interest interest(origInterest); // to preserve any selectors
+  if (m_versionedDataName.empty()) {
+    return; // only the version discovery Interest can be in flight
+  }
+  if (m_isPaused || m_isStopped) {
+    return;
+  }
+
+  while (m_nSegmentsInFlight < static_cast<size_t>(m_cwnd)) {
+    if (!m_retxQueue.empty()) {
+      uint64_t segmentNo = m_retxQueue.front();
+      m_retxQueue.pop();
+      auto it = m_pendingSegments.find(segmentNo);
+      if (it == m_pendingSegments.end() || it->second.state != SegmentState::InRetxQueue) {
+        continue;
+      }
+      if (m_nSegments && segmentNo >= *m_nSegments) {
+        m_pendingSegments.erase(it); // beyond the last segment
+        continue;
+      }
+      sendInterest(segmentNo, true);
+    }
+    else if ((!m_nSegments || m_nextSegmentNo < *m_nSegments) &&
+             m_nextSegmentNo - m_nextSegmentToDeliver < m_options.reorderWindow) {
+      sendInterest(m_nextSegmentNo++, false);
+    }
+    else {
+      break;
+    }
+  }
+}
+
+void
+SegmentFetcher::sendInterest(uint64_t segmentNo, bool isRetransmission)
+{
+  Interest interest(m_baseInterest); // to preserve any selectors
+  if (m_versionedDataName.empty()) {
+    interest.setChildSelector(1);
+    interest.setMustBeFresh(true);
+  }
+  else {
+    interest.setChildSelector(0);
+    interest.setMustBeFresh(false);
+    interest.setName(Name(m_versionedDataName).appendSegment(segmentNo));
+  }
   interest.refreshNonce();
-  interest.setChildSelector(0);
-  interest.setMustBeFresh(false);
-  interest.setName(dataName.getPrefix(-1).appendSegment(segmentNo));
-  m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceivedCb, this, _1, _2, false, self),
-                         bind(&SegmentFetcher::afterNackReceivedCb, this, _1, _2, 0, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+
+  auto self = shared_from_this();
+  PendingSegment& pending = m_pendingSegments[segmentNo];
+  pending.state = isRetransmission ? SegmentState::Retransmitted : SegmentState::FirstInterest;
+  pending.sendTime = time::steady_clock::now();
+  if (!isRetransmission) {
+    pending.nNacks = 0;
+  }
+  pending.interestId = m_face.expressInterest(interest,
+                         [self, segmentNo] (const Interest&, const Data& data) {
+                           self->afterSegmentReceivedCb(data, segmentNo);
+                         },
+                         [self, segmentNo] (const Interest&, const lp::Nack& nack) {
+                           self->afterNackReceivedCb(nack, segmentNo);
+                         },
+                         nullptr); // timeout is detected by timeoutEvent
+
+  time::nanoseconds timeout = m_options.useConstantInterestTimeout ?
+                              time::nanoseconds(m_options.interestLifetime) :
+                              m_rttEstimator.getEstimatedRto();
+  pending.timeoutEvent = m_scheduler.scheduleEvent(timeout,
+                                                   [self, segmentNo] {
+                                                     self->afterTimeoutCb(segmentNo);
+                                                   });
+
+  ++m_nSegmentsInFlight;
+  m_highInterest = std::max(m_highInterest, segmentNo);
 }
 
 void
-SegmentFetcher::afterSegmentReceivedCb(const Interest& origInterest,
-                                       const Data& data, bool isSegmentZeroExpected,
-                                       shared_ptr<SegmentFetcher> self)
+SegmentFetcher::afterSegmentReceivedCb(const Data& data, uint64_t segmentNo)
 {
+  if (m_isStopped)
+    return;
+
+  auto it = m_pendingSegments.find(segmentNo);
+  BOOST_ASSERT(it != m_pendingSegments.end());
+  m_scheduler.cancelEvent(it->second.timeoutEvent);
+  it->second.interestId = nullptr;
+  --m_nSegmentsInFlight;
+  m_timeLastSegmentReceived = time::steady_clock::now();
+
+  // Karn's algorithm: a retransmitted segment gives an ambiguous RTT sample
+  if (it->second.state == SegmentState::FirstInterest) {
+    m_rttEstimator.addMeasurement(m_timeLastSegmentReceived - it->second.sendTime,
+                                  m_nSegmentsInFlight + 1);
+  }
+
   afterSegmentReceived(data);
+  auto self = shared_from_this();
   m_validator->validate(data,
-                        bind(&SegmentFetcher::afterValidationSuccess, this, _1,
-                             isSegmentZeroExpected, origInterest, self),
-                        bind(&SegmentFetcher::afterValidationFailure, this, _1, _2));
-
+                        [self, segmentNo] (const Data& data) {
+                          self->afterValidationSuccess(data, segmentNo);
+                        },
+                        [self] (const Data& data, const security::v2::ValidationError& error) {
+                          self->afterValidationFailure(data, error);
+                        });
 }
 
 void
-SegmentFetcher::afterValidationSuccess(const Data& data,
-                                       bool isSegmentZeroExpected,
-                                       const Interest& origInterest,
-                                       shared_ptr<SegmentFetcher> self)
+SegmentFetcher::afterValidationSuccess(const Data& data, uint64_t segmentNo)
 {
+  if (m_isStopped)
+    return;
+
+  m_pendingSegments.erase(segmentNo);
+
   name::Component currentSegment = data.getName().get(-1);
+  if (!currentSegment.isSegment()) {
+    return signalError(DATA_HAS_NO_SEGMENT, "Data Name has no segment number.");
+  }
 
-  if (currentSegment.isSegment()) {
-    if (isSegmentZeroExpected && currentSegment.toSegment() != 0) {
-      fetchNextSegment(origInterest, data.getName(), 0, self);
+  const auto& finalBlockId = data.getFinalBlock();
+  if (finalBlockId && finalBlockId->isSegment()) {
+    m_nSegments = finalBlockId->toSegment() + 1;
+  }
+  else if (finalBlockId && *finalBlockId == currentSegment) {
+    m_nSegments = currentSegment.toSegment() + 1;
+  }
+
+  if (m_versionedDataName.empty()) {
+    m_versionedDataName = data.getName().getPrefix(-1);
+    if (currentSegment.toSegment() != 0) {
+      // the version is discovered, start fetching from segment 0
+      fetchSegmentsInWindow();
+      return;
     }
-    else {
-      m_buffer->write(reinterpret_cast<const char*>(data.getContent().value()),
-                      data.getContent().value_size());
-      afterSegmentValidated(data);
-      const auto& finalBlockId = data.getFinalBlock();
-      if (!finalBlockId || (*finalBlockId > currentSegment)) {
-        fetchNextSegment(origInterest, data.getName(), currentSegment.toSegment() + 1, self);
-      }
-      else {
-        return m_completeCallback(m_buffer->buf());
-      }
+    m_nextSegmentNo = 1;
+  }
+
+  uint64_t receivedSegmentNo = currentSegment.toSegment();
+  if (receivedSegmentNo >= m_nextSegmentToDeliver &&
+      (!m_nSegments || receivedSegmentNo < *m_nSegments)) {
+    Block content;
+    try {
+      content = m_options.decodeContent ? getDecodedContent(data) : data.getContent();
+    }
+    catch (const ContentEncodingError& e) {
+      return signalError(CONTENT_DECODING_FAIL, "Segment content cannot be decoded: " +
+                                                std::string(e.what()));
     }
+    m_receivedSegments.emplace(receivedSegmentNo, std::move(content));
+  }
+  afterSegmentValidated(data);
+
+  m_highData = std::max(m_highData, receivedSegmentNo);
+  if (data.getCongestionMark() > 0 && !m_options.ignoreCongMarks) {
+    onCongestion();
   }
   else {
-    m_errorCallback(DATA_HAS_NO_SEGMENT, "Data Name has no segment number.");
+    windowIncrease();
+  }
+
+  deliverInOrder();
+  if (!finishIfComplete()) {
+    fetchSegmentsInWindow();
   }
 }
 
 void
 SegmentFetcher::afterValidationFailure(const Data& data, const security::v2::ValidationError& error)
 {
-  return m_errorCallback(SEGMENT_VALIDATION_FAIL, "Segment validation fail " +
-                         boost::lexical_cast<std::string>(error));
+  if (m_isStopped)
+    return;
+
+  signalError(SEGMENT_VALIDATION_FAIL, "Segment validation fail " +
+              boost::lexical_cast<std::string>(error));
 }
 
+void
+SegmentFetcher::afterNackReceivedCb(const lp::Nack& nack, uint64_t segmentNo)
+{
+  if (m_isStopped)
+    return;
+
+  auto it = m_pendingSegments.find(segmentNo);
+  BOOST_ASSERT(it != m_pendingSegments.end());
+  PendingSegment& pending = it->second;
+  m_scheduler.cancelEvent(pending.timeoutEvent);
+  pending.interestId = nullptr;
+  pending.state = SegmentState::InRetxQueue;
+  --m_nSegmentsInFlight;
+  afterSegmentNacked();
+
+  if (m_nSegments && segmentNo >= *m_nSegments) {
+    m_pendingSegments.erase(it); // beyond the last segment
+    return fetchSegmentsInWindow();
+  }
+
+  if (++pending.nNacks > MAX_INTEREST_REEXPRESS) {
+    return signalError(NACK_ERROR, "Nack Error");
+  }
+
+  switch (nack.getReason()) {
+    case lp::NackReason::DUPLICATE:
+      enqueueRetransmission(segmentNo);
+      break;
+    case lp::NackReason::CONGESTION: {
+      onCongestion();
+      using ms = time::milliseconds;
+      auto self = shared_from_this();
+      m_scheduler.scheduleEvent(ms(static_cast<ms::rep>(std::pow(2, pending.nNacks))),
+                                [self, segmentNo] { self->enqueueRetransmission(segmentNo); });
+      break;
+    }
+    default:
+      signalError(NACK_ERROR, "Nack Error");
+      break;
+  }
+}
 
 void
-SegmentFetcher::afterNackReceivedCb(const Interest& origInterest, const lp::Nack& nack,
-                                    uint32_t reExpressCount, shared_ptr<SegmentFetcher> self)
+SegmentFetcher::afterTimeoutCb(uint64_t segmentNo)
 {
-  if (reExpressCount >= MAX_INTEREST_REEXPRESS) {
-    m_errorCallback(NACK_ERROR, "Nack Error");
+  auto it = m_pendingSegments.find(segmentNo);
+  BOOST_ASSERT(it != m_pendingSegments.end());
+  PendingSegment& pending = it->second;
+  m_face.removePendingInterest(pending.interestId);
+  pending.interestId = nullptr;
+  pending.state = SegmentState::InRetxQueue;
+  --m_nSegmentsInFlight;
+  afterSegmentTimedOut();
+
+  if (m_nSegments && segmentNo >= *m_nSegments) {
+    m_pendingSegments.erase(it); // beyond the last segment
+    return fetchSegmentsInWindow();
+  }
+
+  if (!m_isPaused &&
+      time::steady_clock::now() - m_timeLastSegmentReceived >= m_options.maxTimeout) {
+    return signalError(INTEREST_TIMEOUT, "Timeout");
+  }
+
+  m_rttEstimator.backoffRto();
+  onCongestion();
+  enqueueRetransmission(segmentNo);
+}
+
+void
+SegmentFetcher::enqueueRetransmission(uint64_t segmentNo)
+{
+  if (m_versionedDataName.empty()) {
+    // version discovery Interest is retransmitted directly, as there is no window yet
+    sendInterest(segmentNo, true);
+    return;
+  }
+
+  m_retxQueue.push(segmentNo);
+  fetchSegmentsInWindow();
+}
+
+void
+SegmentFetcher::onCongestion()
+{
+  if (m_highData > m_recPoint) {
+    m_recPoint = m_highInterest;
+    windowDecrease();
+  }
+}
+
+void
+SegmentFetcher::windowIncrease()
+{
+  if (m_options.useConstantCwnd) {
+    return;
+  }
+
+  if (m_cwnd < m_ssthresh) {
+    m_cwnd += m_options.aiStep; // slow start
   }
   else {
-    switch (nack.getReason()) {
-      case lp::NackReason::DUPLICATE:
-        reExpressInterest(origInterest, reExpressCount, self);
-        break;
-      case lp::NackReason::CONGESTION:
-        using ms = time::milliseconds;
-        m_scheduler.scheduleEvent(ms(static_cast<ms::rep>(std::pow(2, reExpressCount + 1))),
-                                  bind(&SegmentFetcher::reExpressInterest, this,
-                                       origInterest, reExpressCount, self));
-        break;
-      default:
-        m_errorCallback(NACK_ERROR, "Nack Error");
-        break;
-    }
+    m_cwnd += m_options.aiStep / std::floor(m_cwnd); // congestion avoidance
   }
 }
 
 void
-SegmentFetcher::reExpressInterest(Interest interest, uint32_t reExpressCount,
-                                  shared_ptr<SegmentFetcher> self)
+SegmentFetcher::windowDecrease()
 {
-  interest.refreshNonce();
-  BOOST_ASSERT(interest.hasNonce());
+  if (m_options.useConstantCwnd) {
+    return;
+  }
+
+  m_ssthresh = std::max(MIN_SSTHRESH, m_cwnd * m_options.mdCoef);
+  m_cwnd = m_options.resetCwndToInit ? m_options.initCwnd : m_ssthresh;
+}
 
-  bool isSegmentZeroExpected = true;
-  if (!interest.getName().empty()) {
-    name::Component lastComponent = interest.getName().get(-1);
-    isSegmentZeroExpected = !lastComponent.isSegment();
+void
+SegmentFetcher::deliverInOrder()
+{
+  // a signal handler may pause or stop the fetcher
+  while (!m_isPaused && !m_isStopped && !m_receivedSegments.empty() &&
+         m_receivedSegments.begin()->first == m_nextSegmentToDeliver) {
+    Block content = std::move(m_receivedSegments.begin()->second);
+    m_receivedSegments.erase(m_receivedSegments.begin());
+    ++m_nextSegmentToDeliver;
+
+    if (m_options.inOrder) {
+      onInOrderData(make_shared<const Buffer>(content.value(), content.value_size()));
+    }
+    else {
+      m_buffer->write(reinterpret_cast<const char*>(content.value()), content.value_size());
+    }
   }
+}
 
-  m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceivedCb, this, _1, _2,
-                              isSegmentZeroExpected, self),
-                         bind(&SegmentFetcher::afterNackReceivedCb, this, _1, _2,
-                              ++reExpressCount, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+bool
+SegmentFetcher::finishIfComplete()
+{
+  if (m_isStopped || !m_nSegments || m_nextSegmentToDeliver < *m_nSegments) {
+    return m_isStopped;
+  }
+
+  stop();
+  if (m_options.inOrder) {
+    onInOrderComplete();
+  }
+  else {
+    onComplete(m_buffer->buf());
+  }
+  return true;
+}
+
+void
+SegmentFetcher::signalError(uint32_t code, const std::string& msg)
+{
+  stop();
+  onError(code, msg);
 }
 
 } // namespace util
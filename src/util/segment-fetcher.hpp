@@ -19,15 +19,20 @@
  * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
  */
 
+
 #ifndef NDN_UTIL_SEGMENT_FETCHER_HPP
 #define NDN_UTIL_SEGMENT_FETCHER_HPP
 
 #include "../common.hpp"
 #include "../face.hpp"
 #include "../security/v2/validator.hpp"
+#include "rtt-estimator.hpp"
 #include "scheduler.hpp"
 #include "signal.hpp"
 
+#include <map>
+#include <queue>
+
 namespace ndn {
 
 class OBufferStream;
@@ -58,25 +63,46 @@ namespace util {
  *
  *    >> Interest: `/<prefix>/<version>/<segment=0>`
  *
- * 5. Keep sending Interests for the next segment while the retrieved Data does not have
- *    FinalBlockId or FinalBlockId != Data.getName().get(-1).
+ * 5. Keep sending Interests for the next segments, as many as the congestion window allows,
+ *    until the segment number indicated by FinalBlockId is reached.
  *
  *    >> Interest: `/<prefix>/<version>/<segment=(N+1))>`
  *
- * 6. Fire onCompletion callback with memory block that combines content part from all
+ * 6. Fire onComplete signal with memory block that combines content part from all
  *    segmented objects.
  *
- * If an error occurs during the fetching process, an error callback is fired
- * with a proper error code.  The following errors are possible:
+ * Alternatively, if Options::inOrder is set, the content of each segment is emitted through
+ * onInOrderData as soon as all preceding segments have been emitted, and onInOrderComplete is
+ * fired after the last segment. The fetcher then holds at most Options::reorderWindow segments
+ * in memory regardless of the size of the object. The application may call pause() to apply
+ * backpressure, e.g., while a write to disk is in progress, and resume() to continue.
+ *
+ * A producer may compress each segment with setEncodedContent(). Unless Options::decodeContent
+ * is cleared, the content of such a segment is decompressed after it has been validated, so that
+ * the application receives the original content in either mode.
  *
- * - `INTEREST_TIMEOUT`: if any of the Interests times out
+ * The number of Interests in flight is controlled by an AIMD congestion window. The window
+ * grows on every validated segment (slow start up to the threshold, then congestion avoidance),
+ * and is reduced at most once per RTT when a timeout, a congestion Nack, or a Data carrying
+ * a congestion mark indicates congestion. Lost segments are retransmitted after an adaptive
+ * retransmission timeout computed by RttEstimator. Segments may arrive out of order; their
+ * contents are reassembled in segment number order.
+ *
+ * If an error occurs during the fetching process, onError signal is fired with a proper error
+ * code, and the fetching is stopped. The following errors are possible:
+ *
+ * - `INTEREST_TIMEOUT`: if no segment has been received within Options::maxTimeout
  * - `DATA_HAS_NO_SEGMENT`: if any of the retrieved Data packets don't have segment
  *   as a last component of the name (not counting implicit digest)
  * - `SEGMENT_VALIDATION_FAIL`: if any retrieved segment fails user-provided validation
+ * - `NACK_ERROR`: if an Interest is Nacked for a reason other than Congestion or Duplicate,
+ *   or more than MAX_INTEREST_REEXPRESS times for the same segment
+ * - `CONTENT_DECODING_FAIL`: if Options::decodeContent is set and the content of a segment
+ *   cannot be decoded
  *
  * In order to validate individual segments, a Validator instance needs to be specified.
- * If the segment validation is successful, afterValidationSuccess callback is fired, otherwise
- * afterValidationFailure callback.
+ * If the segment validation is successful, afterSegmentValidated signal is fired, otherwise
+ * the fetching fails with `SEGMENT_VALIDATION_FAIL`.
  *
  * Examples:
  *
@@ -93,13 +119,12 @@ namespace util {
  *     }
  *
  *     ...
- *     SegmentFetcher::fetch(face, Interest("/data/prefix", 30_s),
- *                           validator,
- *                           bind(&afterFetchComplete, this, _1),
- *                           bind(&afterFetchError, this, _1, _2));
+ *     auto fetcher = SegmentFetcher::start(face, Interest("/data/prefix"), validator);
+ *     fetcher->onComplete.connect(bind(&afterFetchComplete, this, _1));
+ *     fetcher->onError.connect(bind(&afterFetchError, this, _1, _2));
  *
  */
-class SegmentFetcher : noncopyable
+class SegmentFetcher : noncopyable, public enable_shared_from_this<SegmentFetcher>
 {
 public:
   /**
@@ -117,7 +142,42 @@ public:
     INTEREST_TIMEOUT = 1,
     DATA_HAS_NO_SEGMENT = 2,
     SEGMENT_VALIDATION_FAIL = 3,
-    NACK_ERROR = 4
+    NACK_ERROR = 4,
+    CONTENT_DECODING_FAIL = 5
+  };
+
+  /**
+   * @brief Options of the congestion control and retransmission logic
+   */
+  class Options
+  {
+  public:
+    Options();
+
+    /**
+     * @throw std::invalid_argument options are invalid
+     */
+    void
+    validate() const;
+
+  public:
+    bool useConstantCwnd;                ///< if true, window size is kept at initCwnd
+    bool useConstantInterestTimeout;     ///< if true, Interests time out after interestLifetime
+                                         ///< instead of the estimated RTO
+    time::milliseconds maxTimeout;       ///< fail if no segment is received for this duration
+    time::milliseconds interestLifetime; ///< InterestLifetime of every Interest
+    double initCwnd;                     ///< initial congestion window size
+    double initSsthresh;                 ///< initial slow start threshold
+    double aiStep;                       ///< additive increase step, in segments
+    double mdCoef;                       ///< multiplicative decrease coefficient
+    bool resetCwndToInit;                ///< reduce window to initCwnd instead of ssthresh
+    bool ignoreCongMarks;                ///< disable window decrease after a congestion mark
+    bool inOrder;                        ///< emit onInOrderData instead of onComplete
+    size_t reorderWindow;                ///< maximum distance between the next segment to be
+                                         ///< delivered and any requested segment
+    RttEstimator::Options rttOptions;    ///< options of the RTT estimator
+    bool decodeContent;                  ///< decompress the content of each segment that
+                                         ///< indicates a ContentEncoding
   };
 
   /**
@@ -125,6 +185,35 @@ public:
    *
    * @param face          Reference to the Face that should be used to fetch data
    * @param baseInterest  An Interest for the initial segment of requested data.
+   *                      This interest may include selectors that will propagate to all
+   *                      subsequent Interests. The only exception is that the initial Interest
+   *                      will be forced to include "ChildSelector=rightmost" and
+   *                      "MustBeFresh=true" selectors, which will be turned off in subsequent
+   *                      Interests. InterestLifetime is taken from @p options.
+   * @param validator     Reference to the Validator that should be used to validate data. Caller
+   *                      must ensure validator is valid until either onComplete or onError
+   *                      signal is emitted, or stop() is invoked.
+   * @param options       Options of the congestion control and retransmission logic
+   *
+   * @return A shared_ptr to the constructed SegmentFetcher. The fetcher keeps itself alive
+   *         until the fetching completes, fails, or is stopped.
+   * @throw std::invalid_argument @p options are invalid
+   */
+  static
+  shared_ptr<SegmentFetcher>
+  start(Face& face,
+        const Interest& baseInterest,
+        security::v2::Validator& validator,
+        const Options& options = Options());
+
+  /**
+   * @brief Initiates segment fetching
+   *
+   * The fetching proceeds one segment at a time: the congestion window is fixed at one
+   * segment, and the fetching fails when an Interest times out.
+   *
+   * @param face          Reference to the Face that should be used to fetch data
+   * @param baseInterest  An Interest for the initial segment of requested data.
    *                      This interest may include custom InterestLifetime and selectors that
    *                      will propagate to all subsequent Interests.  The only exception is that
    *                      the initial Interest will be forced to include "ChildSelector=rightmost" and
@@ -149,6 +238,9 @@ public:
   /**
    * @brief Initiate segment fetching
    *
+   * The fetching proceeds one segment at a time: the congestion window is fixed at one
+   * segment, and the fetching fails when an Interest times out.
+   *
    * @param face          Reference to the Face that should be used to fetch data
    * @param baseInterest  An Interest for the initial segment of requested data.
    *                      This interest may include custom InterestLifetime and selectors that
@@ -170,41 +262,134 @@ public:
         const CompleteCallback& completeCallback,
         const ErrorCallback& errorCallback);
 
+  /**
+   * @brief Stop fetching
+   *
+   * Pending Interests are cancelled, and no signal will be emitted afterwards.
+   */
+  void
+  stop();
+
+  /**
+   * @brief Temporarily stop expressing Interests and delivering data
+   *
+   * Interests already in flight are not cancelled, and their Data are buffered until resume()
+   * is invoked. Options::maxTimeout is not enforced while the fetcher is paused.
+   */
+  void
+  pause();
+
+  /**
+   * @brief Deliver buffered data and continue fetching after pause()
+   */
+  void
+  resume();
+
+  /**
+   * @return current congestion window size
+   */
+  double
+  getCwnd() const
+  {
+    return m_cwnd;
+  }
+
+  /**
+   * @return RTT estimator of this fetcher
+   */
+  const RttEstimator&
+  getRttEstimator() const
+  {
+    return m_rttEstimator;
+  }
+
 private:
   SegmentFetcher(Face& face,
                  shared_ptr<security::v2::Validator> validator,
-                 const CompleteCallback& completeCallback,
-                 const ErrorCallback& errorCallback);
+                 const Options& options);
+
+  static shared_ptr<SegmentFetcher>
+  startWithValidator(Face& face, const Interest& baseInterest,
+                     shared_ptr<security::v2::Validator> validator, const Options& options);
 
+  /**
+   * @brief express Interests while the congestion window allows
+   *
+   * Retransmissions take precedence over Interests for new segments.
+   */
   void
-  fetchFirstSegment(const Interest& baseInterest, shared_ptr<SegmentFetcher> self);
+  fetchSegmentsInWindow();
 
   void
-  fetchNextSegment(const Interest& origInterest, const Name& dataName, uint64_t segmentNo,
-                   shared_ptr<SegmentFetcher> self);
+  sendInterest(uint64_t segmentNo, bool isRetransmission);
 
   void
-  afterSegmentReceivedCb(const Interest& origInterest,
-                         const Data& data, bool isSegmentZeroExpected,
-                         shared_ptr<SegmentFetcher> self);
+  afterSegmentReceivedCb(const Data& data, uint64_t segmentNo);
+
   void
-  afterValidationSuccess(const Data& data,
-                         bool isSegmentZeroExpected,
-                         const Interest& origInterest,
-                         shared_ptr<SegmentFetcher> self);
+  afterValidationSuccess(const Data& data, uint64_t segmentNo);
 
   void
   afterValidationFailure(const Data& data, const security::v2::ValidationError& error);
 
   void
-  afterNackReceivedCb(const Interest& origInterest, const lp::Nack& nack,
-                      uint32_t reExpressCount, shared_ptr<SegmentFetcher> self);
+  afterNackReceivedCb(const lp::Nack& nack, uint64_t segmentNo);
+
+  void
+  afterTimeoutCb(uint64_t segmentNo);
+
+  void
+  enqueueRetransmission(uint64_t segmentNo);
+
+  /**
+   * @brief react to a congestion signal, at most once per RTT
+   */
+  void
+  onCongestion();
+
+  void
+  windowIncrease();
+
+  void
+  windowDecrease();
+
+  /**
+   * @brief append consecutive segments, starting from the next expected one, to the output
+   */
+  void
+  deliverInOrder();
+
+  /**
+   * @brief emit the completion signal and stop if every segment has been delivered
+   * @retval true fetching has completed
+   */
+  bool
+  finishIfComplete();
 
   void
-  reExpressInterest(Interest interest, uint32_t reExpressCount,
-                    shared_ptr<SegmentFetcher> self);
+  signalError(uint32_t code, const std::string& msg);
 
 public:
+  /**
+   * @brief Emits upon successful retrieval of the complete data
+   */
+  Signal<SegmentFetcher, ConstBufferPtr> onComplete;
+
+  /**
+   * @brief Emits the content of each segment in order, if Options::inOrder is set
+   */
+  Signal<SegmentFetcher, ConstBufferPtr> onInOrderData;
+
+  /**
+   * @brief Emits after the content of the last segment is emitted, if Options::inOrder is set
+   */
+  Signal<SegmentFetcher> onInOrderComplete;
+
+  /**
+   * @brief Emits when the fetching fails
+   */
+  Signal<SegmentFetcher, uint32_t, std::string> onError;
+
   /**
    * @brief Emits whenever a data segment received
    */
@@ -215,12 +400,58 @@ public:
    */
   Signal<SegmentFetcher, Data> afterSegmentValidated;
 
+  /**
+   * @brief Emits whenever an Interest for a data segment is Nacked
+   */
+  Signal<SegmentFetcher> afterSegmentNacked;
+
+  /**
+   * @brief Emits whenever an Interest for a data segment times out
+   */
+  Signal<SegmentFetcher> afterSegmentTimedOut;
+
 private:
+  enum class SegmentState {
+    FirstInterest, ///< the first Interest for this segment is in flight
+    InRetxQueue,   ///< waiting to be retransmitted
+    Retransmitted, ///< a retransmitted Interest for this segment is in flight
+  };
+
+  class PendingSegment
+  {
+  public:
+    SegmentState state;
+    time::steady_clock::TimePoint sendTime;
+    const PendingInterestId* interestId;
+    EventId timeoutEvent;
+    uint32_t nNacks;
+  };
+
   Face& m_face;
   Scheduler m_scheduler;
   shared_ptr<security::v2::Validator> m_validator;
-  CompleteCallback m_completeCallback;
-  ErrorCallback m_errorCallback;
+  const Options m_options;
+  RttEstimator m_rttEstimator;
+  bool m_isStopped;
+  bool m_isPaused;
+
+  Interest m_baseInterest;
+  Name m_versionedDataName; ///< empty until the version has been discovered
+  time::steady_clock::TimePoint m_timeLastSegmentReceived;
+
+  double m_cwnd;
+  double m_ssthresh;
+  size_t m_nSegmentsInFlight;
+  optional<uint64_t> m_nSegments; ///< total number of segments, once FinalBlockId is known
+  uint64_t m_nextSegmentNo;       ///< next segment never requested before
+  uint64_t m_highInterest;        ///< highest segment number requested
+  uint64_t m_highData;            ///< highest segment number received
+  uint64_t m_recPoint;            ///< m_highInterest at the last window decrease
+
+  std::map<uint64_t, PendingSegment> m_pendingSegments;
+  std::queue<uint64_t> m_retxQueue;
+  std::map<uint64_t, Block> m_receivedSegments; ///< validated Content not yet delivered
+  uint64_t m_nextSegmentToDeliver;
 
   shared_ptr<OBufferStream> m_buffer;
 };
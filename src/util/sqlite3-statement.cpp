@@ -107,10 +107,62 @@ Sqlite3Statement::step()
   return sqlite3_step(m_stmt);
 }
 
+void
+Sqlite3Statement::reset()
+{
+  sqlite3_reset(m_stmt);
+  sqlite3_clear_bindings(m_stmt);
+}
+
 Sqlite3Statement::operator sqlite3_stmt*()
 {
   return m_stmt;
 }
 
+Sqlite3StatementCache::ScopedStatement::ScopedStatement(Sqlite3Statement& statement)
+  : m_statement(&statement)
+{
+}
+
+Sqlite3StatementCache::ScopedStatement::ScopedStatement(ScopedStatement&& other)
+  : m_statement(other.m_statement)
+{
+  other.m_statement = nullptr;
+}
+
+Sqlite3StatementCache::ScopedStatement::~ScopedStatement()
+{
+  if (m_statement != nullptr) {
+    m_statement->reset();
+  }
+}
+
+Sqlite3StatementCache::Sqlite3StatementCache(sqlite3* database)
+  : m_database(database)
+{
+}
+
+Sqlite3StatementCache::ScopedStatement
+Sqlite3StatementCache::prepare(const std::string& statement)
+{
+  auto& cached = m_statements[statement];
+  if (cached == nullptr) {
+    try {
+      cached = make_unique<Sqlite3Statement>(m_database, statement);
+    }
+    catch (const std::domain_error&) {
+      m_statements.erase(statement);
+      throw;
+    }
+  }
+  return ScopedStatement(*cached);
+}
+
+void
+Sqlite3StatementCache::clear()
+{
+  m_statements.clear();
+}
+
 } // namespace util
 } // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2015 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,6 +24,7 @@
 
 #include "../encoding/block.hpp"
 #include <string>
+#include <unordered_map>
 
 struct sqlite3;
 struct sqlite3_stmt;
@@ -143,6 +144,12 @@ public:
   int
   step();
 
+  /**
+   * @brief reset the statement so that it can be executed again, and clear all bindings
+   */
+  void
+  reset();
+
   /**
    * @brief implicitly converts to sqlite3_stmt* to be used in SQLite C API
    */
@@ -152,6 +159,71 @@ private:
   sqlite3_stmt* m_stmt;
 };
 
+/**
+ * @brief cache of SQLite3 prepared statements of a database connection
+ *
+ * Each distinct SQL statement is prepared once, and reused by subsequent calls to prepare().
+ * The cache must be cleared or destroyed before the database connection is closed.
+ *
+ * @warning This class is implementation detail of ndn-cxx library.
+ */
+class Sqlite3StatementCache : noncopyable
+{
+public:
+  /**
+   * @brief a prepared statement borrowed from the cache
+   *
+   * The statement is reset and its bindings are cleared when the borrower goes out of scope,
+   * so that no read transaction stays open and the statement is ready for the next borrower.
+   * At most one borrower of the same statement may exist at any time.
+   */
+  class ScopedStatement : noncopyable
+  {
+  public:
+    explicit
+    ScopedStatement(Sqlite3Statement& statement);
+
+    ScopedStatement(ScopedStatement&& other);
+
+    ~ScopedStatement();
+
+    Sqlite3Statement*
+    operator->() const
+    {
+      return m_statement;
+    }
+
+    Sqlite3Statement&
+    operator*() const
+    {
+      return *m_statement;
+    }
+
+  private:
+    Sqlite3Statement* m_statement;
+  };
+
+  explicit
+  Sqlite3StatementCache(sqlite3* database);
+
+  /**
+   * @brief get the prepared statement of @p statement, preparing it on first use
+   * @throw std::domain_error SQL statement is bad
+   */
+  ScopedStatement
+  prepare(const std::string& statement);
+
+  /**
+   * @brief finalize all cached statements
+   */
+  void
+  clear();
+
+private:
+  sqlite3* m_database;
+  std::unordered_map<std::string, unique_ptr<Sqlite3Statement>> m_statements;
+};
+
 } // namespace util
 } // namespace ndn
 
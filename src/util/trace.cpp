@@ -0,0 +1,516 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "trace.hpp"
+#include "../interest.hpp"
+
+#include <algorithm>
+#include <cinttypes> // for PRIdLEAST64
+#include <stdio.h>   // for snprintf()
+
+namespace ndn {
+namespace util {
+
+// A binary trace starts with TRACE_MAGIC, TRACE_VERSION, and TRACE_BYTE_ORDER, followed by frames.
+// Multi-octet numbers are in the byte order of the writer, which the decoder checks with
+// TRACE_BYTE_ORDER. Strings are a uint16 length followed by the octets.
+//
+// site frame:    uint8 TRACE_FRAME_SITE, uint32 site ID, int8 level, string module,
+//                string format, string file, uint32 line
+// record frame:  uint8 TRACE_FRAME_RECORD, uint32 site ID, int64 nanoseconds since epoch,
+//                uint8 number of arguments, arguments
+// dropped frame: uint8 TRACE_FRAME_DROPPED, int64 nanoseconds since epoch,
+//                uint64 number of records dropped since the previous dropped frame
+//
+// Each argument is a uint8 TraceArgumentType followed by int64, uint64, double, uint8,
+// or a string holding the characters or the wire encoding.
+static const char TRACE_MAGIC[] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint8_t TRACE_VERSION = 1;
+static const uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+static const size_t MIN_BUFFER_SIZE = 4096;
+
+const size_t Trace::DEFAULT_BUFFER_SIZE = 1 << 20;
+const time::milliseconds Trace::DEFAULT_FLUSH_INTERVAL = time::milliseconds(100);
+
+std::atomic<bool> Trace::s_isEnabled(false);
+
+// The ring of each thread is owned by a thread-local RingHolder and shared with the Trace
+// singleton, which drains it. The ring is removed from Trace after the thread exits and the
+// ring has been drained. t_ring and t_isShutdown are trivially destructible, so that log
+// statements during thread shutdown, after the RingHolder has been destroyed, are ignored.
+static thread_local detail::TraceRing* t_ring = nullptr;
+static thread_local bool t_isShutdown = false;
+
+class Trace::RingHolder : noncopyable
+{
+public:
+  RingHolder()
+    : ring(Trace::get().addRing())
+  {
+    t_ring = ring.get();
+  }
+
+  ~RingHolder()
+  {
+    t_ring = nullptr;
+    t_isShutdown = true;
+  }
+
+public:
+  shared_ptr<detail::TraceRing> ring;
+};
+
+namespace detail {
+
+const char*
+writeTraceFormat(std::ostream& os, const char* format)
+{
+  const char* placeholder = std::strstr(format, "{}");
+  if (placeholder == nullptr) {
+    size_t size = std::strlen(format);
+    os.write(format, size);
+    os << ' ';
+    return format + size;
+  }
+
+  os.write(format, placeholder - format);
+  return placeholder + 2;
+}
+
+static void
+encodeTraceWire(TraceRing::Writer& writer, TraceArgumentType type, const Block& wire)
+{
+  if (wire.size() > std::numeric_limits<uint16_t>::max()) {
+    encodeTraceArgument(writer, "(too long)");
+    return;
+  }
+  writer.writeValue<uint8_t>(type);
+  writer.writeValue<uint16_t>(static_cast<uint16_t>(wire.size()));
+  writer.write(wire.wire(), wire.size());
+}
+
+void
+encodeTraceArgument(TraceRing::Writer& writer, const Name& name)
+{
+  encodeTraceWire(writer, TRACE_ARG_NAME, name.wireEncode());
+}
+
+void
+encodeTraceArgument(TraceRing::Writer& writer, const Interest& interest)
+{
+  encodeTraceWire(writer, TRACE_ARG_INTEREST, interest.wireEncode());
+}
+
+} // namespace detail
+
+static void
+writeTraceString(std::ostream& os, const std::string& s)
+{
+  uint16_t size = static_cast<uint16_t>(std::min<size_t>(s.size(), std::numeric_limits<uint16_t>::max()));
+  os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  os.write(s.data(), size);
+}
+
+template<typename T>
+static void
+writeTraceValue(std::ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static int64_t
+getTraceTimestamp()
+{
+  return time::duration_cast<time::nanoseconds>(time::system_clock::now().time_since_epoch()).count();
+}
+
+Trace::Trace()
+  : m_nRetiredDropped(0)
+  , m_bufferSize(DEFAULT_BUFFER_SIZE)
+  , m_nWrittenSites(0)
+  , m_nWrittenDropped(0)
+  , m_shouldStopFlusher(false)
+{
+}
+
+Trace::~Trace()
+{
+  disableImpl();
+}
+
+Trace&
+Trace::get()
+{
+  static Trace instance;
+  return instance;
+}
+
+detail::TraceRing*
+Trace::getThreadRing()
+{
+  if (t_ring == nullptr && !t_isShutdown) {
+    static thread_local RingHolder holder;
+  }
+  return t_ring;
+}
+
+shared_ptr<detail::TraceRing>
+Trace::addRing()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto ring = make_shared<detail::TraceRing>(m_bufferSize);
+  m_rings.push_back(ring);
+  return ring;
+}
+
+uint32_t
+Trace::registerSite(detail::TraceSiteInfo site)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_sites.push_back(std::move(site));
+  return static_cast<uint32_t>(m_sites.size() - 1);
+}
+
+void
+Trace::enable(shared_ptr<std::ostream> os, size_t bufferSize, time::milliseconds flushInterval)
+{
+  get().enableImpl(std::move(os), bufferSize, flushInterval);
+}
+
+void
+Trace::enableImpl(shared_ptr<std::ostream> os, size_t bufferSize, time::milliseconds flushInterval)
+{
+  if (os == nullptr) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("trace destination must not be nullptr"));
+  }
+  if (flushInterval <= time::milliseconds::zero()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("flushInterval must be positive"));
+  }
+
+  std::lock_guard<std::mutex> controlLock(m_controlMutex);
+  stop();
+
+  size_t capacity = MIN_BUFFER_SIZE;
+  while (capacity < bufferSize) {
+    capacity <<= 1;
+  }
+
+  uint64_t nDropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bufferSize = capacity;
+    // records left from a previous trace session belong to the previous destination
+    for (const auto& ring : m_rings) {
+      ring->discard();
+    }
+    nDropped = getNDroppedImpl();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    m_destination = std::move(os);
+    m_destination->write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    writeTraceValue<uint8_t>(*m_destination, TRACE_VERSION);
+    writeTraceValue<uint32_t>(*m_destination, TRACE_BYTE_ORDER);
+    m_nWrittenSites = 0;
+    m_nWrittenDropped = nDropped;
+  }
+
+  m_shouldStopFlusher = false;
+  m_flusher = std::thread(&Trace::runFlusher, this, flushInterval);
+  s_isEnabled.store(true, std::memory_order_relaxed);
+}
+
+void
+Trace::disable()
+{
+  get().disableImpl();
+}
+
+void
+Trace::disableImpl()
+{
+  std::lock_guard<std::mutex> controlLock(m_controlMutex);
+  stop();
+}
+
+void
+Trace::stop()
+{
+  s_isEnabled.store(false, std::memory_order_relaxed);
+
+  if (m_flusher.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_flusherMutex);
+      m_shouldStopFlusher = true;
+    }
+    m_flusherCv.notify_all();
+    m_flusher.join();
+  }
+
+  flushImpl();
+
+  std::lock_guard<std::mutex> lock(m_outputMutex);
+  m_destination.reset();
+}
+
+void
+Trace::flush()
+{
+  get().flushImpl();
+}
+
+void
+Trace::flushImpl()
+{
+  std::lock_guard<std::mutex> outputLock(m_outputMutex);
+  if (m_destination == nullptr) {
+    return;
+  }
+
+  // Sites are collected after the records, so that every collected record has its site:
+  // a site is registered before the first record that refers to it is published.
+  m_records.clear();
+  std::vector<detail::TraceSiteInfo> newSites;
+  uint64_t nDropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& ring : m_rings) {
+      ring->consume(m_records);
+    }
+    // a ring held only by Trace belongs to a thread that has exited
+    auto isRetired = [] (const shared_ptr<detail::TraceRing>& ring) { return ring.use_count() == 1; };
+    for (const auto& ring : m_rings) {
+      if (isRetired(ring)) {
+        m_nRetiredDropped += ring->getNDropped();
+      }
+    }
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), isRetired), m_rings.end());
+
+    newSites.assign(m_sites.begin() + m_nWrittenSites, m_sites.end());
+    nDropped = getNDroppedImpl();
+  }
+
+  std::ostream& os = *m_destination;
+  for (const auto& site : newSites) {
+    writeTraceValue<uint8_t>(os, detail::TRACE_FRAME_SITE);
+    writeTraceValue<uint32_t>(os, static_cast<uint32_t>(m_nWrittenSites++));
+    writeTraceValue<int8_t>(os, static_cast<int8_t>(site.level));
+    writeTraceString(os, site.moduleName);
+    writeTraceString(os, site.format);
+    writeTraceString(os, site.file);
+    writeTraceValue<uint32_t>(os, site.line);
+  }
+
+  os.write(reinterpret_cast<const char*>(m_records.data()), m_records.size());
+
+  if (nDropped > m_nWrittenDropped) {
+    writeTraceValue<uint8_t>(os, detail::TRACE_FRAME_DROPPED);
+    writeTraceValue<int64_t>(os, getTraceTimestamp());
+    writeTraceValue<uint64_t>(os, nDropped - m_nWrittenDropped);
+    m_nWrittenDropped = nDropped;
+  }
+
+  os.flush();
+}
+
+uint64_t
+Trace::getNDropped()
+{
+  auto& trace = get();
+  std::lock_guard<std::mutex> lock(trace.m_mutex);
+  return trace.getNDroppedImpl();
+}
+
+uint64_t
+Trace::getNDroppedImpl() const
+{
+  uint64_t nDropped = m_nRetiredDropped;
+  for (const auto& ring : m_rings) {
+    nDropped += ring->getNDropped();
+  }
+  return nDropped;
+}
+
+void
+Trace::runFlusher(time::milliseconds flushInterval)
+{
+  // ndn::time is based on boost::chrono, while std::condition_variable requires std::chrono
+  const std::chrono::milliseconds interval(flushInterval.count());
+  std::unique_lock<std::mutex> lock(m_flusherMutex);
+  while (!m_flusherCv.wait_for(lock, interval, [this] { return m_shouldStopFlusher; })) {
+    lock.unlock();
+    flushImpl();
+    lock.lock();
+  }
+}
+
+TraceSite::TraceSite(const std::string& moduleName, LogLevel level, const char* format,
+                     const char* file, uint32_t line)
+  : m_id(Trace::get().registerSite({moduleName, level, format, file, line}))
+{
+}
+
+TraceDecoder::TraceDecoder(std::istream& is)
+  : m_is(is)
+{
+  char magic[sizeof(TRACE_MAGIC)];
+  m_is.read(magic, sizeof(magic));
+  if (!m_is || !std::equal(magic, magic + sizeof(magic), TRACE_MAGIC)) {
+    BOOST_THROW_EXCEPTION(Error("input is not a binary trace"));
+  }
+  if (readValue<uint8_t>() != TRACE_VERSION) {
+    BOOST_THROW_EXCEPTION(Error("unsupported binary trace version"));
+  }
+  if (readValue<uint32_t>() != TRACE_BYTE_ORDER) {
+    BOOST_THROW_EXCEPTION(Error("binary trace was written with a different byte order"));
+  }
+}
+
+void
+TraceDecoder::read(void* buf, size_t size)
+{
+  m_is.read(reinterpret_cast<char*>(buf), size);
+  if (static_cast<size_t>(m_is.gcount()) != size) {
+    BOOST_THROW_EXCEPTION(Error("binary trace is truncated"));
+  }
+}
+
+std::string
+TraceDecoder::readString()
+{
+  std::string s(readValue<uint16_t>(), '\0');
+  read(&s[0], s.size());
+  return s;
+}
+
+static void
+writeTraceTimestamp(std::ostream& os, int64_t nanoseconds)
+{
+  // same format as detail::LoggerTimestamp
+  const int_least64_t usecs = nanoseconds / 1000;
+  char buffer[32];
+  ::snprintf(buffer, sizeof(buffer), "%" PRIdLEAST64 ".%06" PRIdLEAST64,
+             usecs / 1000000, usecs % 1000000);
+  os << buffer;
+}
+
+bool
+TraceDecoder::decodeNext(std::ostream& os)
+{
+  while (true) {
+    uint8_t frameType = 0;
+    m_is.read(reinterpret_cast<char*>(&frameType), 1);
+    if (m_is.gcount() == 0) {
+      return false;
+    }
+
+    switch (frameType) {
+      case detail::TRACE_FRAME_SITE: {
+        uint32_t id = readValue<uint32_t>();
+        detail::TraceSiteInfo& site = m_sites[id];
+        site.level = static_cast<LogLevel>(readValue<int8_t>());
+        site.moduleName = readString();
+        site.format = readString();
+        site.file = readString();
+        site.line = readValue<uint32_t>();
+        break;
+      }
+      case detail::TRACE_FRAME_RECORD: {
+        auto it = m_sites.find(readValue<uint32_t>());
+        if (it == m_sites.end()) {
+          BOOST_THROW_EXCEPTION(Error("record refers to an unknown log statement"));
+        }
+        const detail::TraceSiteInfo& site = it->second;
+
+        writeTraceTimestamp(os, readValue<int64_t>());
+        os << ' ';
+        if (site.level == LogLevel::WARN) {
+          os << "WARNING"; // same as NDN_LOG_WARN
+        }
+        else {
+          os << site.level;
+        }
+        os << ": [" << site.moduleName << "] ";
+        const char* format = site.format.data();
+        for (uint8_t nArgs = readValue<uint8_t>(); nArgs > 0; --nArgs) {
+          format = detail::writeTraceFormat(os, format);
+          decodeArgument(os);
+        }
+        os << format << '\n';
+        return true;
+      }
+      case detail::TRACE_FRAME_DROPPED: {
+        writeTraceTimestamp(os, readValue<int64_t>());
+        os << " WARNING: [ndn.util.Trace] " << readValue<uint64_t>() << " records dropped\n";
+        return true;
+      }
+      default:
+        BOOST_THROW_EXCEPTION(Error("unknown frame type " + to_string(frameType)));
+    }
+  }
+}
+
+void
+TraceDecoder::decodeArgument(std::ostream& os)
+{
+  uint8_t type = readValue<uint8_t>();
+  switch (type) {
+    case detail::TRACE_ARG_INT:
+      os << readValue<int64_t>();
+      break;
+    case detail::TRACE_ARG_UINT:
+      os << readValue<uint64_t>();
+      break;
+    case detail::TRACE_ARG_DOUBLE:
+      os << readValue<double>();
+      break;
+    case detail::TRACE_ARG_BOOL:
+      os << static_cast<bool>(readValue<uint8_t>());
+      break;
+    case detail::TRACE_ARG_STRING:
+      os << readString();
+      break;
+    case detail::TRACE_ARG_NAME:
+    case detail::TRACE_ARG_INTEREST: {
+      std::string wire = readString();
+      try {
+        Block block(reinterpret_cast<const uint8_t*>(wire.data()), wire.size());
+        if (type == detail::TRACE_ARG_NAME) {
+          os << Name(block);
+        }
+        else {
+          os << Interest(block);
+        }
+      }
+      catch (const tlv::Error&) {
+        BOOST_THROW_EXCEPTION(Error("record contains a malformed packet"));
+      }
+      break;
+    }
+    default:
+      BOOST_THROW_EXCEPTION(Error("unknown argument type " + to_string(type)));
+  }
+}
+
+} // namespace util
+} // namespace ndn
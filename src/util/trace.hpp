@@ -0,0 +1,508 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_TRACE_HPP
+#define NDN_UTIL_TRACE_HPP
+
+#include "logger.hpp"
+#include "time.hpp"
+#include "detail/trace-ring.hpp"
+
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace ndn {
+
+class Name;
+class Interest;
+
+namespace util {
+
+class TraceSite;
+
+namespace detail {
+
+/** @brief frame types in a binary trace
+ */
+enum TraceFrameType : uint8_t {
+  TRACE_FRAME_SITE    = 1,
+  TRACE_FRAME_RECORD  = 2,
+  TRACE_FRAME_DROPPED = 3
+};
+
+/** @brief argument types in a binary trace record
+ */
+enum TraceArgumentType : uint8_t {
+  TRACE_ARG_INT      = 1,
+  TRACE_ARG_UINT     = 2,
+  TRACE_ARG_DOUBLE   = 3,
+  TRACE_ARG_BOOL     = 4,
+  TRACE_ARG_STRING   = 5,
+  TRACE_ARG_NAME     = 6,
+  TRACE_ARG_INTEREST = 7
+};
+
+/** @brief describes a log statement that records into the binary trace
+ */
+struct TraceSiteInfo
+{
+  std::string moduleName;
+  LogLevel level;
+  std::string format;
+  std::string file;
+  uint32_t line;
+};
+
+/** @brief write @p format up to the first `{}` placeholder
+ *  @return the position after the placeholder; if @p format has no placeholder,
+ *          a space is written and the end of @p format is returned
+ */
+const char*
+writeTraceFormat(std::ostream& os, const char* format);
+
+inline void
+encodeTraceString(TraceRing::Writer& writer, const char* s, size_t size)
+{
+  size = std::min<size_t>(size, std::numeric_limits<uint16_t>::max());
+  writer.writeValue<uint8_t>(TRACE_ARG_STRING);
+  writer.writeValue<uint16_t>(static_cast<uint16_t>(size));
+  writer.write(s, size);
+}
+
+inline void
+encodeTraceArgument(TraceRing::Writer& writer, bool value)
+{
+  writer.writeValue<uint8_t>(TRACE_ARG_BOOL);
+  writer.writeValue<uint8_t>(value);
+}
+
+inline void
+encodeTraceArgument(TraceRing::Writer& writer, char value)
+{
+  encodeTraceString(writer, &value, 1);
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+encodeTraceArgument(TraceRing::Writer& writer, T value)
+{
+  writer.writeValue<uint8_t>(TRACE_ARG_INT);
+  writer.writeValue<int64_t>(value);
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+encodeTraceArgument(TraceRing::Writer& writer, T value)
+{
+  writer.writeValue<uint8_t>(TRACE_ARG_UINT);
+  writer.writeValue<uint64_t>(value);
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+encodeTraceArgument(TraceRing::Writer& writer, T value)
+{
+  writer.writeValue<uint8_t>(TRACE_ARG_DOUBLE);
+  writer.writeValue<double>(value);
+}
+
+inline void
+encodeTraceArgument(TraceRing::Writer& writer, const char* value)
+{
+  encodeTraceString(writer, value, std::strlen(value));
+}
+
+inline void
+encodeTraceArgument(TraceRing::Writer& writer, const std::string& value)
+{
+  encodeTraceString(writer, value.data(), value.size());
+}
+
+/** @brief record @p name as its wire encoding
+ */
+void
+encodeTraceArgument(TraceRing::Writer& writer, const Name& name);
+
+/** @brief record @p interest as its wire encoding
+ */
+void
+encodeTraceArgument(TraceRing::Writer& writer, const Interest& interest);
+
+/** @brief record any other type as its string representation
+ *  @note This formats the argument immediately. Add an overload for types on hot paths.
+ */
+template<typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value>::type
+encodeTraceArgument(TraceRing::Writer& writer, const T& value)
+{
+  std::ostringstream os;
+  os << value;
+  encodeTraceArgument(writer, os.str());
+}
+
+/** @brief a log message with `{}` placeholders that is formatted when written to a stream
+ */
+template<typename... Args>
+class TraceMessage
+{
+public:
+  explicit
+  TraceMessage(const char* format, const Args&... args)
+    : m_format(format)
+    , m_args(args...)
+  {
+  }
+
+  friend std::ostream&
+  operator<<(std::ostream& os, const TraceMessage& msg)
+  {
+    msg.print(os, msg.m_format, std::integral_constant<size_t, 0>());
+    return os;
+  }
+
+private:
+  void
+  print(std::ostream& os, const char* format,
+        std::integral_constant<size_t, sizeof...(Args)>) const
+  {
+    os << format;
+  }
+
+  template<size_t I>
+  void
+  print(std::ostream& os, const char* format, std::integral_constant<size_t, I>) const
+  {
+    format = writeTraceFormat(os, format);
+    os << std::get<I>(m_args);
+    print(os, format, std::integral_constant<size_t, I + 1>());
+  }
+
+private:
+  const char* m_format;
+  std::tuple<const Args&...> m_args;
+};
+
+template<typename... Args>
+TraceMessage<Args...>
+makeTraceMessage(const char* format, const Args&... args)
+{
+  return TraceMessage<Args...>(format, args...);
+}
+
+template<typename... Args>
+const char*
+getTraceFormat(const char* format, const Args&...)
+{
+  return format;
+}
+
+} // namespace detail
+
+/** @brief Controls the binary trace backend of the logging facility.
+ *
+ *  While the binary trace is enabled, log statements written with the NDN_TRACE_* macros do not
+ *  format their message. Each thread appends the ID of the log statement, a timestamp, and the
+ *  raw arguments to its own ring buffer, without taking any lock; a Name is recorded as its wire
+ *  encoding. A background thread periodically moves the records to the destination stream,
+ *  and TraceDecoder, or the ndn-trace-decode tool, renders them afterwards.
+ *
+ *  Severity levels are configured with Logging::setLevel, as for NDN_LOG_* statements.
+ *  While the binary trace is disabled, NDN_TRACE_* statements are formatted and written to the
+ *  Logging destination.
+ *
+ *  If the environment variable `NDN_LOG_TRACE_FILE` is set when the logging facility starts,
+ *  the binary trace is enabled with that file as the destination.
+ *
+ *  If a ring buffer is full, new records of that thread are dropped, and the number of dropped
+ *  records is written to the trace. Records of different threads are not necessarily written
+ *  in chronological order.
+ *
+ *  \note Public static methods are thread safe.
+ */
+class Trace : noncopyable
+{
+public:
+  /** @brief Start writing binary trace records to @p os.
+   *  @param os destination of the binary trace; any previous destination is flushed and released
+   *  @param bufferSize size of the ring buffer of each thread in octets, rounded up to a power
+   *                    of two; it applies to threads that have not recorded anything before
+   *  @param flushInterval interval between two transfers from the ring buffers to @p os
+   *  @throw std::invalid_argument @p os is nullptr or @p flushInterval is not positive
+   */
+  static void
+  enable(shared_ptr<std::ostream> os, size_t bufferSize = DEFAULT_BUFFER_SIZE,
+         time::milliseconds flushInterval = DEFAULT_FLUSH_INTERVAL);
+
+  /** @brief Flush the binary trace and stop recording.
+   */
+  static void
+  disable();
+
+  static bool
+  isEnabled()
+  {
+    return s_isEnabled.load(std::memory_order_relaxed);
+  }
+
+  /** @brief Write all recorded records to the destination stream.
+   */
+  static void
+  flush();
+
+  /** @return number of records dropped because a ring buffer was full
+   */
+  static uint64_t
+  getNDropped();
+
+  /** @brief Record a log statement of @p site in the ring buffer of the calling thread.
+   *  @note Use the NDN_TRACE_* macros instead of calling this function directly.
+   */
+  template<typename... Args>
+  static void
+  record(const TraceSite& site, const char* format, const Args&... args);
+
+public:
+  static const size_t DEFAULT_BUFFER_SIZE;
+  static const time::milliseconds DEFAULT_FLUSH_INTERVAL;
+
+private:
+  Trace();
+
+  ~Trace();
+
+  static Trace&
+  get();
+
+  static detail::TraceRing*
+  getThreadRing();
+
+  shared_ptr<detail::TraceRing>
+  addRing();
+
+  uint32_t
+  registerSite(detail::TraceSiteInfo site);
+
+  void
+  enableImpl(shared_ptr<std::ostream> os, size_t bufferSize, time::milliseconds flushInterval);
+
+  void
+  disableImpl();
+
+  /** @brief flush the binary trace, stop the flusher thread, and release the destination
+   *  @pre m_controlMutex is locked
+   */
+  void
+  stop();
+
+  void
+  flushImpl();
+
+  uint64_t
+  getNDroppedImpl() const;
+
+  void
+  runFlusher(time::milliseconds flushInterval);
+
+private:
+  class RingHolder;
+  friend TraceSite;
+
+  static std::atomic<bool> s_isEnabled;
+
+  std::mutex m_controlMutex; ///< serializes enable and disable
+  mutable std::mutex m_mutex; ///< protects m_rings, m_nRetiredDropped, m_sites, m_bufferSize
+  std::vector<shared_ptr<detail::TraceRing>> m_rings;
+  uint64_t m_nRetiredDropped; ///< dropped records of rings whose thread has exited
+  std::vector<detail::TraceSiteInfo> m_sites; ///< site ID => site
+  size_t m_bufferSize;
+
+  std::mutex m_outputMutex; ///< serializes writes to m_destination
+  shared_ptr<std::ostream> m_destination;
+  size_t m_nWrittenSites;
+  uint64_t m_nWrittenDropped;
+  std::vector<uint8_t> m_records;
+
+  std::mutex m_flusherMutex;
+  std::condition_variable m_flusherCv;
+  bool m_shouldStopFlusher;
+  std::thread m_flusher;
+};
+
+/** @brief Represents a log statement that can record into the binary trace.
+ *
+ *  \note TraceSite objects are created by the NDN_TRACE_* macros.
+ */
+class TraceSite : noncopyable
+{
+public:
+  TraceSite(const std::string& moduleName, LogLevel level, const char* format,
+            const char* file, uint32_t line);
+
+  uint32_t
+  getId() const
+  {
+    return m_id;
+  }
+
+private:
+  const uint32_t m_id;
+};
+
+template<typename... Args>
+void
+Trace::record(const TraceSite& site, const char* format, const Args&... args)
+{
+  static_assert(sizeof...(Args) <= std::numeric_limits<uint8_t>::max(), "too many arguments");
+
+  detail::TraceRing* ring = getThreadRing();
+  if (ring == nullptr) {
+    return;
+  }
+
+  auto writer = ring->startRecord();
+  writer.writeValue<uint8_t>(detail::TRACE_FRAME_RECORD);
+  writer.writeValue<uint32_t>(site.getId());
+  writer.writeValue<int64_t>(time::duration_cast<time::nanoseconds>(
+                               time::system_clock::now().time_since_epoch()).count());
+  writer.writeValue<uint8_t>(sizeof...(Args));
+  using expand = int[];
+  (void)expand{0, (detail::encodeTraceArgument(writer, args), 0)...};
+  ring->commit(writer);
+}
+
+/** @brief Renders a binary trace written by Trace.
+ */
+class TraceDecoder : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** @brief Start decoding the binary trace in @p is.
+   *  @throw Error @p is does not start with a binary trace header
+   */
+  explicit
+  TraceDecoder(std::istream& is);
+
+  /** @brief Render the next record, in the format of NDN_LOG_* messages, as a line in @p os.
+   *  @return false if the end of the trace has been reached
+   *  @throw Error the trace is truncated or malformed
+   */
+  bool
+  decodeNext(std::ostream& os);
+
+private:
+  void
+  read(void* buf, size_t size);
+
+  template<typename T>
+  T
+  readValue()
+  {
+    T value;
+    read(&value, sizeof(value));
+    return value;
+  }
+
+  std::string
+  readString();
+
+  void
+  decodeArgument(std::ostream& os);
+
+private:
+  std::istream& m_is;
+  std::unordered_map<uint32_t, detail::TraceSiteInfo> m_sites;
+};
+
+/** \cond */
+#ifdef HAVE_NDN_CXX_CUSTOM_LOGGER
+// implementation detail
+#define NDN_TRACE_INTERNAL(lvl, lvlstr, ...) \
+  NDN_LOG_##lvl(::ndn::util::detail::makeTraceMessage(__VA_ARGS__))
+#else
+// implementation detail
+#define NDN_TRACE_INTERNAL(lvl, lvlstr, ...) \
+  do { \
+    if (ndn_cxx_getLogger().isLevelEnabled(::ndn::util::LogLevel::lvl)) { \
+      if (::ndn::util::Trace::isEnabled()) { \
+        static const ::ndn::util::TraceSite ndn_cxx_traceSite(ndn_cxx_getLogger().getModuleName(), \
+          ::ndn::util::LogLevel::lvl, ::ndn::util::detail::getTraceFormat(__VA_ARGS__), \
+          __FILE__, __LINE__); \
+        ::ndn::util::Trace::record(ndn_cxx_traceSite, __VA_ARGS__); \
+      } \
+      else { \
+        NDN_BOOST_LOG(ndn_cxx_getLogger()) << ::ndn::util::detail::LoggerTimestamp{} \
+          << " " BOOST_STRINGIZE(lvlstr) ": [" << ndn_cxx_getLogger().getModuleName() << "] " \
+          << ::ndn::util::detail::makeTraceMessage(__VA_ARGS__); \
+      } \
+    } \
+  } while (false)
+#endif // HAVE_NDN_CXX_CUSTOM_LOGGER
+/** \endcond */
+
+/** \brief Log at TRACE level with deferred formatting.
+ *
+ *  The arguments are a format string, in which each `{}` is replaced by the next argument,
+ *  followed by the arguments, e.g., `NDN_TRACE_DEBUG(">D {}", data.getName())`.
+ *  \pre A log module must be declared in the same translation unit, class, struct, or namespace.
+ *  \sa Trace
+ */
+#define NDN_TRACE_TRACE(...) NDN_TRACE_INTERNAL(TRACE, TRACE, __VA_ARGS__)
+
+/** \brief Log at DEBUG level with deferred formatting.
+ *  \sa NDN_TRACE_TRACE
+ */
+#define NDN_TRACE_DEBUG(...) NDN_TRACE_INTERNAL(DEBUG, DEBUG, __VA_ARGS__)
+
+/** \brief Log at INFO level with deferred formatting.
+ *  \sa NDN_TRACE_TRACE
+ */
+#define NDN_TRACE_INFO(...) NDN_TRACE_INTERNAL(INFO, INFO, __VA_ARGS__)
+
+/** \brief Log at WARN level with deferred formatting.
+ *  \sa NDN_TRACE_TRACE
+ */
+#define NDN_TRACE_WARN(...) NDN_TRACE_INTERNAL(WARN, WARNING, __VA_ARGS__)
+
+/** \brief Log at ERROR level with deferred formatting.
+ *  \sa NDN_TRACE_TRACE
+ */
+#define NDN_TRACE_ERROR(...) NDN_TRACE_INTERNAL(ERROR, ERROR, __VA_ARGS__)
+
+/** \brief Log at FATAL level with deferred formatting.
+ *  \sa NDN_TRACE_TRACE
+ */
+#define NDN_TRACE_FATAL(...) NDN_TRACE_INTERNAL(FATAL, FATAL, __VA_ARGS__)
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_TRACE_HPP
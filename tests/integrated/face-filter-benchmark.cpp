@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face InterestFilter Benchmark
+
+#include "util/dummy-client-face.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+
+BOOST_AUTO_TEST_CASE(DispatchInterests)
+{
+  const size_t nInterests = 10000;
+
+  for (size_t nFilters : {100, 1000, 10000}) {
+    boost::asio::io_service io;
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+    DummyClientFace face(io, keyChain, DummyClientFace::Options(false, false));
+
+    size_t nDispatched = 0;
+    for (size_t i = 0; i < nFilters; ++i) {
+      // one filter in ten carries a regular expression, like a Dispatcher dataset
+      InterestFilter filter = i % 10 == 0 ?
+                              InterestFilter(Name("/localhost/benchmark").appendNumber(i), "<>*") :
+                              InterestFilter(Name("/localhost/benchmark").appendNumber(i));
+      face.setInterestFilter(filter, [&] (const InterestFilter&, const Interest&) { ++nDispatched; });
+    }
+    io.poll();
+
+    std::vector<Interest> interests;
+    for (size_t i = 0; i < nInterests; ++i) {
+      interests.emplace_back(Name("/localhost/benchmark").appendNumber(i % nFilters)
+                             .append("command").appendNumber(i));
+      interests.back().wireEncode();
+    }
+
+    auto d = timedExecute([&] {
+      for (const auto& interest : interests) {
+        face.receive(interest);
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nDispatched, nInterests);
+    std::cout << "dispatch " << nInterests << " Interests with " << nFilters << " filters: "
+              << d << ", " << (d / nInterests) << " per Interest" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace ndn
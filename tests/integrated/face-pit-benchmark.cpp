@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face PIT Benchmark
+
+#include "util/dummy-client-face.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+
+BOOST_AUTO_TEST_CASE(SatisfyPendingInterests)
+{
+  const size_t nData = 1000;
+
+  for (size_t pitSize : {1000, 10000, 50000}) {
+    boost::asio::io_service io;
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+    DummyClientFace face(io, keyChain, DummyClientFace::Options(false, false));
+
+    size_t nSatisfied = 0;
+    for (size_t i = 0; i < pitSize; ++i) {
+      Interest interest(Name("/localhost/benchmark").appendNumber(i).append("segment"));
+      interest.setInterestLifetime(1_h);
+      face.expressInterest(interest, [&] (const Interest&, const Data&) { ++nSatisfied; },
+                           nullptr, nullptr);
+    }
+    io.poll();
+    BOOST_REQUIRE_EQUAL(face.getNPendingInterests(), pitSize);
+
+    std::vector<shared_ptr<Data>> data;
+    for (size_t i = 0; i < nData; ++i) {
+      data.push_back(makeData(Name("/localhost/benchmark").appendNumber(i * pitSize / nData)
+                              .append("segment").appendSegment(0)));
+      data.back()->wireEncode();
+    }
+
+    auto d = timedExecute([&] {
+      for (const auto& datum : data) {
+        face.receive(*datum);
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nSatisfied, nData);
+    BOOST_CHECK_EQUAL(face.getNPendingInterests(), pitSize - nData);
+    std::cout << "satisfy " << nData << " Data with " << pitSize << " pending Interests: "
+              << d << ", " << (d / nData) << " per Data" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace ndn
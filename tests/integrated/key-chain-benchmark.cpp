@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx KeyChain Benchmark
+
+#include "security/v2/key-chain.hpp"
+#include "security/signing-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/filesystem.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+class KeyChainBenchmarkFixture
+{
+public:
+  KeyChainBenchmarkFixture()
+    : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+    , pibLocator("pib-sqlite3:" + path.string())
+    , tpmLocator("tpm-file:" + path.string())
+  {
+    KeyChain keyChain(pibLocator, tpmLocator);
+    for (size_t i = 0; i < nIdentities; ++i) {
+      identities.push_back(keyChain.createIdentity(Name("/benchmark").appendNumber(i),
+                                                   EcKeyParams()).getName());
+    }
+  }
+
+  ~KeyChainBenchmarkFixture()
+  {
+    boost::filesystem::remove_all(path);
+  }
+
+public:
+  static const size_t nIdentities = 200;
+  boost::filesystem::path path;
+  std::string pibLocator;
+  std::string tpmLocator;
+  std::vector<Name> identities;
+};
+
+BOOST_FIXTURE_TEST_CASE(StartupToFirstSignature, KeyChainBenchmarkFixture)
+{
+  unique_ptr<KeyChain> keyChain;
+  Data data("/benchmark/data");
+
+  auto d = timedExecute([&] {
+    keyChain = make_unique<KeyChain>(pibLocator, tpmLocator);
+    keyChain->sign(data);
+  });
+  std::cout << "startup to first signature with " << nIdentities << " identities: "
+            << d << std::endl;
+
+  for (int round = 1; round <= 2; ++round) {
+    d = timedExecute([&] {
+      for (const auto& identity : identities) {
+        keyChain->sign(data, signingByIdentity(identity));
+      }
+    });
+    std::cout << "round " << round << ": sign with each of " << nIdentities << " identities: "
+              << d << " (" << d / nIdentities << " per signature)" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Regex Benchmark
+
+#include "util/regex.hpp"
+#include "util/regex/regex-pattern-list-matcher.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(TrustSchemaRules)
+{
+  // rules and names typical of validator configurations and trust schemas
+  const std::vector<std::string> exprs = {
+    "^(<>*)<KEY><>$",
+    "^([^<KEY>]*)<KEY>(<>*)<ksk-.*><ID-CERT>$",
+    "^<ndn><edu><ucla>(<>*)<KEY><>{1,3}$",
+    "<>*<ID-CERT><>*",
+    "^<localhost><nfd><fib><add-nexthop>$",
+    "^<ndn><edu><ucla><>*<KEY><>$",
+  };
+  const std::vector<Name> names = {
+    "/ndn/edu/ucla/alice/KEY/%01%02",
+    "/ndn/edu/ucla/alice/KEY/ksk-1416425377094/ID-CERT/%FD%00",
+    "/ndn/edu/ucla/alice/papers/2018/draft.pdf/%FD%01/%00%00",
+    "/ndn/edu/arizona/bob/KEY/dsk-1/%12/%34/%56",
+    "/localhost/nfd/fib/add-nexthop",
+    "/localhost/nfd/rib/register/%08%07/%01",
+    "/ndn/org/caida/KEY/ksk-1/ID-CERT",
+    "/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p",
+  };
+  const size_t nRepeats = 2000;
+
+  for (const auto& expr : exprs) {
+    Regex re(expr);
+    size_t nLegacyMatched = 0;
+    auto legacy = timedExecute([&] {
+      for (size_t i = 0; i < nRepeats; ++i) {
+        for (const auto& name : names) {
+          if (re.m_primaryMatcher->match(name, 0, name.size()) ||
+              (re.m_secondaryMatcher != nullptr &&
+               re.m_secondaryMatcher->match(name, 0, name.size()))) {
+            ++nLegacyMatched;
+          }
+        }
+      }
+    });
+
+    size_t nMatched = 0;
+    auto d = timedExecute([&] {
+      for (size_t i = 0; i < nRepeats; ++i) {
+        for (const auto& name : names) {
+          if (re.match(name)) {
+            ++nMatched;
+          }
+        }
+      }
+    });
+
+    BOOST_CHECK(re.m_automaton != nullptr);
+    BOOST_CHECK_EQUAL(nMatched, nLegacyMatched);
+    size_t nMatches = nRepeats * names.size();
+    std::cout << expr << ": " << nMatches << " matches, matcher tree " << legacy
+              << " (" << legacy / nMatches << " per name), automaton " << d
+              << " (" << d / nMatches << " per name)" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace ndn
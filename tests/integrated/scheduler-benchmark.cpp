@@ -38,56 +38,90 @@ namespace tests {
 
 using namespace ndn::tests;
 
+const EventQueueType QUEUE_TYPES[] = {EventQueueType::ORDERED_SET, EventQueueType::TIMER_WHEEL};
+
 BOOST_AUTO_TEST_CASE(ScheduleCancel)
 {
-  boost::asio::io_service io;
-  Scheduler sched(io);
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
+
+    const size_t nEvents = 1000000;
+    std::vector<EventId> eventIds(nEvents);
+
+    auto d1 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        eventIds[i] = sched.scheduleEvent(1_s, []{});
+      }
+    });
+
+    auto d2 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        sched.cancelEvent(eventIds[i]);
+      }
+    });
+
+    std::cout << "[" << queueType << "] schedule " << nEvents << " events: " << d1 << std::endl;
+    std::cout << "[" << queueType << "] cancel " << nEvents << " events: " << d2 << std::endl;
+  }
+}
 
-  const size_t nEvents = 1000000;
-  std::vector<EventId> eventIds(nEvents);
+BOOST_AUTO_TEST_CASE(ScheduleCancelSpread)
+{
+  // 1M outstanding events with distinct timeouts, as with many pending Interests
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
+
+    const size_t nEvents = 1000000;
+    std::vector<EventId> eventIds(nEvents);
+
+    auto d1 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        eventIds[i] = sched.scheduleEvent(time::milliseconds(1000 + i % 4000), []{});
+      }
+    });
+
+    auto d2 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        sched.cancelEvent(eventIds[(i * 7919) % nEvents]);
+      }
+    });
+
+    std::cout << "[" << queueType << "] schedule " << nEvents << " spread events: " << d1 << std::endl;
+    std::cout << "[" << queueType << "] cancel " << nEvents << " spread events: " << d2 << std::endl;
+  }
+}
 
-  auto d1 = timedExecute([&] {
-    for (size_t i = 0; i < nEvents; ++i) {
-      eventIds[i] = sched.scheduleEvent(1_s, []{});
-    }
-  });
+BOOST_AUTO_TEST_CASE(Execute)
+{
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
+
+    const size_t nEvents = 1000000;
+    size_t nExpired = 0;
+
+    // Events should expire at t1, but execution finishes at t2. The difference is the overhead.
+    time::steady_clock::TimePoint t1 = time::steady_clock::now() + 5_s;
+    time::steady_clock::TimePoint t2;
 
-  auto d2 = timedExecute([&] {
     for (size_t i = 0; i < nEvents; ++i) {
-      sched.cancelEvent(eventIds[i]);
+      sched.scheduleEvent(t1 - time::steady_clock::now(), [&] { ++nExpired; });
     }
-  });
 
-  std::cout << "schedule " << nEvents << " events: " << d1 << std::endl;
-  std::cout << "cancel " << nEvents << " events: " << d2 << std::endl;
-}
+    // +1ms ensures this extra event is executed last. In case the overhead is less than 1ms,
+    // it will be reported as 1ms.
+    sched.scheduleEvent(t1 - time::steady_clock::now() + 1_ms, [&] {
+      t2 = time::steady_clock::now();
+      BOOST_REQUIRE_EQUAL(nExpired, nEvents);
+    });
 
-BOOST_AUTO_TEST_CASE(Execute)
-{
-  boost::asio::io_service io;
-  Scheduler sched(io);
-
-  const size_t nEvents = 1000000;
-  size_t nExpired = 0;
-
-  // Events should expire at t1, but execution finishes at t2. The difference is the overhead.
-  time::steady_clock::TimePoint t1 = time::steady_clock::now() + 5_s;
-  time::steady_clock::TimePoint t2;
-  // +1ms ensures this extra event is executed last. In case the overhead is less than 1ms,
-  // it will be reported as 1ms.
-  sched.scheduleEvent(t1 - time::steady_clock::now() + 1_ms, [&] {
-    t2 = time::steady_clock::now();
-    BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  });
+    io.run();
 
-  for (size_t i = 0; i < nEvents; ++i) {
-    sched.scheduleEvent(t1 - time::steady_clock::now(), [&] { ++nExpired; });
+    BOOST_REQUIRE_EQUAL(nExpired, nEvents);
+    std::cout << "[" << queueType << "] execute " << nEvents << " events: " << (t2 - t1) << std::endl;
   }
-
-  io.run();
-
-  BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  std::cout << "execute " << nEvents << " events: " << (t2 - t1) << std::endl;
 }
 
 } // namespace tests
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Trace Benchmark
+
+#include "util/trace.hpp"
+#include "util/logging.hpp"
+#include "name.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+NDN_LOG_INIT(ndn.util.tests.TraceBenchmark);
+
+template<typename F>
+static time::nanoseconds
+runOnThreads(size_t nThreads, const F& f)
+{
+  return timedExecute([&] {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; ++i) {
+      threads.emplace_back(f);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(PacketLog)
+{
+  // names of received packets have a wire encoding, like the names logged by Face
+  const size_t nNames = 1000;
+  std::vector<Name> names;
+  for (size_t i = 0; i < nNames; ++i) {
+    names.push_back(Name("/ndn/edu/ucla/alice/papers/2018/draft.pdf").appendVersion(1).appendSegment(i));
+    names.back().wireEncode();
+  }
+  const size_t nRepeats = 100;
+  const size_t nRecords = nNames * nRepeats;
+
+  Logging::setLevel("ndn.util.tests.TraceBenchmark", LogLevel::DEBUG);
+  Logging::setDestination(make_shared<std::ofstream>("/dev/null"));
+
+  for (size_t nThreads : {1, 4}) {
+    auto textTime = runOnThreads(nThreads, [&] {
+      for (size_t j = 0; j < nRepeats; ++j) {
+        for (const auto& name : names) {
+          NDN_LOG_DEBUG(">D " << name);
+        }
+      }
+    });
+    Logging::flush();
+
+    // large rings, so that no record is dropped without periodic flushing
+    Trace::enable(make_shared<std::ofstream>("/dev/null", std::ios::binary), 1 << 27);
+    auto traceTime = runOnThreads(nThreads, [&] {
+      for (size_t j = 0; j < nRepeats; ++j) {
+        for (const auto& name : names) {
+          NDN_TRACE_DEBUG(">D {}", name);
+        }
+      }
+    });
+    uint64_t nDropped = Trace::getNDropped();
+    Trace::disable();
+
+    std::cout << "[" << nThreads << " threads] NDN_LOG_DEBUG   " << nRecords * nThreads << " names: "
+              << textTime << " (" << textTime.count() / (nRecords * nThreads) << " ns/record)\n"
+              << "[" << nThreads << " threads] NDN_TRACE_DEBUG " << nRecords * nThreads << " names: "
+              << traceTime << " (" << traceTime.count() / (nRecords * nThreads) << " ns/record, "
+              << nDropped << " dropped)" << std::endl;
+    BOOST_CHECK_LT(traceTime, textTime);
+  }
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
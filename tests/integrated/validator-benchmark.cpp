@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Validator Benchmark
+
+#include "security/v2/validator.hpp"
+#include "security/v2/certificate-fetcher-offline.hpp"
+#include "security/v2/key-chain.hpp"
+#include "security/v2/validation-policy-simple-hierarchy.hpp"
+#include "security/signing-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_CASE(EcdsaData)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity identity = keyChain.createIdentity("/benchmark", EcKeyParams());
+
+  const size_t nPackets = 10000;
+  std::vector<Data> packets;
+  packets.reserve(nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    Data data(Name("/benchmark/data").appendSegment(i));
+    data.setContent(make_shared<Buffer>(1024));
+    keyChain.sign(data, signingByIdentity(identity));
+    packets.push_back(std::move(data));
+  }
+
+  // 0 threads: verify on the calling thread
+  for (size_t nThreads : {0, 1, 2, 4, 8}) {
+    boost::asio::io_service io;
+    Validator validator(make_unique<ValidationPolicySimpleHierarchy>(),
+                        make_unique<CertificateFetcherOffline>());
+    validator.loadAnchor("", Certificate(identity.getDefaultKey().getDefaultCertificate()));
+    if (nThreads > 0) {
+      validator.setVerificationPool(make_shared<VerificationPool>(io, nThreads));
+    }
+
+    size_t nValidated = 0;
+    size_t nFailed = 0;
+    auto d = timedExecute([&] {
+      for (const auto& data : packets) {
+        validator.validate(data,
+                           [&] (const Data&) {
+                             if (++nValidated + nFailed == nPackets)
+                               io.stop();
+                           },
+                           [&] (const Data&, const ValidationError&) {
+                             if (nValidated + ++nFailed == nPackets)
+                               io.stop();
+                           });
+      }
+      if (nValidated + nFailed < nPackets) {
+        boost::asio::io_service::work work(io);
+        io.run();
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nValidated, nPackets);
+    BOOST_CHECK_EQUAL(nFailed, 0);
+    std::cout << "[" << nThreads << " threads] validate " << nPackets << " Data: " << d
+              << " (" << nPackets * 1000000000.0 / d.count() << " Data/s)" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx ValidatorConfig Rule Benchmark
+
+#include "security/v2/validator-config/rule-index.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_CASE(FindRule)
+{
+  const size_t nLookups = 10000;
+
+  for (size_t nSites : {10, 100, 1000}) {
+    // each site has a trust schema of a name rule and two regex rules, as in NFD deployments
+    std::vector<unique_ptr<Rule>> rules;
+    for (size_t i = 0; i < nSites; ++i) {
+      Name site = Name("/ndn/site").appendNumber(i);
+      rules.push_back(make_unique<Rule>("data-" + to_string(i), tlv::Data));
+      rules.back()->addFilter(make_unique<RelationNameFilter>(Name(site).append("data"),
+                                                              NameRelation::IS_STRICT_PREFIX_OF));
+      rules.push_back(make_unique<Rule>("cert-" + to_string(i), tlv::Data));
+      rules.back()->addFilter(make_unique<RegexNameFilter>(
+        Regex("^<ndn><site><" + site[-1].toUri() + "><KEY><>{1,3}$")));
+      rules.push_back(make_unique<Rule>("user-" + to_string(i), tlv::Data));
+      rules.back()->addFilter(make_unique<RegexNameFilter>(
+        Regex("^<ndn><site><" + site[-1].toUri() + "><user>[^<KEY>]+<KEY><>{1,3}$")));
+    }
+
+    RuleIndex index(tlv::Data);
+    for (const auto& rule : rules) {
+      index.insert(*rule);
+    }
+
+    std::vector<Name> names;
+    for (size_t i = 0; i < nLookups; ++i) {
+      Name site = Name("/ndn/site").appendNumber(i * 7919 % nSites);
+      switch (i % 3) {
+        case 0:
+          names.push_back(Name(site).append("data").appendSegment(i));
+          break;
+        case 1:
+          names.push_back(Name(site).append("KEY").append("ksk-1"));
+          break;
+        case 2:
+          names.push_back(Name(site).append("user").append("alice").append("KEY").append("k"));
+          break;
+      }
+    }
+
+    size_t nLinearMatched = 0;
+    auto linear = timedExecute([&] {
+      for (const auto& name : names) {
+        for (const auto& rule : rules) {
+          if (rule->match(tlv::Data, name)) {
+            ++nLinearMatched;
+            break;
+          }
+        }
+      }
+    });
+
+    index.find(names.front()); // compile the automata
+    size_t nMatched = 0;
+    auto d = timedExecute([&] {
+      for (const auto& name : names) {
+        if (index.find(name) != nullptr) {
+          ++nMatched;
+        }
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nLinearMatched, nLookups);
+    BOOST_CHECK_EQUAL(nMatched, nLookups);
+    std::cout << rules.size() << " rules, " << nLookups << " lookups: linear scan " << linear
+              << " (" << linear / nLookups << " per lookup), index " << d
+              << " (" << d / nLookups << " per lookup)" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -343,6 +343,39 @@ BOOST_AUTO_TEST_CASE(UnrecognizedCriticalElement)
 
 BOOST_AUTO_TEST_SUITE_END() // Decode03
 
+BOOST_FIXTURE_TEST_CASE(DecodeLazy, DataSigningKeyFixture)
+{
+  Data d;
+  d.wireDecode(Block(DATA1, sizeof(DATA1)), true);
+  BOOST_CHECK_EQUAL(d.getName(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), 10_s);
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), tlv::SignatureSha256WithRsa);
+  BOOST_CHECK_EQUAL(d.getSignature().getKeyLocator().getName(), "/test/key/locator");
+  BOOST_CHECK(security::verifySignature(d, m_pubKey));
+  BOOST_CHECK_EQUAL(d, Data(Block(DATA1, sizeof(DATA1))));
+
+  // malformed MetaInfo is reported on first access
+  Block malformed = "060E 0700 1405180301020316031B0100"_block;
+  BOOST_CHECK_THROW(Data{malformed}, tlv::Error);
+  d.wireDecode(malformed, true);
+  BOOST_CHECK_EQUAL(d.getName(), "/");
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), tlv::DigestSha256);
+  BOOST_CHECK_THROW(d.getMetaInfo(), tlv::Error);
+  BOOST_CHECK_THROW(d.getContentType(), tlv::Error);
+
+  // structural errors are still detected
+  BOOST_CHECK_THROW(d.wireDecode("0605 0700 1500 FF"_block, true), tlv::Error);
+  BOOST_CHECK_THROW(d.wireDecode("0604 0700 1500"_block, true), Data::Error);
+
+  // deferred fields are decoded before the wire encoding is discarded
+  d.wireDecode("062C 0703080144 16031B0100 "
+               "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block, true);
+  d.setName("/E");
+  BOOST_CHECK_EQUAL(d.wireEncode(),
+    "0630 0703080145 1400 1500 16031B0100 "
+    "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block);
+}
+
 BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
 {
   Data d(Name("/local/ndn/prefix"));
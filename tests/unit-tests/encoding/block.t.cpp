@@ -272,6 +272,41 @@ BOOST_AUTO_TEST_CASE(FromWireBuffer)
   BOOST_CHECK(!isOk);
 }
 
+BOOST_AUTO_TEST_CASE(FromWireBufferRange)
+{
+  auto buffer = make_shared<Buffer>(TEST_BUFFER, sizeof(TEST_BUFFER));
+  // the last element is complete, but lies beyond the usable range
+  (*buffer)[7] = 0x01;
+  const Buffer::const_iterator end = buffer->begin() + 8;
+
+  Buffer::const_iterator pos = buffer->begin();
+  bool isOk = false;
+  Block b;
+  std::tie(isOk, b) = Block::fromBuffer(buffer, pos, end);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(b.type(), 0);
+  BOOST_CHECK_EQUAL(b.size(), 3);
+  BOOST_CHECK_EQUAL(b.value_size(), 1);
+  BOOST_CHECK_EQUAL(*b.value(), 0xfa);
+  BOOST_CHECK(b.getBuffer() == buffer); // no copy
+  pos += b.size();
+
+  std::tie(isOk, b) = Block::fromBuffer(buffer, pos, end);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(b.type(), 1);
+  BOOST_CHECK_EQUAL(*b.value(), 0xfb);
+  BOOST_CHECK(b.getBuffer() == buffer);
+  pos += b.size();
+
+  std::tie(isOk, b) = Block::fromBuffer(buffer, pos, end);
+  BOOST_CHECK(!isOk);
+
+  std::tie(isOk, b) = Block::fromBuffer(buffer, pos, buffer->end());
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(b.type(), 3);
+  BOOST_CHECK_EQUAL(b.value_size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(FromRawBuffer)
 {
   size_t offset = 0;
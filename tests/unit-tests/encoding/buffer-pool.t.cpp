@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/buffer-pool.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+class BufferPoolFixture
+{
+public:
+  BufferPoolFixture()
+    : pool(BufferPool::get())
+  {
+    pool.clear();
+    pool.setCapacity(BufferPool::DEFAULT_CAPACITY);
+  }
+
+  ~BufferPoolFixture()
+  {
+    pool.clear();
+    pool.setCapacity(BufferPool::DEFAULT_CAPACITY);
+  }
+
+public:
+  BufferPool& pool;
+};
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_FIXTURE_TEST_SUITE(TestBufferPool, BufferPoolFixture)
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  BufferPool::Counters before = pool.getCounters();
+
+  shared_ptr<Buffer> b1 = pool.allocate(100);
+  BOOST_CHECK_EQUAL(b1->size(), 100);
+  BOOST_CHECK(std::all_of(b1->begin(), b1->end(), [] (uint8_t x) { return x == 0; }));
+  std::fill(b1->begin(), b1->end(), 0xBB);
+  const uint8_t* storage = b1->data();
+  b1.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  // same size class
+  shared_ptr<Buffer> b2 = pool.allocate(200);
+  BOOST_CHECK_EQUAL(b2->size(), 200);
+  BOOST_CHECK_EQUAL(b2->data(), storage);
+  BOOST_CHECK(std::all_of(b2->begin(), b2->end(), [] (uint8_t x) { return x == 0; }));
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  const uint8_t wire[] = {0x01, 0x02, 0x03};
+  shared_ptr<Buffer> b3 = pool.allocate(wire, sizeof(wire));
+  BOOST_CHECK_EQUAL_COLLECTIONS(b3->begin(), b3->end(), wire, wire + sizeof(wire));
+
+  const BufferPool::Counters& after = pool.getCounters();
+  BOOST_CHECK_EQUAL(after.nAllocations - before.nAllocations, 3);
+  BOOST_CHECK_EQUAL(after.nHits - before.nHits, 1);
+  BOOST_CHECK_EQUAL(after.nRecycled - before.nRecycled, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SizeClasses)
+{
+  shared_ptr<Buffer> small = pool.allocate(BufferPool::SIZE_CLASSES.front());
+  const uint8_t* smallStorage = small->data();
+  small.reset();
+
+  // a larger request cannot reuse a Buffer from a smaller size class
+  shared_ptr<Buffer> large = pool.allocate(BufferPool::SIZE_CLASSES.back());
+  BOOST_CHECK_NE(large->data(), smallStorage);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  large.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  // oversized Buffers are not retained
+  shared_ptr<Buffer> oversized = pool.allocate(BufferPool::SIZE_CLASSES.back() + 1);
+  BOOST_CHECK_EQUAL(oversized->size(), BufferPool::SIZE_CLASSES.back() + 1);
+  oversized.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  // a Buffer that has grown beyond the largest size class is not retained
+  shared_ptr<Buffer> grown = pool.allocate(10);
+  grown->resize(BufferPool::SIZE_CLASSES.back() * 2);
+  grown.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  std::vector<shared_ptr<Buffer>> buffers;
+  for (int i = 0; i < 4; ++i) {
+    buffers.push_back(pool.allocate(10));
+  }
+  pool.setCapacity(2);
+  buffers.clear();
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  pool.setCapacity(1);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  pool.setCapacity(0);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  pool.allocate(10).reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseOnOtherThread)
+{
+  shared_ptr<Buffer> buffer = pool.allocate(10);
+  size_t otherPoolSize = 0;
+  std::thread t([&] {
+    buffer.reset();
+    otherPoolSize = BufferPool::get().size();
+  });
+  t.join();
+
+  BOOST_CHECK_EQUAL(otherPoolSize, 1);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
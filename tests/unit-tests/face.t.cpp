@@ -646,6 +646,23 @@ BOOST_AUTO_TEST_CASE(SimilarFilters)
   BOOST_CHECK_EQUAL(nInInterests3, 0);
 }
 
+BOOST_AUTO_TEST_CASE(FiltersInvokedInInsertionOrder)
+{
+  std::vector<std::string> invoked;
+  for (const std::string& prefix : {"/Hello/World", "/", "/Hello", "/Hello/World/%21/more"}) {
+    face.setInterestFilter(prefix, [&invoked, prefix] (const InterestFilter&, const Interest&) {
+      invoked.push_back(prefix);
+    });
+  }
+  advanceClocks(25_ms, 4);
+
+  face.receive(Interest("/Hello/World/%21"));
+  advanceClocks(25_ms, 4);
+
+  std::vector<std::string> expected{"/Hello/World", "/", "/Hello"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(invoked.begin(), invoked.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(SetRegexFilterError)
 {
   face.setInterestFilter(InterestFilter("/Hello/World", "<><b><c>?"),
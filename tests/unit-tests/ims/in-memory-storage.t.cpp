@@ -1048,6 +1048,54 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   BOOST_CHECK_EQUAL(find(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactNameWithoutCanBePrefix)
+{
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+  insert(3, "ndn:/A/C");
+  Name n4 = insert(4, "ndn:/E");
+  Name n5 = insert(5, "ndn:/E");
+  insert(6, "ndn:/F", 500_ms);
+
+  startInterest("ndn:/A")
+    .setCanBePrefix(false);
+  BOOST_CHECK_EQUAL(find(), 1);
+
+  startInterest("ndn:/A/B")
+    .setCanBePrefix(false);
+  BOOST_CHECK_EQUAL(find(), 2);
+
+  startInterest("ndn:/A/D")
+    .setCanBePrefix(false);
+  BOOST_CHECK_EQUAL(find(), 0);
+
+  startInterest("ndn:/A/B/C")
+    .setCanBePrefix(false);
+  BOOST_CHECK_EQUAL(find(), 0);
+
+  // several Data with the same Name: ChildSelector orders them by implicit digest
+  startInterest("ndn:/E")
+    .setCanBePrefix(false)
+    .setChildSelector(0);
+  BOOST_CHECK_EQUAL(find(), n4 < n5 ? 4 : 5);
+  startInterest("ndn:/E")
+    .setCanBePrefix(false)
+    .setChildSelector(1);
+  BOOST_CHECK_EQUAL(find(), n4 < n5 ? 5 : 4);
+
+  startInterest("ndn:/F")
+    .setCanBePrefix(false)
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 6);
+
+  advanceClocks(1000_ms);
+  BOOST_CHECK_EQUAL(find(), 0);
+  startInterest("ndn:/F")
+    .setCanBePrefix(false)
+    .setMustBeFresh(false);
+  BOOST_CHECK_EQUAL(find(), 6);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorage
 BOOST_AUTO_TEST_SUITE_END() // Ims
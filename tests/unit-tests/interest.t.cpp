@@ -250,6 +250,36 @@ BOOST_AUTO_TEST_CASE(UnrecognizedCriticalElement)
 
 BOOST_AUTO_TEST_SUITE_END() // Decode03
 
+BOOST_AUTO_TEST_CASE(DecodeLazy)
+{
+  Interest i;
+  i.wireDecode("0531 0714 08056C6F63616C 08036E646E 0806707265666978 09030D0101 0A0401000000 0C0203E8 "
+               "1E0A 1F08 1E0101 0703080141"_block, true);
+  BOOST_CHECK_EQUAL(i.getName(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(i.getNonce(), 1);
+  BOOST_CHECK_EQUAL(i.getInterestLifetime(), 1000_ms);
+  BOOST_CHECK_EQUAL(i.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getForwardingHint(), DelegationList({{1, "/A"}}));
+
+  // v0.3 ForwardingHint
+  i.wireDecode("0521 0703080149 1E14 1F081E01020703080141 1F081E01010703080142 0A0401000000"_block, true);
+  BOOST_CHECK_EQUAL(i.getCanBePrefix(), false);
+  BOOST_CHECK_EQUAL(i.getForwardingHint(), DelegationList({{1, "/B"}, {2, "/A"}}));
+
+  // malformed Selectors is reported on first access
+  Block malformed = "0512 0703080149 09050D03010203 0A0401000000"_block;
+  BOOST_CHECK_THROW(Interest{malformed}, tlv::Error);
+  i.wireDecode(malformed, true);
+  BOOST_CHECK_EQUAL(i.getName(), "/I");
+  BOOST_CHECK_EQUAL(i.getNonce(), 1);
+  BOOST_CHECK_THROW(i.getMinSuffixComponents(), tlv::Error);
+
+  // deferred fields are decoded before the wire encoding is discarded
+  i.wireDecode("0510 0703080149 09030D0101 0A0401000000"_block, true);
+  i.setNonce(2);
+  BOOST_CHECK_EQUAL(i.wireEncode(), "0510 0703080149 09030D0101 0A0402000000"_block);
+}
+
 // ---- matching ----
 
 BOOST_AUTO_TEST_CASE(MatchesData)
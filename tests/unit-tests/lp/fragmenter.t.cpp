@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "lp/fragmenter.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+static Packet
+makePacket(size_t payloadSize)
+{
+  Block netPkt = makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(payloadSize, 0xBB).data(),
+                                 payloadSize);
+  netPkt.encode();
+  Packet packet;
+  packet.add<FragmentField>(std::make_pair(netPkt.begin(), netPkt.end()));
+  return packet;
+}
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestFragmenter)
+
+BOOST_AUTO_TEST_CASE(NoFragmentation)
+{
+  Fragmenter fragmenter;
+  Sequence seq = fragmenter.getNextSequence();
+
+  Packet packet = makePacket(1000);
+  std::vector<Packet> frags = fragmenter.fragment(packet, 1500);
+  BOOST_REQUIRE_EQUAL(frags.size(), 1);
+  BOOST_CHECK(frags[0].wireEncode() == packet.wireEncode());
+  BOOST_CHECK_EQUAL(fragmenter.getNextSequence(), seq);
+}
+
+BOOST_AUTO_TEST_CASE(Fragmentation)
+{
+  Fragmenter fragmenter;
+  Sequence seq = fragmenter.getNextSequence();
+
+  Packet packet = makePacket(5000);
+  packet.add<NextHopFaceIdField>(42);
+  Block netPkt(&*packet.get<FragmentField>().first,
+               std::distance(packet.get<FragmentField>().first, packet.get<FragmentField>().second));
+
+  std::vector<Packet> frags = fragmenter.fragment(packet, 1500);
+  BOOST_REQUIRE_EQUAL(frags.size(), 4);
+  BOOST_CHECK_EQUAL(fragmenter.getNextSequence(), seq + 4);
+
+  Buffer payload;
+  for (size_t i = 0; i < frags.size(); ++i) {
+    BOOST_CHECK_LE(frags[i].wireEncode().size(), 1500);
+    BOOST_CHECK_EQUAL(frags[i].get<SequenceField>(), seq + i);
+    BOOST_CHECK_EQUAL(frags[i].get<FragIndexField>(), i);
+    BOOST_CHECK_EQUAL(frags[i].get<FragCountField>(), 4);
+    BOOST_CHECK_EQUAL(frags[i].has<NextHopFaceIdField>(), i == 0);
+
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = frags[i].get<FragmentField>();
+    payload.insert(payload.end(), begin, end);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), netPkt.begin(), netPkt.end());
+
+  // fragments survive encoding and decoding
+  Packet decoded(frags.back().wireEncode());
+  BOOST_CHECK_EQUAL(decoded.get<FragIndexField>(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  Fragmenter::Options options;
+  options.maxFragments = 2;
+  Fragmenter fragmenter(options);
+
+  BOOST_CHECK_THROW(fragmenter.fragment(Packet(), 1500), std::invalid_argument);
+
+  Packet fragmented = makePacket(5000);
+  fragmented.add<FragCountField>(1);
+  BOOST_CHECK_THROW(fragmenter.fragment(fragmented, 1500), std::invalid_argument);
+
+  BOOST_CHECK_THROW(fragmenter.fragment(makePacket(5000), 20), std::invalid_argument);
+  BOOST_CHECK_THROW(fragmenter.fragment(makePacket(5000), 1500), std::invalid_argument);
+  BOOST_CHECK_EQUAL(fragmenter.fragment(makePacket(2000), 1500).size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFragmenter
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
@@ -61,7 +61,36 @@ BOOST_AUTO_TEST_CASE(FieldAccess)
   BOOST_CHECK(packet.empty());
 }
 
-/// \todo test field access methods with a REPEATABLE field
+BOOST_AUTO_TEST_CASE(RepeatableFieldAccess)
+{
+  Packet packet;
+  packet.add<AckField>(1);
+  packet.set<FragIndexField>(7);
+  packet.add<AckField>(2);
+  packet.add<AckField>(3);
+
+  BOOST_CHECK_EQUAL(packet.count<AckField>(), 3);
+  BOOST_CHECK_EQUAL(packet.get<AckField>(2), 3);
+  BOOST_CHECK_THROW(packet.get<AckField>(3), std::out_of_range);
+  BOOST_CHECK_EQUAL(packet.get<FragIndexField>(), 7);
+
+  packet.remove<AckField>(1);
+  std::vector<uint64_t> acks = packet.list<AckField>();
+  std::vector<uint64_t> expectedAcks{1, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(acks.begin(), acks.end(), expectedAcks.begin(), expectedAcks.end());
+  BOOST_CHECK_EQUAL(packet.get<FragIndexField>(), 7);
+
+  // fields decoded from wire are accessible in the same way
+  Packet decoded(packet.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.count<AckField>(), 2);
+  BOOST_CHECK_EQUAL(decoded.get<AckField>(1), 3);
+  BOOST_CHECK_EQUAL(decoded.get<FragIndexField>(), 7);
+  BOOST_CHECK(!decoded.has<FragmentField>());
+
+  decoded.clear<AckField>();
+  BOOST_CHECK(!decoded.has<AckField>());
+  BOOST_CHECK_EQUAL(decoded.get<FragIndexField>(), 7);
+}
 
 BOOST_AUTO_TEST_CASE(EncodeFragment)
 {
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "lp/reassembler.hpp"
+#include "lp/fragmenter.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+using namespace ndn::tests;
+
+class ReassemblerFixture : public UnitTestTimeFixture
+{
+public:
+  ReassemblerFixture()
+    : scheduler(io)
+    , reassembler(scheduler, makeOptions())
+  {
+    netPkt = makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(5000, 0xBB).data(), 5000);
+    netPkt.encode();
+  }
+
+  static Reassembler::Options
+  makeOptions()
+  {
+    Reassembler::Options options;
+    options.maxPartialPackets = 2;
+    return options;
+  }
+
+  std::vector<Packet>
+  fragment()
+  {
+    Packet packet;
+    packet.add<FragmentField>(std::make_pair(netPkt.begin(), netPkt.end()));
+    packet.add<NextHopFaceIdField>(42);
+    return fragmenter.fragment(packet, 1500);
+  }
+
+public:
+  util::Scheduler scheduler;
+  Fragmenter fragmenter;
+  Reassembler reassembler;
+  Block netPkt;
+};
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_FIXTURE_TEST_SUITE(TestReassembler, ReassemblerFixture)
+
+BOOST_AUTO_TEST_CASE(Unfragmented)
+{
+  Packet packet;
+  packet.add<FragmentField>(std::make_pair(netPkt.begin(), netPkt.end()));
+
+  auto result = reassembler.receiveFragment(1, packet);
+  BOOST_CHECK(result.isComplete);
+  BOOST_CHECK(result.netPkt == netPkt);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(OutOfOrder)
+{
+  std::vector<Packet> frags = fragment();
+  BOOST_REQUIRE_EQUAL(frags.size(), 4);
+
+  BOOST_CHECK(!reassembler.receiveFragment(1, frags[2]).isComplete);
+  BOOST_CHECK(!reassembler.receiveFragment(1, frags[0]).isComplete);
+  BOOST_CHECK(!reassembler.receiveFragment(1, frags[3]).isComplete);
+  // a duplicate fragment does not complete the packet
+  BOOST_CHECK(!reassembler.receiveFragment(1, frags[3]).isComplete);
+  // a fragment from another endpoint belongs to another packet
+  BOOST_CHECK(!reassembler.receiveFragment(2, frags[1]).isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  auto result = reassembler.receiveFragment(1, frags[1]);
+  BOOST_CHECK(result.isComplete);
+  BOOST_CHECK(result.netPkt == netPkt);
+  BOOST_CHECK_EQUAL(result.firstFragment.get<NextHopFaceIdField>(), 42);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidFragments)
+{
+  std::vector<Packet> frags = fragment();
+
+  Packet noSequence = frags[1];
+  noSequence.clear<SequenceField>();
+  BOOST_CHECK(!reassembler.receiveFragment(1, noSequence).isComplete);
+
+  Packet badIndex = frags[1];
+  badIndex.set<FragIndexField>(4);
+  BOOST_CHECK(!reassembler.receiveFragment(1, badIndex).isComplete);
+
+  Packet tooMany = frags[1];
+  tooMany.set<FragCountField>(401);
+  BOOST_CHECK(!reassembler.receiveFragment(1, tooMany).isComplete);
+
+  BOOST_CHECK(!reassembler.receiveFragment(1, Packet()).isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Timeout)
+{
+  std::vector<size_t> dropped;
+  reassembler.beforeDrop.connect([&] (Reassembler::EndpointId, size_t nFragments) {
+    dropped.push_back(nFragments);
+  });
+
+  std::vector<Packet> frags = fragment();
+  reassembler.receiveFragment(1, frags[0]);
+  advanceClocks(100_ms, 4);
+  reassembler.receiveFragment(1, frags[1]);
+  advanceClocks(100_ms, 4);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK(dropped.empty());
+
+  advanceClocks(100_ms, 2);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_REQUIRE_EQUAL(dropped.size(), 1);
+  BOOST_CHECK_EQUAL(dropped[0], 2);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  std::vector<size_t> dropped;
+  reassembler.beforeDrop.connect([&] (Reassembler::EndpointId endpoint, size_t) {
+    dropped.push_back(endpoint);
+  });
+
+  std::vector<Packet> frags = fragment();
+  reassembler.receiveFragment(1, frags[0]);
+  reassembler.receiveFragment(2, frags[0]);
+  reassembler.receiveFragment(1, frags[1]);
+  reassembler.receiveFragment(3, frags[0]);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  BOOST_REQUIRE_EQUAL(dropped.size(), 1);
+  BOOST_CHECK_EQUAL(dropped[0], 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReassembler
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
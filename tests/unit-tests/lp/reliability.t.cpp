@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "lp/reliability.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+using namespace ndn::tests;
+
+class ReliabilityFixture : public UnitTestTimeFixture
+{
+public:
+  ReliabilityFixture()
+    : scheduler(io)
+    , reliability(scheduler, [this] (const Packet& frame) { sentFrames.push_back(frame); },
+                  makeOptions())
+  {
+  }
+
+  static Reliability::Options
+  makeOptions()
+  {
+    Reliability::Options options;
+    options.maxRetx = 2;
+    options.rttOptions.initialRto = time::milliseconds(100);
+    options.rttOptions.minRto = time::milliseconds(100);
+    return options;
+  }
+
+  static Packet
+  makeFrame(uint64_t id)
+  {
+    Packet frame;
+    frame.add<NextHopFaceIdField>(id);
+    return frame;
+  }
+
+public:
+  util::Scheduler scheduler;
+  std::vector<Packet> sentFrames;
+  Reliability reliability;
+};
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_FIXTURE_TEST_SUITE(TestReliability, ReliabilityFixture)
+
+BOOST_AUTO_TEST_CASE(Acknowledged)
+{
+  reliability.sendFrame(makeFrame(1));
+  BOOST_REQUIRE_EQUAL(sentFrames.size(), 1);
+  BOOST_REQUIRE(sentFrames[0].has<TxSequenceField>());
+  BOOST_CHECK_EQUAL(reliability.getNUnackedFrames(), 1);
+
+  advanceClocks(10_ms, 2);
+  Packet ack;
+  ack.add<AckField>(sentFrames[0].get<TxSequenceField>());
+  reliability.processIncoming(ack);
+  BOOST_CHECK_EQUAL(reliability.getNUnackedFrames(), 0);
+  BOOST_CHECK_EQUAL(reliability.getRttEstimator().getSmoothedRtt(), 20_ms);
+
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(sentFrames.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Retransmission)
+{
+  std::vector<Packet> lostFrames;
+  reliability.onFrameLost.connect([&] (const Packet& frame) { lostFrames.push_back(frame); });
+
+  reliability.sendFrame(makeFrame(1));
+  advanceClocks(10_ms, 10);
+  BOOST_REQUIRE_EQUAL(sentFrames.size(), 2);
+  BOOST_CHECK_EQUAL(sentFrames[1].get<NextHopFaceIdField>(), 1);
+  BOOST_CHECK_NE(sentFrames[1].get<TxSequenceField>(), sentFrames[0].get<TxSequenceField>());
+
+  // the Ack of the original transmission arrives late, and is ignored
+  Packet lateAck;
+  lateAck.add<AckField>(sentFrames[0].get<TxSequenceField>());
+  reliability.processIncoming(lateAck);
+  BOOST_CHECK_EQUAL(reliability.getNUnackedFrames(), 1);
+
+  // RTO is doubled after each timeout
+  advanceClocks(10_ms, 20);
+  BOOST_CHECK_EQUAL(sentFrames.size(), 3);
+  BOOST_CHECK(lostFrames.empty());
+
+  advanceClocks(10_ms, 40);
+  BOOST_CHECK_EQUAL(sentFrames.size(), 3);
+  BOOST_REQUIRE_EQUAL(lostFrames.size(), 1);
+  BOOST_CHECK_EQUAL(lostFrames[0].get<NextHopFaceIdField>(), 1);
+  BOOST_CHECK(!lostFrames[0].has<TxSequenceField>());
+  BOOST_CHECK_EQUAL(reliability.getNUnackedFrames(), 0);
+  // no RTT is sampled from retransmitted frames
+  BOOST_CHECK(reliability.getRttEstimator().getSmoothedRtt() < time::nanoseconds::zero());
+}
+
+BOOST_AUTO_TEST_CASE(PiggybackedAcks)
+{
+  Packet received;
+  received.set<TxSequenceField>(7);
+  reliability.processIncoming(received);
+  received.set<TxSequenceField>(8);
+  reliability.processIncoming(received);
+  BOOST_CHECK_EQUAL(reliability.getNPendingAcks(), 2);
+
+  reliability.sendFrame(makeFrame(1));
+  BOOST_REQUIRE_EQUAL(sentFrames.size(), 1);
+  std::vector<uint64_t> acks = sentFrames[0].list<AckField>();
+  std::vector<uint64_t> expectedAcks{7, 8};
+  BOOST_CHECK_EQUAL_COLLECTIONS(acks.begin(), acks.end(), expectedAcks.begin(), expectedAcks.end());
+  BOOST_CHECK_EQUAL(reliability.getNPendingAcks(), 0);
+
+  // the idle ack timer has been cancelled
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(sentFrames.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(IdleAck)
+{
+  Packet received;
+  received.set<TxSequenceField>(7);
+  reliability.processIncoming(received);
+
+  advanceClocks(1_ms, 4);
+  BOOST_CHECK_EQUAL(sentFrames.size(), 0);
+  advanceClocks(1_ms, 1);
+  BOOST_REQUIRE_EQUAL(sentFrames.size(), 1);
+  BOOST_CHECK_EQUAL(sentFrames[0].get<AckField>(), 7);
+  BOOST_CHECK(!sentFrames[0].has<TxSequenceField>());
+  BOOST_CHECK_EQUAL(reliability.getNUnackedFrames(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AcksLimitedByMtu)
+{
+  Reliability::Options options;
+  options.mtu = 60;
+  Reliability smallReliability(scheduler, [this] (const Packet& frame) { sentFrames.push_back(frame); },
+                               options);
+
+  for (Sequence seq = 0; seq < 10; ++seq) {
+    Packet received;
+    received.set<TxSequenceField>(seq);
+    smallReliability.processIncoming(received);
+  }
+
+  smallReliability.sendFrame(makeFrame(1));
+  BOOST_REQUIRE_EQUAL(sentFrames.size(), 1);
+  BOOST_CHECK_LE(sentFrames[0].wireEncode().size(), 60);
+  BOOST_CHECK_GT(smallReliability.getNPendingAcks(), 0);
+
+  advanceClocks(5_ms);
+  BOOST_CHECK_EQUAL(smallReliability.getNPendingAcks(), 0);
+  for (const Packet& frame : sentFrames) {
+    BOOST_CHECK_LE(frame.wireEncode().size(), 60);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReliability
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
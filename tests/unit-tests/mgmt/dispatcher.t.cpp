@@ -436,6 +436,176 @@ BOOST_AUTO_TEST_CASE(StatusDataset)
   BOOST_CHECK_EQUAL(storage.size(), 0); // the nack packet will not be inserted into the in-memory storage
 }
 
+BOOST_AUTO_TEST_CASE(StatusDatasetCoalescing)
+{
+  std::vector<AcceptContinuation> authorizationAccepts;
+  auto authorization =
+    [&authorizationAccepts] (const Name& prefix, const Interest& interest, const ControlParameters* params,
+                             AcceptContinuation accept, RejectContinuation reject) {
+      authorizationAccepts.push_back(accept);
+    };
+
+  const uint8_t smallBuf[] = {0x81, 0x01, 0x01};
+  const Block smallBlock(smallBuf, sizeof(smallBuf));
+  size_t nHandlerCalls = 0;
+  StatusDatasetContext* pendingContext = nullptr;
+  dispatcher.addStatusDataset("test",
+                              authorization,
+                              [&] (const Name& prefix, const Interest& interest,
+                                   StatusDatasetContext& context) {
+                                ++nHandlerCalls;
+                                pendingContext = &context;
+                              });
+
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  face.receive(*makeInterest("/root/test/valid", 1));
+  face.receive(*makeInterest("/root/test/valid", 2));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(authorizationAccepts.size(), 2);
+
+  // the handler completes asynchronously
+  authorizationAccepts[0]("");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_REQUIRE(pendingContext != nullptr);
+
+  // the second request joins the generation in progress
+  authorizationAccepts[1]("");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 0);
+
+  pendingContext->append(smallBlock);
+  advanceClocks(1_ms);
+  pendingContext->end();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+
+  // a request authorized after the generation finished is answered from the in-memory storage
+  face.sentData.clear();
+  authorizationAccepts.clear();
+  storage.erase("/", true);
+  face.receive(*makeInterest("/root/test/valid", 4));
+  face.receive(*makeInterest("/root/test/valid", 5));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(authorizationAccepts.size(), 2);
+  authorizationAccepts[0]("");
+  pendingContext->append(smallBlock);
+  pendingContext->end();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 2);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+  authorizationAccepts[1]("");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 2);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[1].wireEncode(), face.sentData[0].wireEncode());
+
+  // an abandoned generation is replaced after the InterestLifetime
+  storage.erase("/", true);
+  face.sentData.clear();
+  authorizationAccepts.clear();
+  face.receive(*makeInterest("/root/test/valid", 6));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(authorizationAccepts.size(), 1);
+  authorizationAccepts[0]("");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 3);
+
+  advanceClocks(100_ms, 50);
+  face.receive(*makeInterest("/root/test/valid", 7));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(authorizationAccepts.size(), 2);
+  authorizationAccepts[1]("");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 4);
+  pendingContext->reject();
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData[0].getContentType(), tlv::ContentType_Nack);
+}
+
+BOOST_AUTO_TEST_CASE(StatusDatasetSegmentSize)
+{
+  BOOST_CHECK_EQUAL(dispatcher.getStatusDatasetSegmentSize(), MAX_NDN_PACKET_SIZE >> 1);
+  BOOST_CHECK_THROW(dispatcher.setStatusDatasetSegmentSize(0), std::invalid_argument);
+  BOOST_CHECK_THROW(dispatcher.setStatusDatasetSegmentSize(MAX_NDN_PACKET_SIZE + 1),
+                    std::invalid_argument);
+  dispatcher.setStatusDatasetSegmentSize(100);
+  BOOST_CHECK_EQUAL(dispatcher.getStatusDatasetSegmentSize(), 100);
+
+  const uint8_t smallBuf[] = {0x81, 0x01, 0x01};
+  const Block smallBlock(smallBuf, sizeof(smallBuf));
+  dispatcher.addStatusDataset("test",
+                              makeTestAuthorization(),
+                              [&smallBlock] (const Name& prefix, const Interest& interest,
+                                             StatusDatasetContext& context) {
+                                for (int i = 0; i < 100; ++i) {
+                                  context.append(smallBlock);
+                                }
+                                context.end();
+                              });
+
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  face.receive(*makeInterest("/root/test/valid"));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(storage.size(), 3);
+  for (const Data& data : storage) {
+    BOOST_CHECK_LE(data.getContent().value_size(), 100);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StatusDatasetDeferredSigning)
+{
+  m_keyChain.setDefaultIdentity(addIdentity("/root"));
+  dispatcher.setDeferredSigning(true);
+  dispatcher.setStatusDatasetSegmentSize(100);
+
+  const uint8_t smallBuf[] = {0x81, 0x01, 0x01};
+  const Block smallBlock(smallBuf, sizeof(smallBuf));
+  dispatcher.addStatusDataset("test",
+                              makeTestAuthorization(),
+                              [&smallBlock] (const Name& prefix, const Interest& interest,
+                                             StatusDatasetContext& context) {
+                                for (int i = 0; i < 100; ++i) {
+                                  context.append(smallBlock);
+                                }
+                                context.end();
+                              });
+
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  face.receive(*makeInterest("/root/test/valid"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_REQUIRE_EQUAL(storage.size(), 3);
+
+  // the first segment is signed immediately, the other segments wait in the storage
+  uint32_t sigType = face.sentData[0].getSignature().getType();
+  BOOST_CHECK_NE(sigType, tlv::DigestSha256);
+  std::vector<Data> dataInStorage(storage.begin(), storage.end());
+  BOOST_CHECK_EQUAL(dataInStorage[0].getSignature().getType(), sigType);
+  BOOST_CHECK_EQUAL(dataInStorage[1].getSignature().getType(), tlv::DigestSha256);
+  BOOST_CHECK_EQUAL(dataInStorage[2].getSignature().getType(), tlv::DigestSha256);
+
+  face.receive(*makeInterest(dataInStorage[1].getName()));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), dataInStorage[1].getName());
+  BOOST_CHECK_EQUAL(face.sentData[1].getContent(), dataInStorage[1].getContent());
+  BOOST_CHECK_EQUAL(face.sentData[1].getSignature().getType(), sigType);
+}
+
 BOOST_AUTO_TEST_CASE(NotificationStream)
 {
   const uint8_t buf[] = {0x82, 0x01, 0x02};
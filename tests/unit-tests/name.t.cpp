@@ -406,6 +406,39 @@ BOOST_AUTO_TEST_CASE(CompareFunc)
   BOOST_CHECK_GT   (Name("/Z/A/C/Y").compare(1, 2, Name("/X/A"),   1), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  std::hash<Name> hashName;
+  Name name("/A/B/C");
+  BOOST_CHECK_EQUAL(name.getHash(), hashName(Name("/A/B/C")));
+  BOOST_CHECK_EQUAL(hashName(name), hashName(Name(name.wireEncode())));
+  BOOST_CHECK_NE(hashName(Name("/A/B")), hashName(Name("/AB")));
+  // same TLV-VALUE, different TLV-TYPE
+  const uint8_t b[] = {'B'};
+  BOOST_CHECK_NE(hashName(Name("/A/B")), hashName(Name("/A").append(0x20, b, sizeof(b))));
+
+  for (ssize_t i = -3; i <= 4; ++i) {
+    BOOST_CHECK_EQUAL(name.getPrefixHash(i), hashName(name.getPrefix(i)));
+  }
+
+  // appending keeps memoized prefix hashes valid
+  name.append("D");
+  BOOST_CHECK_EQUAL(name.getHash(), hashName(Name("/A/B/C/D")));
+  BOOST_CHECK_EQUAL(name.getPrefixHash(-1), hashName(Name("/A/B/C")));
+
+  // other modifications discard them
+  Name other("/A/X");
+  other.getHash();
+  other.wireDecode(Name("/A/Y").wireEncode());
+  BOOST_CHECK_EQUAL(other.getHash(), hashName(Name("/A/Y")));
+  other.clear();
+  BOOST_CHECK_EQUAL(other.getHash(), hashName(Name()));
+  other.append("Z");
+  BOOST_CHECK_EQUAL(other.getHash(), hashName(Name("/Z")));
+  other = name;
+  BOOST_CHECK_EQUAL(other.getHash(), hashName(Name("/A/B/C/D")));
+}
+
 BOOST_AUTO_TEST_CASE(UnorderedMap)
 {
   std::unordered_map<Name, int> map;
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -22,18 +22,101 @@
 #include "security/pib/pib-sqlite3.hpp"
 
 #include "boost-test.hpp"
+#include "pib-data-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <sqlite3.h>
 
 namespace ndn {
 namespace security {
 namespace pib {
 namespace tests {
 
+using namespace ndn::security::tests;
+
 BOOST_AUTO_TEST_SUITE(Security)
 BOOST_AUTO_TEST_SUITE(Pib)
 BOOST_AUTO_TEST_SUITE(TestPibSqlite3)
 
 // Functionality is tested as part of pib-impl.t.cpp
 
+class PibSqlite3CacheFixture : public PibDataFixture
+{
+public:
+  PibSqlite3CacheFixture()
+    : tmpPath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "PibSqlite3Cache")
+  {
+  }
+
+  ~PibSqlite3CacheFixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+  /**
+   * @brief execute @p sql on a separate connection, bypassing the PibSqlite3 instance
+   */
+  void
+  modifyDatabase(const std::string& sql)
+  {
+    sqlite3* db = nullptr;
+    BOOST_REQUIRE_EQUAL(sqlite3_open((tmpPath / "pib.db").c_str(), &db), SQLITE_OK);
+    BOOST_CHECK_EQUAL(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr), SQLITE_OK);
+    sqlite3_close(db);
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+};
+
+BOOST_FIXTURE_TEST_CASE(DefaultsServedFromMemory, PibSqlite3CacheFixture)
+{
+  PibSqlite3 pib(tmpPath.string());
+  pib.addCertificate(id1Key1Cert1);
+  pib.addCertificate(id1Key2Cert1);
+  pib.setDefaultKeyOfIdentity(id1, id1Key2Name);
+
+  modifyDatabase("PRAGMA foreign_keys=ON; DELETE FROM identities");
+
+  // the lookups done when signing with the default identity do not reach the database
+  BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id1);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyOfIdentity(id1), id1Key2Name);
+  BOOST_CHECK_EQUAL(pib.getDefaultCertificateOfKey(id1Key2Name), id1Key2Cert1);
+  BOOST_CHECK(pib.getKeyBits(id1Key2Name) == id1Key2);
+
+  // removal drops the cached entries
+  pib.removeIdentity(id1);
+  BOOST_CHECK_THROW(pib.getDefaultIdentity(), pib::Pib::Error);
+  BOOST_CHECK_THROW(pib.getDefaultKeyOfIdentity(id1), pib::Pib::Error);
+  BOOST_CHECK_THROW(pib.getDefaultCertificateOfKey(id1Key2Name), pib::Pib::Error);
+  BOOST_CHECK_THROW(pib.getKeyBits(id1Key2Name), pib::Pib::Error);
+}
+
+BOOST_FIXTURE_TEST_CASE(DefaultsWrittenThrough, PibSqlite3CacheFixture)
+{
+  {
+    PibSqlite3 pib(tmpPath.string());
+    pib.addCertificate(id1Key1Cert1);
+    pib.addCertificate(id1Key1Cert2);
+    pib.addCertificate(id2Key1Cert1);
+    BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id1);
+    BOOST_CHECK_EQUAL(pib.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert1);
+
+    pib.setDefaultIdentity(id2);
+    pib.setDefaultCertificateOfKey(id1Key1Name, id1Key1Cert2.getName());
+    BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id2);
+    BOOST_CHECK_EQUAL(pib.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert2);
+
+    pib.removeCertificate(id1Key1Cert2.getName());
+    BOOST_CHECK_THROW(pib.getDefaultCertificateOfKey(id1Key1Name), pib::Pib::Error);
+  }
+
+  // the database agrees with what was cached
+  PibSqlite3 pib(tmpPath.string());
+  BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id2);
+  BOOST_CHECK_THROW(pib.getDefaultCertificateOfKey(id1Key1Name), pib::Pib::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPibSqlite3
 BOOST_AUTO_TEST_SUITE_END() // Pib
 BOOST_AUTO_TEST_SUITE_END() // Security
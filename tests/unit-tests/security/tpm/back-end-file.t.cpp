@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/tpm/back-end-file.hpp"
+#include "security/tpm/key-handle.hpp"
+#include "security/key-params.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace security {
+namespace tpm {
+namespace tests {
+
+class BackEndFileFixture
+{
+public:
+  BackEndFileFixture()
+    : tmpPath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "TpmFileCacheTest")
+  {
+  }
+
+  ~BackEndFileFixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+  /**
+   * @brief remove all key files, bypassing the back-end
+   */
+  void
+  removeKeyFiles()
+  {
+    boost::filesystem::remove_all(tmpPath / "ndnsec-key-file");
+    boost::filesystem::create_directories(tmpPath / "ndnsec-key-file");
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+};
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(Tpm)
+BOOST_FIXTURE_TEST_SUITE(TestBackEndFile, BackEndFileFixture)
+
+BOOST_AUTO_TEST_CASE(KeyCache)
+{
+  BackEndFile tpm(tmpPath.string(), 2);
+
+  std::vector<Name> keyNames;
+  for (int i = 0; i < 3; ++i) {
+    keyNames.push_back(tpm.createKey(Name("/Test/KeyName").appendNumber(i), EcKeyParams())
+                       ->getKeyName());
+  }
+  BOOST_CHECK(tpm.getKeyHandle(keyNames[1]) != nullptr);
+  removeKeyFiles();
+
+  // keys 1 and 2 are the most recently used, and are served from memory
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyNames[0]), false);
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyNames[1]), true);
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyNames[2]), true);
+  BOOST_CHECK(tpm.getKeyHandle(keyNames[2]) != nullptr);
+
+  // a cached key can still sign
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+  BOOST_CHECK(tpm.getKeyHandle(keyNames[1])->sign(DigestAlgorithm::SHA256,
+                                                  content, sizeof(content)) != nullptr);
+
+  tpm.deleteKey(keyNames[1]);
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyNames[1]), false);
+  BOOST_CHECK(tpm.getKeyHandle(keyNames[1]) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(KeyCacheDisabled)
+{
+  BackEndFile tpm(tmpPath.string(), 0);
+
+  Name keyName = tpm.createKey("/Test/KeyName", EcKeyParams())->getKeyName();
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyName), true);
+
+  removeKeyFiles();
+  BOOST_CHECK_EQUAL(tpm.hasKey(keyName), false);
+  BOOST_CHECK(tpm.getKeyHandle(keyName) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBackEndFile
+BOOST_AUTO_TEST_SUITE_END() // Tpm
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace tpm
+} // namespace security
+} // namespace ndn
@@ -27,6 +27,8 @@
 #include "unit-tests/test-home-env-saver.hpp"
 #include "identity-management-fixture.hpp"
 
+#include <boost/asio/io_service.hpp>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -356,6 +358,57 @@ BOOST_FIXTURE_TEST_CASE(PublicKeySigningDefaults, IdentityManagementFixture)
   BOOST_CHECK(id.getName().isPrefixOf(data.getSignature().getKeyLocator().getName()));
 }
 
+BOOST_FIXTURE_TEST_CASE(SignAsync, IdentityManagementFixture)
+{
+  Identity id = addIdentity("/id");
+  Key key = id.getDefaultKey();
+
+  std::vector<Data> packets;
+  for (int i = 0; i < 10; ++i) {
+    packets.emplace_back(Name("/data").appendSegment(i));
+  }
+
+  bool hasSucceeded = false;
+  auto onSuccess = [&] { hasSucceeded = true; };
+  auto onFailure = [] (const std::string& reason) { BOOST_ERROR(reason); };
+
+  // without a pool, packets are signed synchronously
+  m_keyChain.signAsync(packets, signingByIdentity(id), onSuccess, onFailure);
+  BOOST_CHECK_EQUAL(hasSucceeded, true);
+  for (const auto& data : packets) {
+    BOOST_CHECK(verifySignature(data, key));
+  }
+
+  boost::asio::io_service io;
+  m_keyChain.setSigningPool(make_shared<SigningPool>(io, 2, 3));
+
+  hasSucceeded = false;
+  m_keyChain.signAsync(packets, signingWithSha256(), onSuccess, onFailure);
+  BOOST_CHECK_EQUAL(hasSucceeded, true);
+  for (const auto& data : packets) {
+    BOOST_CHECK(verifyDigest(data, DigestAlgorithm::SHA256));
+  }
+
+  hasSucceeded = false;
+  m_keyChain.signAsync(packets, signingByKey(key), onSuccess, onFailure);
+  BOOST_CHECK_EQUAL(hasSucceeded, false);
+  for (int i = 0; i < 5000 && !hasSucceeded; ++i) {
+    io.poll();
+    io.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  BOOST_REQUIRE_EQUAL(hasSucceeded, true);
+  for (const auto& data : packets) {
+    BOOST_CHECK_EQUAL(data.getSignature().getType(), tlv::SignatureSha256WithEcdsa);
+    BOOST_CHECK(verifySignature(data, key));
+  }
+
+  BOOST_CHECK_THROW(m_keyChain.signAsync(packets, signingByIdentity("/non-existing/identity"),
+                                         onSuccess, onFailure),
+                    KeyChain::InvalidSigningInfoError);
+  m_keyChain.setSigningPool(nullptr);
+}
+
 BOOST_FIXTURE_TEST_CASE(ExportImport, IdentityManagementFixture)
 {
   Identity id = addIdentity("/TestKeyChain/ExportIdentity/");
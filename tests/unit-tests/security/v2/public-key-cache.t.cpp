@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/public-key-cache.hpp"
+#include "security/transform/public-key.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+class PublicKeyCacheFixture : public IdentityManagementFixture
+{
+public:
+  PublicKeyCacheFixture()
+  {
+    for (int i = 0; i < 3; ++i) {
+      Identity identity = addIdentity(Name("/Security/V2/PublicKeyCache").appendNumber(i));
+      certs.push_back(identity.getDefaultKey().getDefaultCertificate());
+    }
+  }
+
+public:
+  std::vector<Certificate> certs;
+};
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_FIXTURE_TEST_SUITE(TestPublicKeyCache, PublicKeyCacheFixture)
+
+BOOST_AUTO_TEST_CASE(Get)
+{
+  PublicKeyCache cache(2);
+
+  auto key0 = cache.get(certs[0]);
+  BOOST_REQUIRE(key0 != nullptr);
+  BOOST_CHECK_EQUAL(key0->getKeyType(), KeyType::EC);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 1);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 0);
+
+  BOOST_CHECK_EQUAL(cache.get(certs[0]), key0);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+
+  // certs[0] is the least recently used entry when certs[2] is inserted
+  cache.get(certs[1]);
+  cache.get(certs[2]);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 3);
+  BOOST_CHECK_NE(cache.get(certs[0]), key0);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 4);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(GetMalformedKey)
+{
+  PublicKeyCache cache;
+
+  // same name with a different content has a different full name
+  Certificate malformed = certs[0];
+  const uint8_t garbage[] = {0x01, 0x02, 0x03};
+  malformed.setContent(garbage, sizeof(garbage));
+  m_keyChain.sign(malformed, signingByCertificate(certs[1]));
+
+  BOOST_CHECK(cache.get(malformed) == nullptr);
+  BOOST_CHECK(cache.get(certs[0]) != nullptr);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Verified)
+{
+  PublicKeyCache cache;
+  BOOST_CHECK_EQUAL(cache.isVerified(certs[0]), false);
+
+  cache.markVerified(certs[0]);
+  BOOST_CHECK_EQUAL(cache.isVerified(certs[0]), true);
+  BOOST_CHECK_EQUAL(cache.isVerified(certs[1]), false);
+  BOOST_CHECK_EQUAL(cache.getNVerifiedHits(), 1);
+
+  // the mark does not affect the key lookup
+  BOOST_CHECK(cache.get(certs[0]) != nullptr);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 1);
+
+  PublicKeyCache expiringCache(10, time::nanoseconds::zero());
+  expiringCache.markVerified(certs[0]);
+  BOOST_CHECK_EQUAL(expiringCache.isVerified(certs[0]), false);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCapacity)
+{
+  BOOST_CHECK_THROW(PublicKeyCache(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPublicKeyCache
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
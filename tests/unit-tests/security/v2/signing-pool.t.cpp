@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/signing-pool.hpp"
+#include "security/key-params.hpp"
+#include "security/tpm/back-end-mem.hpp"
+#include "security/verification-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+class SigningPoolFixture
+{
+public:
+  SigningPoolFixture()
+    : key(backEnd.createKey("/Security/V2/SigningPool", EcKeyParams()))
+    , publicKey(key->derivePublicKey())
+  {
+  }
+
+  /** \brief run io until the signing callback has been invoked, or a deadline
+   */
+  void
+  waitForCallback()
+  {
+    for (int i = 0; i < 5000 && !hasCallback; ++i) {
+      io.poll();
+      io.reset();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  SigningPool::SigningCallback
+  makeCallback()
+  {
+    return [this] (const std::vector<ConstBufferPtr>& sigs) {
+      BOOST_CHECK(!hasCallback);
+      hasCallback = true;
+      signatures = sigs;
+    };
+  }
+
+public:
+  boost::asio::io_service io;
+  tpm::BackEndMem backEnd;
+  shared_ptr<tpm::KeyHandle> key;
+  ConstBufferPtr publicKey;
+
+  bool hasCallback = false;
+  std::vector<ConstBufferPtr> signatures;
+};
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_FIXTURE_TEST_SUITE(TestSigningPool, SigningPoolFixture)
+
+BOOST_AUTO_TEST_CASE(Sign)
+{
+  SigningPool pool(io, 2, 3);
+
+  const size_t nBuffers = 10;
+  std::vector<std::string> contents;
+  std::vector<std::pair<const uint8_t*, size_t>> buffers;
+  for (size_t i = 0; i < nBuffers; ++i) {
+    contents.push_back("content " + to_string(i));
+  }
+  for (const auto& content : contents) {
+    buffers.emplace_back(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  }
+  pool.sign(key, DigestAlgorithm::SHA256, buffers, makeCallback());
+
+  // the callback is never invoked synchronously
+  BOOST_CHECK_EQUAL(hasCallback, false);
+
+  waitForCallback();
+  BOOST_REQUIRE_EQUAL(hasCallback, true);
+  BOOST_REQUIRE_EQUAL(signatures.size(), nBuffers);
+  for (size_t i = 0; i < nBuffers; ++i) {
+    BOOST_REQUIRE(signatures[i] != nullptr);
+    BOOST_CHECK(verifySignature(buffers[i].first, buffers[i].second,
+                                signatures[i]->data(), signatures[i]->size(),
+                                publicKey->data(), publicKey->size()));
+    // signatures are in the order of the buffers
+    BOOST_CHECK(!verifySignature(buffers[(i + 1) % nBuffers].first, buffers[(i + 1) % nBuffers].second,
+                                 signatures[i]->data(), signatures[i]->size(),
+                                 publicKey->data(), publicKey->size()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SignFailure)
+{
+  SigningPool pool(io, 1);
+
+  const uint8_t content[] = {0x01, 0x02, 0x03};
+  pool.sign(key, DigestAlgorithm::NONE, {{content, sizeof(content)}}, makeCallback());
+
+  waitForCallback();
+  BOOST_REQUIRE_EQUAL(hasCallback, true);
+  BOOST_REQUIRE_EQUAL(signatures.size(), 1);
+  BOOST_CHECK(signatures[0] == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SignNothing)
+{
+  SigningPool pool(io, 1);
+  pool.sign(key, DigestAlgorithm::SHA256, {}, makeCallback());
+
+  waitForCallback();
+  BOOST_CHECK_EQUAL(hasCallback, true);
+  BOOST_CHECK_EQUAL(signatures.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidArguments)
+{
+  BOOST_CHECK_THROW(SigningPool(io, 0), std::invalid_argument);
+  BOOST_CHECK_THROW(SigningPool(io, 1, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSigningPool
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -346,17 +346,17 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Checks, T, Tests, T)
 
       auto dataState = make_shared<DummyValidationState>();
       BOOST_CHECK_EQUAL(this->checker.check(tlv::Data, pktName, klName, dataState), expectedOutcome);
-      BOOST_CHECK_EQUAL(boost::logic::indeterminate(dataState->getOutcome()), expectedOutcome);
-      if (boost::logic::indeterminate(dataState->getOutcome()) == !expectedOutcome) {
-        BOOST_CHECK_EQUAL(dataState->getOutcome(), !expectedOutcome);
+      BOOST_CHECK_EQUAL(bool(boost::logic::indeterminate(dataState->getOutcome())), expectedOutcome);
+      if (bool(boost::logic::indeterminate(dataState->getOutcome())) == !expectedOutcome) {
+        BOOST_CHECK_EQUAL(bool(dataState->getOutcome()), !expectedOutcome);
       }
 
       auto interestState = make_shared<DummyValidationState>();
       BOOST_CHECK_EQUAL(this->checker.check(tlv::Interest, this->makeSignedInterestName(pktName),
                                             klName, interestState), expectedOutcome);
-      BOOST_CHECK_EQUAL(boost::logic::indeterminate(interestState->getOutcome()), expectedOutcome);
-      if (boost::logic::indeterminate(interestState->getOutcome()) == !expectedOutcome) {
-        BOOST_CHECK_EQUAL(interestState->getOutcome(), !expectedOutcome);
+      BOOST_CHECK_EQUAL(bool(boost::logic::indeterminate(interestState->getOutcome())), expectedOutcome);
+      if (bool(boost::logic::indeterminate(interestState->getOutcome())) == !expectedOutcome) {
+        BOOST_CHECK_EQUAL(bool(interestState->getOutcome()), !expectedOutcome);
       }
     }
   }
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/validator-config/rule-index.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/mpl/vector_c.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_AUTO_TEST_SUITE(ValidatorConfig)
+
+/**
+ * @brief A filter of a type unknown to RuleIndex
+ */
+class LengthFilter : public Filter
+{
+public:
+  explicit
+  LengthFilter(size_t length)
+    : m_length(length)
+  {
+  }
+
+private:
+  bool
+  matchName(const Name& pktName) override
+  {
+    return pktName.size() == m_length;
+  }
+
+private:
+  size_t m_length;
+};
+
+template<uint32_t PktType>
+class RuleIndexFixture
+{
+public:
+  RuleIndexFixture()
+    : index(PktType)
+  {
+  }
+
+  Rule&
+  addRule()
+  {
+    rules.push_back(make_unique<Rule>("rule-" + to_string(rules.size()), PktType));
+    return *rules.back();
+  }
+
+  void
+  buildIndex()
+  {
+    index.clear();
+    for (const auto& rule : rules) {
+      index.insert(*rule);
+    }
+  }
+
+  Name
+  makePktName(const Name& name) const
+  {
+    if (PktType == tlv::Interest) {
+      return Name(name).append("SigInfo").append("SigValue");
+    }
+    return name;
+  }
+
+  /**
+   * @brief Check that the index finds the same rule as a linear scan
+   */
+  void
+  checkFind(const Name& name)
+  {
+    Name pktName = makePktName(name);
+    const Rule* expected = nullptr;
+    for (const auto& rule : rules) {
+      if (rule->match(PktType, pktName)) {
+        expected = rule.get();
+        break;
+      }
+    }
+
+    const Rule* found = index.find(pktName);
+    BOOST_TEST_INFO(pktName);
+    BOOST_CHECK_EQUAL(found == nullptr ? "none" : found->getId(),
+                      expected == nullptr ? "none" : expected->getId());
+  }
+
+public:
+  std::vector<unique_ptr<Rule>> rules;
+  RuleIndex index;
+};
+
+using PktTypes = boost::mpl::vector_c<uint32_t, tlv::Data, tlv::Interest>;
+
+BOOST_AUTO_TEST_SUITE(TestRuleIndex)
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(FirstMatch, PktType, PktTypes, RuleIndexFixture<PktType::value>)
+{
+  this->addRule().addFilter(make_unique<RelationNameFilter>("/a/b", NameRelation::EQUAL));
+  this->addRule().addFilter(make_unique<RegexNameFilter>(Regex("^<a><>$")));
+  this->addRule().addFilter(make_unique<RelationNameFilter>("/a", NameRelation::IS_STRICT_PREFIX_OF));
+  this->addRule().addFilter(make_unique<RelationNameFilter>("/a/c", NameRelation::IS_PREFIX_OF));
+  Rule& rule4 = this->addRule();
+  rule4.addFilter(make_unique<RegexNameFilter>(Regex("<KEY><>$")));
+  rule4.addFilter(make_unique<RelationNameFilter>("/", NameRelation::EQUAL));
+  this->addRule().addFilter(make_unique<LengthFilter>(3));
+  this->addRule().addFilter(make_unique<RegexNameFilter>(Regex("^(<>*)<KEY><>{1,2}$")));
+  this->addRule(); // matches everything
+  this->buildIndex();
+  BOOST_CHECK_EQUAL(this->index.size(), 8);
+
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/a/b"))->getId(), "rule-0");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/a/x"))->getId(), "rule-1");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/a/x/y"))->getId(), "rule-2");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/b/KEY/c"))->getId(), "rule-4");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/x/y/z"))->getId(), "rule-5");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/x/KEY/y/z"))->getId(), "rule-6");
+  BOOST_CHECK_EQUAL(this->index.find(this->makePktName("/x"))->getId(), "rule-7");
+
+  for (const Name& name : {"/", "/a", "/a/b", "/a/c", "/a/c/d", "/a/b/c", "/a/KEY/k",
+                           "/b", "/b/KEY", "/b/KEY/k", "/b/KEY/k/v", "/b/KEY/k/v/w", "/x/y/z"}) {
+    this->checkFind(name);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(NoMatch, RuleIndexFixture<tlv::Interest>)
+{
+  this->addRule().addFilter(make_unique<RelationNameFilter>("/", NameRelation::IS_PREFIX_OF));
+  this->addRule().addFilter(make_unique<RegexNameFilter>(Regex("<>*")));
+  this->buildIndex();
+
+  BOOST_CHECK(this->index.find("/a/b") != nullptr);
+  // too short to be a signed Interest
+  BOOST_CHECK(this->index.find("/a") == nullptr);
+
+  this->index.clear();
+  BOOST_CHECK_EQUAL(this->index.size(), 0);
+  BOOST_CHECK(this->index.find("/a/b") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(ManyRules, RuleIndexFixture<tlv::Data>)
+{
+  // enough regex filters to fill several automaton groups, including an unsupported expression
+  for (int i = 0; i < 300; ++i) {
+    Name prefix = Name("/site").appendNumber(i % 50);
+    switch (i % 5) {
+      case 0:
+        this->addRule().addFilter(make_unique<RelationNameFilter>(prefix, NameRelation::IS_PREFIX_OF));
+        break;
+      case 1:
+        this->addRule().addFilter(make_unique<RelationNameFilter>(prefix, NameRelation::EQUAL));
+        break;
+      case 2:
+        this->addRule().addFilter(make_unique<RegexNameFilter>(
+          Regex("^<site><" + prefix[-1].toUri() + ">(<>*)<KEY><>$")));
+        break;
+      case 3:
+        this->addRule().addFilter(make_unique<RegexNameFilter>(
+          Regex("^<site><>{" + to_string(i % 4) + "}<c" + to_string(i) + ">$")));
+        break;
+      case 4:
+        this->addRule().addFilter(make_unique<RegexNameFilter>(
+          Regex(i == 154 ? "^<c154>{1,5000}$" : "<c" + to_string(i) + ">")));
+        break;
+    }
+  }
+  this->buildIndex();
+
+  for (int i = 0; i < 300; ++i) {
+    Name prefix = Name("/site").appendNumber(i % 50);
+    this->checkFind(prefix);
+    this->checkFind(Name(prefix).append("KEY").append("k"));
+    this->checkFind(Name(prefix).append("c" + to_string(i)));
+    this->checkFind(Name("/site").append("x").append("c" + to_string(i)));
+    this->checkFind(Name("/other").append("c" + to_string(i)));
+    this->checkFind(Name("/c" + to_string(i)));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRuleIndex
+BOOST_AUTO_TEST_SUITE_END() // ValidatorConfig
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -163,7 +163,14 @@ public:
 
 private:
   void
-  verifyOriginalPacket(const Certificate& trustedCert) override
+  verifyOriginalPacket(const Certificate& trustedCert, PublicKeyCache& keyCache) override
+  {
+    // do nothing
+  }
+
+  void
+  verifyOriginalPacket(const Certificate& trustedCert, VerificationPool& pool,
+                       const shared_ptr<ValidationState>& self) override
   {
     // do nothing
   }
@@ -333,6 +333,75 @@ BOOST_AUTO_TEST_CASE(LoopedCertChain)
   BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(PublicKeyCacheCounters)
+{
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+
+  // keys of the trust anchor and of the intermediate certificate are parsed
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the anchor's sub-key");
+  const PublicKeyCache& keyCache = validator.getPublicKeyCache();
+  BOOST_CHECK_EQUAL(keyCache.getNMisses(), 2);
+  BOOST_CHECK_EQUAL(keyCache.getNHits(), 0);
+
+  // the intermediate certificate is now trusted, and its key is reused
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the anchor's sub-key");
+  BOOST_CHECK_EQUAL(keyCache.getNMisses(), 2);
+  BOOST_CHECK_EQUAL(keyCache.getNHits(), 1);
+
+  validator.resetVerifiedCertificates();
+  BOOST_CHECK_EQUAL(keyCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelVerification)
+{
+  validator.setVerificationPool(make_shared<VerificationPool>(io, 2));
+
+  size_t nSuccesses = 0;
+  size_t nFailures = 0;
+  auto validateData = [&] (const Data& data) {
+    validator.validate(data,
+                       [&] (const Data&) { ++nSuccesses; },
+                       [&] (const Data&, const ValidationError&) { ++nFailures; });
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    Data data(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data").appendNumber(i));
+    m_keyChain.sign(data, signingByIdentity(subIdentity));
+    validateData(data);
+  }
+  Data badSigData("/Security/V2/ValidatorFixture/Sub1/Sub2/BadSig");
+  m_keyChain.sign(badSigData, signingByIdentity(subIdentity));
+  badSigData.setContent(make_shared<Buffer>(4)); // invalidates the signature
+  validateData(badSigData);
+
+  mockNetworkOperations();
+  for (int i = 0; i < 5000 && nSuccesses + nFailures < 11; ++i) {
+    io.poll();
+    io.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  BOOST_CHECK_EQUAL(nSuccesses, 10);
+  BOOST_CHECK_EQUAL(nFailures, 1);
+
+  // certificate chain is verified on the calling thread and cached
+  face.sentInterests.clear();
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+  validateData(data);
+  BOOST_CHECK_EQUAL(nSuccesses, 10);
+  for (int i = 0; i < 5000 && nSuccesses < 11; ++i) {
+    io.poll();
+    io.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  BOOST_CHECK_EQUAL(nSuccesses, 11);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  validator.setVerificationPool(nullptr);
+  VALIDATE_SUCCESS(data, "Should get accepted, as signature is verified synchronously");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestValidator
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/verification-pool.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+class VerificationPoolFixture : public IdentityManagementFixture
+{
+public:
+  VerificationPoolFixture()
+  {
+    identity = addIdentity("/Security/V2/VerificationPool");
+    otherIdentity = addIdentity("/Security/V2/VerificationPool/Other");
+    cert = identity.getDefaultKey().getDefaultCertificate();
+  }
+
+  /** \brief run io until @p n verification callbacks have been invoked, or a deadline
+   */
+  void
+  waitForCallbacks(size_t n)
+  {
+    for (int i = 0; i < 5000 && results.size() < n; ++i) {
+      io.poll();
+      io.reset();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  VerificationPool::VerificationCallback
+  makeCallback(size_t index)
+  {
+    return [this, index] (bool isValid) {
+      BOOST_CHECK(results.count(index) == 0);
+      results[index] = isValid;
+    };
+  }
+
+public:
+  boost::asio::io_service io;
+  Identity identity;
+  Identity otherIdentity;
+  Certificate cert;
+  std::map<size_t, bool> results;
+};
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_FIXTURE_TEST_SUITE(TestVerificationPool, VerificationPoolFixture)
+
+BOOST_AUTO_TEST_CASE(VerifyData)
+{
+  VerificationPool pool(io, 2, 3);
+
+  const size_t nPackets = 10;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Data data(Name("/Security/V2/VerificationPool/Data").appendNumber(i));
+    m_keyChain.sign(data, signingByIdentity(i % 5 == 4 ? otherIdentity : identity));
+    pool.verify(data, cert, makeCallback(i));
+  }
+
+  // callbacks are never invoked synchronously
+  BOOST_CHECK_EQUAL(results.size(), 0);
+  io.poll();
+  io.reset();
+
+  waitForCallbacks(nPackets);
+  BOOST_REQUIRE_EQUAL(results.size(), nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    BOOST_CHECK_EQUAL(results[i], i % 5 != 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(VerifyInterest)
+{
+  VerificationPool pool(io, 1);
+
+  Interest signedInterest("/Security/V2/VerificationPool/Interest");
+  m_keyChain.sign(signedInterest, signingByIdentity(identity));
+  pool.verify(signedInterest, cert, makeCallback(0));
+
+  // unsigned Interest is not parsable as a signed Interest
+  pool.verify(Interest("/Security/V2/VerificationPool/Unsigned"), cert, makeCallback(1));
+
+  waitForCallbacks(2);
+  BOOST_REQUIRE_EQUAL(results.size(), 2);
+  BOOST_CHECK_EQUAL(results[0], true);
+  BOOST_CHECK_EQUAL(results[1], false);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidArguments)
+{
+  BOOST_CHECK_THROW(VerificationPool(io, 0), std::invalid_argument);
+  BOOST_CHECK_THROW(VerificationPool(io, 1, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestVerificationPool
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -20,10 +20,16 @@
  */
 
 #include "transport/unix-transport.hpp"
+#include "encoding/block-helpers.hpp"
 #include "transport-fixture.hpp"
 
 #include "boost-test.hpp"
 
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace tests {
 
@@ -61,6 +67,125 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(SendCoalescing)
+{
+  using boost::asio::local::stream_protocol;
+
+  boost::filesystem::path socketPath = boost::filesystem::temp_directory_path() /
+                                       boost::filesystem::unique_path("ndn-cxx-test-%%%%%%.sock");
+  boost::asio::io_service io;
+  stream_protocol::acceptor acceptor(io, stream_protocol::endpoint(socketPath.string()));
+  stream_protocol::socket peer(io);
+  UnixTransport transport(socketPath.string());
+  transport.connect(io, [] (const Block&) {});
+
+  // packets sent before the connection is established are queued
+  const size_t nPackets = 1000;
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Block header = makeNonNegativeIntegerBlock(0x80, i);
+    Block payload = makeNonNegativeIntegerBlock(0x81, i);
+    if (i % 2 == 0) {
+      transport.send(header);
+      expected.insert(expected.end(), header.begin(), header.end());
+    }
+    else {
+      transport.send(header, payload);
+      expected.insert(expected.end(), header.begin(), header.end());
+      expected.insert(expected.end(), payload.begin(), payload.end());
+    }
+  }
+  BOOST_CHECK_EQUAL(transport.getSendMetrics().nQueuedPackets, nPackets);
+  BOOST_CHECK_EQUAL(transport.getSendMetrics().nWrites, 0);
+
+  std::vector<uint8_t> received(expected.size());
+  acceptor.async_accept(peer, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    boost::asio::async_read(peer, boost::asio::buffer(received),
+                            [&] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE(!error);
+      // check metrics before closing the transport resets them
+      io.post([&] {
+        const Transport::SendMetrics& metrics = transport.getSendMetrics();
+        BOOST_CHECK_EQUAL(metrics.nSentPackets, nPackets);
+        BOOST_CHECK_EQUAL(metrics.nQueuedPackets, 0);
+        BOOST_CHECK_EQUAL(metrics.nBytesInFlight, 0);
+        // 500 single-Block and 500 two-Block packets, at most 64 Blocks per write
+        BOOST_CHECK_LE(metrics.nWrites, 1500 / 64 + 2);
+        transport.close();
+        peer.close();
+      });
+    });
+  });
+  io.run();
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(), expected.begin(), expected.end());
+  boost::filesystem::remove(socketPath);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveBudget)
+{
+  using boost::asio::local::stream_protocol;
+
+  boost::filesystem::path socketPath = boost::filesystem::temp_directory_path() /
+                                       boost::filesystem::unique_path("ndn-cxx-test-%%%%%%.sock");
+  boost::asio::io_service io;
+  stream_protocol::acceptor acceptor(io, stream_protocol::endpoint(socketPath.string()));
+  stream_protocol::socket peer(io);
+  UnixTransport transport(socketPath.string());
+
+  Transport::ReceiveOptions options;
+  options.bufferSize = MAX_NDN_PACKET_SIZE - 1;
+  BOOST_CHECK_THROW(transport.setReceiveOptions(options), std::invalid_argument);
+  options.bufferSize = MAX_NDN_PACKET_SIZE;
+  options.packetBudget = 0;
+  BOOST_CHECK_THROW(transport.setReceiveOptions(options), std::invalid_argument);
+  options.packetBudget = 4;
+  transport.setReceiveOptions(options);
+
+  // more octets than the receive buffer can hold, forcing the buffer to be replaced
+  const size_t nPackets = 5000;
+  std::vector<uint8_t> wire;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Block block = makeNonNegativeIntegerBlock(0x80, i);
+    wire.insert(wire.end(), block.begin(), block.end());
+  }
+  BOOST_REQUIRE_GT(wire.size(), MAX_NDN_PACKET_SIZE);
+
+  std::vector<Block> received;
+  size_t nReceivedBeforeYield = 0;
+  transport.connect(io, [&] (const Block& block) {
+    received.push_back(block);
+    if (received.size() == 1) {
+      io.post([&] { nReceivedBeforeYield = received.size(); });
+    }
+    if (received.size() == nPackets) {
+      transport.close();
+      peer.close();
+    }
+  });
+  // a queued packet causes the transport to start receiving once connected
+  transport.send(makeNonNegativeIntegerBlock(0x80, 0));
+
+  acceptor.async_accept(peer, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    boost::asio::async_write(peer, boost::asio::buffer(wire),
+                             [] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE(!error);
+    });
+  });
+  io.run();
+
+  // other handlers get a chance to run after each batch of packetBudget packets
+  BOOST_CHECK_GT(nReceivedBeforeYield, 0);
+  BOOST_CHECK_LE(nReceivedBeforeYield, options.packetBudget);
+  BOOST_REQUIRE_EQUAL(received.size(), nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(received[i]), i);
+  }
+  boost::filesystem::remove(socketPath);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnixTransport
 BOOST_AUTO_TEST_SUITE_END() // Transport
 
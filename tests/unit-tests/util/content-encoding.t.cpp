@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/content-encoding.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestContentEncoding)
+
+static std::string
+makeText(size_t size)
+{
+  std::string text;
+  while (text.size() < size) {
+    text += "/ndn/edu/ucla/ping " + to_string(text.size()) + "\n";
+  }
+  text.resize(size);
+  return text;
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  std::string text = makeText(10000);
+  auto buf = reinterpret_cast<const uint8_t*>(text.data());
+
+  ConstBufferPtr compressed = encodeContent(ContentEncoding::DEFLATE, buf, text.size());
+  BOOST_CHECK_LT(compressed->size(), text.size() / 3);
+
+  ConstBufferPtr decompressed = decodeContent(ContentEncoding::DEFLATE, compressed->data(),
+                                              compressed->size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(decompressed->begin(), decompressed->end(), text.begin(), text.end());
+
+  ConstBufferPtr identity = encodeContent(ContentEncoding::IDENTITY, buf, text.size());
+  BOOST_CHECK_EQUAL(identity->size(), text.size());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeErrors)
+{
+  std::string text = makeText(10000);
+  ConstBufferPtr compressed = encodeContent(ContentEncoding::DEFLATE,
+                                            reinterpret_cast<const uint8_t*>(text.data()),
+                                            text.size());
+
+  BOOST_CHECK_THROW(decodeContent(ContentEncoding::DEFLATE, compressed->data(), compressed->size(),
+                                  9999),
+                    ContentEncodingError);
+  BOOST_CHECK_NO_THROW(decodeContent(ContentEncoding::DEFLATE, compressed->data(),
+                                     compressed->size(), 10000));
+
+  const uint8_t garbage[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+  BOOST_CHECK_THROW(decodeContent(ContentEncoding::DEFLATE, garbage, sizeof(garbage)),
+                    ContentEncodingError);
+  BOOST_CHECK_THROW(decodeContent(static_cast<ContentEncoding>(42), garbage, sizeof(garbage)),
+                    ContentEncodingError);
+}
+
+BOOST_AUTO_TEST_CASE(DataContent)
+{
+  std::string text = makeText(5000);
+  auto buf = reinterpret_cast<const uint8_t*>(text.data());
+
+  Data data("/A");
+  BOOST_CHECK_EQUAL(setEncodedContent(data, buf, text.size()), ContentEncoding::DEFLATE);
+  BOOST_CHECK_EQUAL(getContentEncoding(data), ContentEncoding::DEFLATE);
+  BOOST_CHECK_LT(data.getContent().value_size(), text.size());
+
+  // the encoding survives encoding and decoding of the packet
+  data.setSignature(Signature(SignatureInfo(tlv::DigestSha256), Block(tlv::SignatureValue)));
+  Data decoded(data.wireEncode());
+  BOOST_CHECK_EQUAL(getContentEncoding(decoded), ContentEncoding::DEFLATE);
+  Block content = getDecodedContent(decoded);
+  BOOST_CHECK_EQUAL(content.type(), tlv::Content);
+  BOOST_CHECK_EQUAL_COLLECTIONS(content.value_begin(), content.value_end(), text.begin(), text.end());
+
+  // incompressible content is carried verbatim
+  const uint8_t small[] = {0x01, 0x02, 0x03};
+  BOOST_CHECK_EQUAL(setEncodedContent(data, small, sizeof(small)), ContentEncoding::IDENTITY);
+  BOOST_CHECK(data.getMetaInfo().findAppMetaInfo(CONTENT_ENCODING_TLV_TYPE) == nullptr);
+  BOOST_CHECK(getDecodedContent(data) == data.getContent());
+}
+
+BOOST_AUTO_TEST_CASE(MalformedEncoding)
+{
+  Data data("/A");
+  MetaInfo metaInfo;
+  metaInfo.addAppMetaInfo(makeEmptyBlock(CONTENT_ENCODING_TLV_TYPE));
+  data.setMetaInfo(metaInfo);
+  BOOST_CHECK_THROW(getContentEncoding(data), ContentEncodingError);
+
+  metaInfo.removeAppMetaInfo(CONTENT_ENCODING_TLV_TYPE);
+  metaInfo.addAppMetaInfo(makeNonNegativeIntegerBlock(CONTENT_ENCODING_TLV_TYPE, 42));
+  data.setMetaInfo(metaInfo);
+  BOOST_CHECK_THROW(getDecodedContent(data), ContentEncodingError);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestContentEncoding
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -22,6 +22,7 @@
  */
 
 #include "util/regex.hpp"
+#include "util/regex/regex-automaton.hpp"
 #include "util/regex/regex-backref-manager.hpp"
 #include "util/regex/regex-backref-matcher.hpp"
 #include "util/regex/regex-component-matcher.hpp"
@@ -456,6 +457,139 @@ BOOST_AUTO_TEST_CASE(RegexBackrefManagerMemoryLeak)
   BOOST_CHECK_EQUAL(b2.use_count(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Automaton)
+{
+  const std::vector<string> exprs = {
+    "^<a><b>$",
+    "^<a><b>",
+    "<a><b>$",
+    "<a><b>",
+    "^<a>?<b>+<c>*$",
+    "^<a>{2}<b>{1,2}<c>{,1}<d>{2,}$",
+    "^<a>{0}$",
+    "^[<a><b>]*<c>$",
+    "^[^<a><b>]+$",
+    "^<.*>*<a>[^<b>]{1,3}$",
+    "^<a><>*<b>$",
+    "^<>{2,3}$",
+    "^<a.*><.*b>$",
+    "^<[0-9]+>+$",
+    "^<\\d+>$",
+    "^<a\\.b>$",
+    "^<a.b>$",
+    "^<%00%01><c>$",
+    "^<ab|cd>$",
+    "^(<a><b>)+<c>$",
+    "^(<a>?)<b>$",
+    "^(<a><b>?)*$",
+    "^<a>(<>*)<b>$",
+    "^<(a|b)><c>$",
+  };
+  const std::vector<string> names = {
+    "/", "/a", "/b", "/c", "/d", "/ab", "/cd", "/a.b", "/axb", "/123", "/12a",
+    "/a/b", "/b/a", "/a/b/c", "/a/a/b/d/d", "/a/a/b/b/c/d/d/d", "/c/c/c", "/a/c", "/b/c",
+    "/a/x/y/b", "/a/x/b/y", "/x/a/b", "/x/a/b/y", "/axb/aab", "/a.b/b", "/%00%01/c",
+    "/1/2/3", "/a/b/a/b/c", "/a/b/b/c", "/x/a/x/y/z", "/x/a/b/x/y",
+  };
+
+  for (const auto& expr : exprs) {
+    auto re = make_shared<Regex>(expr);
+    for (const auto& uri : names) {
+      Name name(uri);
+      bool isLegacyMatched = re->m_primaryMatcher->match(name, 0, name.size()) ||
+                             (re->m_secondaryMatcher != nullptr &&
+                              re->m_secondaryMatcher->match(name, 0, name.size()));
+      BOOST_TEST_INFO(expr << " " << uri);
+      BOOST_CHECK_EQUAL(re->match(name), isLegacyMatched);
+      if (re->m_automaton != nullptr) {
+        BOOST_TEST_INFO(expr << " " << uri);
+        BOOST_CHECK_EQUAL(re->m_automaton->match(name), isLegacyMatched);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AutomatonCompile)
+{
+  auto automaton = RegexAutomaton::compileTop("^<a><b>$");
+  BOOST_REQUIRE(automaton != nullptr);
+  BOOST_CHECK_EQUAL(automaton->hasBackrefs(), false);
+  BOOST_CHECK(automaton->match(Name("/a/b")));
+  BOOST_CHECK(!automaton->match(Name("/a/b/c")));
+  BOOST_CHECK(automaton->match(Name("/x/a/b/y"), 1, 2));
+
+  automaton = RegexAutomaton::compileTop("^(<>*)<KEY><>$");
+  BOOST_REQUIRE(automaton != nullptr);
+  BOOST_CHECK_EQUAL(automaton->hasBackrefs(), true);
+
+  automaton = RegexAutomaton::compileTop("^<(.*)>$");
+  BOOST_REQUIRE(automaton != nullptr);
+  BOOST_CHECK_EQUAL(automaton->hasBackrefs(), true);
+
+  // a repeated sub-pattern that matches zero components
+  BOOST_CHECK(RegexAutomaton::compileTop("^(<a>*)+$") == nullptr);
+  BOOST_CHECK(RegexAutomaton::compileTop("^(<a>?){2}$") == nullptr);
+  BOOST_CHECK(RegexAutomaton::compileTop("^(<a>*)*$") != nullptr);
+
+  // too many states
+  BOOST_CHECK(RegexAutomaton::compileTop("^<a>{1,100000}$") == nullptr);
+
+  // unsupported expressions are still matched by the RegexMatcher tree
+  Regex re("^(<a>*)+$");
+  BOOST_CHECK(re.m_automaton == nullptr);
+  BOOST_CHECK_EQUAL(re.match(Name("/a/a")), true);
+  BOOST_CHECK_EQUAL(re.match(Name("/")), false);
+
+  Regex re2("^<a>(<>*)<b>$");
+  BOOST_REQUIRE(re2.m_automaton != nullptr);
+  BOOST_CHECK_EQUAL(re2.match(Name("/a/x/y/b")), true);
+  BOOST_CHECK_EQUAL(re2.expand("\\1"), Name("/x/y"));
+  BOOST_CHECK_EQUAL(re2.match(Name("/a/x/y")), false);
+  BOOST_CHECK_EQUAL(re2.getMatchResult().size(), 0);
+
+  Regex re3("<a><b>");
+  BOOST_REQUIRE(re3.m_automaton != nullptr);
+  BOOST_CHECK_EQUAL(re3.match(Name("/x/a/b/y")), true);
+  BOOST_CHECK_EQUAL(re3.getMatchResult().size(), 4);
+  BOOST_CHECK_EQUAL(re3.expand("\\0"), Name("/x/a/b/y"));
+}
+
+BOOST_AUTO_TEST_CASE(AutomatonRequiredPrefix)
+{
+  auto getRequiredPrefix = [] (const std::string& expr) {
+    auto automaton = RegexAutomaton::compileTop(expr);
+    BOOST_REQUIRE(automaton != nullptr);
+    return automaton->getRequiredPrefix();
+  };
+
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn><edu>[^<KEY>]*<KEY>$"), "/ndn/edu");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn><edu>$"), "/ndn/edu");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn><edu>"), "/ndn/edu");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn>{2}<edu>+<ucla>"), "/ndn/ndn/edu");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn>(<edu>)<ucla>"), "/ndn/edu/ucla");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn><ed.*>"), "/ndn");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^<ndn>?<edu>"), "/");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("^[<ndn><edu>]<edu>"), "/");
+  BOOST_CHECK_EQUAL(getRequiredPrefix("<ndn><edu>"), "/");
+}
+
+BOOST_AUTO_TEST_CASE(AutomatonUnion)
+{
+  auto automaton = RegexAutomaton::compileUnion({"^<a><b>$", "^<a><>*$", "<b>", "^<a><b>$"});
+  BOOST_REQUIRE(automaton != nullptr);
+  BOOST_CHECK_EQUAL(automaton->findFirst(Name("/a/b")), 0);
+  BOOST_CHECK_EQUAL(automaton->findFirst(Name("/a/c")), 1);
+  BOOST_CHECK_EQUAL(automaton->findFirst(Name("/c/b/c")), 2);
+  BOOST_CHECK_EQUAL(automaton->findFirst(Name("/c")), RegexAutomaton::NO_MATCH);
+  BOOST_CHECK_EQUAL(automaton->findFirst(Name("/x/a/b/y"), 1, 2), 0);
+  BOOST_CHECK_EQUAL(automaton->match(Name("/a")), true);
+
+  BOOST_CHECK_EQUAL(automaton->getRequiredPrefix(), Name());
+
+  BOOST_CHECK(RegexAutomaton::compileUnion({}) == nullptr);
+  BOOST_CHECK(RegexAutomaton::compileUnion({"^<a>$", "^(<a>*)+$"}) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestRegex
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/rtt-estimator.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestRttEstimator)
+
+BOOST_AUTO_TEST_CASE(Measurements)
+{
+  RttEstimator rttEstimator;
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 1_s);
+  BOOST_CHECK_LT(rttEstimator.getSmoothedRtt(), time::nanoseconds::zero());
+
+  rttEstimator.addMeasurement(100_ms, 1);
+  BOOST_CHECK_EQUAL(rttEstimator.getSmoothedRtt(), 100_ms);
+  BOOST_CHECK_EQUAL(rttEstimator.getRttVariation(), 50_ms);
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 300_ms);
+
+  rttEstimator.addMeasurement(200_ms, 1);
+  BOOST_CHECK_EQUAL(rttEstimator.getSmoothedRtt(), 112500_us);
+  BOOST_CHECK_EQUAL(rttEstimator.getRttVariation(), 62500_us);
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 362500_us);
+
+  // gains are divided among the samples expected within one RTT
+  rttEstimator.addMeasurement(212500_us, 4);
+  BOOST_CHECK_EQUAL(rttEstimator.getSmoothedRtt(), 115625_us);
+}
+
+BOOST_AUTO_TEST_CASE(Bounds)
+{
+  RttEstimator rttEstimator;
+  rttEstimator.addMeasurement(10_ms, 1);
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 200_ms);
+
+  rttEstimator.backoffRto();
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 400_ms);
+  for (int i = 0; i < 10; ++i) {
+    rttEstimator.backoffRto();
+  }
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 1_min);
+
+  rttEstimator.addMeasurement(100_s, 1);
+  BOOST_CHECK_EQUAL(rttEstimator.getEstimatedRto(), 1_min);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRttEstimator
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
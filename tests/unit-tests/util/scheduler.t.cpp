@@ -245,6 +245,99 @@ BOOST_AUTO_TEST_CASE(CancelAllWithScopedEventId) // Bug 3691
 
 BOOST_AUTO_TEST_SUITE_END() // General
 
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+public:
+  TimerWheelFixture()
+    : scheduler(io, EventQueueType::TIMER_WHEEL)
+  {
+  }
+
+public:
+  Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Events)
+{
+  std::vector<int> executed;
+  scheduler.scheduleEvent(500_ms, [&] { executed.push_back(3); });
+  EventId i = scheduler.scheduleEvent(1_s, [] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  scheduler.scheduleEvent(250_ms, [&] { executed.push_back(2); });
+  scheduler.scheduleEvent(0_ms, [&] { executed.push_back(1); });
+  BOOST_CHECK_EQUAL(static_cast<bool>(i), true);
+  scheduler.cancelEvent(i);
+  BOOST_CHECK_EQUAL(static_cast<bool>(i), false);
+
+  advanceClocks(25_ms, 1000_ms);
+  std::vector<int> expected{1, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(NeverEarly)
+{
+  // delays around the boundaries of wheel levels, and beyond the span of the wheel
+  std::vector<time::nanoseconds> delays{1_ns, 1_ms, 255_ms, 256_ms, 257_ms, 65535_ms, 65536_ms,
+                                        65537_ms, 1_h, time::milliseconds(1LL << 32), 60_days};
+  auto start = time::steady_clock::now();
+  std::vector<time::nanoseconds> lateness(delays.size(), time::nanoseconds::min());
+  for (size_t i = 0; i < delays.size(); ++i) {
+    scheduler.scheduleEvent(delays[i], [&, i] {
+        lateness[i] = time::steady_clock::now() - start - delays[i];
+      });
+  }
+
+  auto checkLateness = [&] (size_t first, size_t last, time::nanoseconds maxLateness) {
+    for (size_t i = first; i < last; ++i) {
+      BOOST_CHECK_GE(lateness[i], 0_ns);
+      BOOST_CHECK_LE(lateness[i], maxLateness);
+    }
+  };
+
+  advanceClocks(1_ms, 300_ms);
+  checkLateness(0, 5, 1_ms);
+  advanceClocks(100_ms, 70_s);
+  checkLateness(5, 8, 100_ms + 1_ms);
+  advanceClocks(1_h, 61_days);
+  checkLateness(8, delays.size(), 1_h + 1_ms);
+}
+
+BOOST_AUTO_TEST_CASE(CancelMany)
+{
+  const size_t nEvents = 10000;
+  std::vector<EventId> eventIds;
+  std::vector<bool> isExecuted(nEvents, false);
+  for (size_t i = 0; i < nEvents; ++i) {
+    eventIds.push_back(scheduler.scheduleEvent(time::milliseconds(i * 7 % 100000),
+                                               [&, i] { isExecuted[i] = true; }));
+  }
+  for (size_t i = 0; i < nEvents; i += 2) {
+    scheduler.cancelEvent(eventIds[i]);
+  }
+
+  advanceClocks(10_ms, 101_s);
+  for (size_t i = 0; i < nEvents; ++i) {
+    BOOST_CHECK_EQUAL(isExecuted[i], i % 2 == 1);
+    BOOST_CHECK_EQUAL(static_cast<bool>(eventIds[i]), false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CancelAll)
+{
+  scheduler.scheduleEvent(500_ms, [&] { scheduler.cancelAllEvents(); });
+  scheduler.scheduleEvent(1_s, [] { BOOST_ERROR("This event should have been cancelled"); });
+  scheduler.scheduleEvent(1_h, [] { BOOST_ERROR("This event should have been cancelled"); });
+
+  advanceClocks(100_ms, 100);
+  advanceClocks(1_min, 61);
+  BOOST_CHECK(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TimerWheel
+
 BOOST_AUTO_TEST_SUITE(EventId)
 
 using scheduler::EventId;
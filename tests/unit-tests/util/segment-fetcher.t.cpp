@@ -20,6 +20,8 @@
  */
 
 #include "util/segment-fetcher.hpp"
+#include "util/content-encoding.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "data.hpp"
 #include "lp/nack.hpp"
@@ -463,6 +465,247 @@ BOOST_FIXTURE_TEST_CASE(Signals, Fixture)
   BOOST_CHECK_EQUAL(nErrors, 1);
 }
 
+class PipelineFixture : public Fixture
+{
+public:
+  static shared_ptr<Data>
+  makeNumberedSegment(uint64_t segment, uint64_t lastSegment)
+  {
+    auto data = make_shared<Data>(Name("/hello/world/version0").appendSegment(segment));
+    std::string content = to_string(segment) + ";";
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    data->setFinalBlock(name::Component::fromSegment(lastSegment));
+    return signData(data);
+  }
+
+  void
+  start(const SegmentFetcher::Options& options = SegmentFetcher::Options())
+  {
+    fetcher = SegmentFetcher::start(face, Interest("/hello/world"), validator, options);
+    fetcher->onComplete.connect([this] (const ConstBufferPtr& data) {
+      ++nData;
+      dataString.assign(data->get<char>(), data->size());
+    });
+    fetcher->onError.connect(bind(&Fixture::onError, this, _1));
+    fetcher->afterSegmentTimedOut.connect([this] { ++nTimeouts; });
+  }
+
+public:
+  DummyValidator validator;
+  shared_ptr<SegmentFetcher> fetcher;
+  size_t nTimeouts = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE(PipelinedOutOfOrder, PipelineFixture)
+{
+  start();
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  face.receive(*makeNumberedSegment(0, 6));
+  advanceClocks(10_ms);
+
+  // slow start: window grows by one segment per validated segment
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 2);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face.sentInterests[1].getName(), "/hello/world/version0/%00%01");
+  BOOST_CHECK_EQUAL(face.sentInterests[2].getName(), "/hello/world/version0/%00%02");
+
+  face.receive(*makeNumberedSegment(2, 6));
+  face.receive(*makeNumberedSegment(1, 6));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 4);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 7);
+
+  // no Interest is expressed beyond the last segment
+  for (int segment = 6; segment >= 3; --segment) {
+    face.receive(*makeNumberedSegment(segment, 6));
+    advanceClocks(10_ms);
+  }
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 7);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(dataString, "0;1;2;3;4;5;6;");
+}
+
+BOOST_FIXTURE_TEST_CASE(PipelinedTimeout, PipelineFixture)
+{
+  start();
+  advanceClocks(10_ms);
+  face.receive(*makeNumberedSegment(0, 9));
+  advanceClocks(10_ms);
+  face.receive(*makeNumberedSegment(1, 9));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 3);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 5); // segments 2, 3, and 4 are in flight
+
+  // RTO is at its lower bound of 200 ms
+  advanceClocks(10_ms, 30);
+  BOOST_CHECK_EQUAL(nTimeouts, 3);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+
+  // window is decreased only once for losses within the same RTT
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 2);
+  BOOST_CHECK_GT(fetcher->getRttEstimator().getEstimatedRto(), 200_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 7);
+  BOOST_CHECK_EQUAL(face.sentInterests[5].getName(), "/hello/world/version0/%00%02");
+  BOOST_CHECK_EQUAL(face.sentInterests[6].getName(), "/hello/world/version0/%00%03");
+
+  fetcher->stop();
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(PipelinedMaxTimeout, PipelineFixture)
+{
+  SegmentFetcher::Options options;
+  options.maxTimeout = 1_s;
+  start(options);
+  advanceClocks(10_ms, 110);
+
+  // no segment is received within maxTimeout
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, static_cast<uint32_t>(SegmentFetcher::INTEREST_TIMEOUT));
+}
+
+BOOST_FIXTURE_TEST_CASE(CongestionMark, PipelineFixture)
+{
+  SegmentFetcher::Options options;
+  options.initCwnd = 10;
+  start(options);
+  advanceClocks(10_ms);
+  face.receive(*makeNumberedSegment(0, 99));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 11);
+
+  auto data = makeNumberedSegment(1, 99);
+  data->setCongestionMark(1);
+  face.receive(*data);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 5.5);
+
+  // further marks within the same RTT are ignored
+  data = makeNumberedSegment(2, 99);
+  data->setCongestionMark(1);
+  face.receive(*data);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(fetcher->getCwnd(), 5.5);
+  fetcher->stop();
+}
+
+BOOST_FIXTURE_TEST_CASE(InOrderStreaming, PipelineFixture)
+{
+  SegmentFetcher::Options options;
+  options.initCwnd = 10;
+  options.inOrder = true;
+  options.reorderWindow = 3;
+  start(options);
+  std::vector<std::string> chunks;
+  std::string received;
+  size_t nInOrderComplete = 0;
+  fetcher->onInOrderData.connect([&] (const ConstBufferPtr& chunk) {
+    chunks.emplace_back(chunk->get<char>(), chunk->size());
+    received += chunks.back();
+  });
+  fetcher->onInOrderComplete.connect([&] { ++nInOrderComplete; });
+
+  advanceClocks(10_ms);
+  face.receive(*makeNumberedSegment(0, 6));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(chunks.size(), 1);
+
+  // the reorder window, rather than the congestion window, limits outstanding segments
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 4);
+  face.receive(*makeNumberedSegment(3, 6));
+  face.receive(*makeNumberedSegment(2, 6));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(chunks.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 4);
+
+  face.receive(*makeNumberedSegment(1, 6));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(chunks.size(), 4);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 7);
+
+  // backpressure: data is held back until the application resumes
+  fetcher->pause();
+  face.receive(*makeNumberedSegment(4, 6));
+  advanceClocks(10_ms, 100);
+  BOOST_CHECK_EQUAL(chunks.size(), 4);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  fetcher->resume();
+  BOOST_CHECK_EQUAL(chunks.size(), 5);
+
+  // segments 5 and 6 timed out while paused and are retransmitted upon resume
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 9);
+
+  face.receive(*makeNumberedSegment(6, 6));
+  face.receive(*makeNumberedSegment(5, 6));
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 0);
+  BOOST_CHECK_EQUAL(nInOrderComplete, 1);
+  BOOST_CHECK_EQUAL(chunks.size(), 7);
+  BOOST_CHECK_EQUAL(received, "0;1;2;3;4;5;6;");
+}
+
+BOOST_FIXTURE_TEST_CASE(EncodedContent, PipelineFixture)
+{
+  start();
+  advanceClocks(10_ms);
+
+  std::string text(4000, 'a');
+  for (uint64_t segment = 0; segment <= 1; ++segment) {
+    auto data = make_shared<Data>(Name("/hello/world/version0").appendSegment(segment));
+    setEncodedContent(*data, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    BOOST_REQUIRE_EQUAL(getContentEncoding(*data), ContentEncoding::DEFLATE);
+    data->setFinalBlock(name::Component::fromSegment(1));
+    face.receive(*signData(data));
+    advanceClocks(10_ms);
+  }
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(dataString, text + text);
+}
+
+BOOST_FIXTURE_TEST_CASE(EncodedContentError, PipelineFixture)
+{
+  start();
+  advanceClocks(10_ms);
+
+  auto data = make_shared<Data>(Name("/hello/world/version0").appendSegment(0));
+  MetaInfo metaInfo;
+  metaInfo.addAppMetaInfo(makeNonNegativeIntegerBlock(CONTENT_ENCODING_TLV_TYPE,
+                                                      static_cast<uint64_t>(ContentEncoding::DEFLATE)));
+  data->setMetaInfo(metaInfo);
+  data->setContent(reinterpret_cast<const uint8_t*>("garbage"), 7);
+  data->setFinalBlock(name::Component::fromSegment(0));
+  face.receive(*signData(data));
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, static_cast<uint32_t>(SegmentFetcher::CONTENT_DECODING_FAIL));
+  BOOST_CHECK_EQUAL(nData, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(InvalidOptions, PipelineFixture)
+{
+  SegmentFetcher::Options options;
+  options.mdCoef = 0;
+  BOOST_CHECK_THROW(SegmentFetcher::start(face, Interest("/hello/world"), validator, options),
+                    std::invalid_argument);
+
+  options = SegmentFetcher::Options();
+  options.reorderWindow = 0;
+  BOOST_CHECK_THROW(SegmentFetcher::start(face, Interest("/hello/world"), validator, options),
+                    std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSegmentFetcher
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -150,6 +150,41 @@ BOOST_AUTO_TEST_CASE(Basic)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Cache)
+{
+  Sqlite3Statement(db, "CREATE TABLE test (t1 int)").step();
+
+  Sqlite3StatementCache cache(db);
+  Sqlite3Statement* insert = nullptr;
+  for (int i = 1; i <= 3; ++i) {
+    auto stmt = cache.prepare("INSERT INTO test VALUES (?)");
+    if (insert == nullptr) {
+      insert = &*stmt;
+    }
+    // the same statement is reused
+    BOOST_CHECK_EQUAL(&*stmt, insert);
+    stmt->bind(1, i);
+    BOOST_CHECK_EQUAL(stmt->step(), SQLITE_DONE);
+  }
+
+  {
+    // bindings are cleared when the previous borrower goes out of scope
+    auto stmt = cache.prepare("INSERT INTO test VALUES (?)");
+    BOOST_CHECK_EQUAL(stmt->step(), SQLITE_DONE);
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    // the statement is reset, so that it starts from the first row again
+    auto stmt = cache.prepare("SELECT count(*), count(t1) FROM test");
+    BOOST_CHECK_EQUAL(stmt->step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(stmt->getInt(0), 4);
+    BOOST_CHECK_EQUAL(stmt->getInt(1), 3);
+  }
+
+  BOOST_CHECK_THROW(cache.prepare("SELECT nonsense FROM"), std::domain_error);
+  cache.clear();
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSqlite3Statement
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/trace.hpp"
+#include "util/logging.hpp"
+#include "interest.hpp"
+
+#include "../unit-test-time-fixture.hpp"
+#include "boost-test.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_LOG_INIT(ndn.util.tests.Trace);
+
+const time::microseconds LOG_SYSTIME(1468108800311239LL);
+const std::string LOG_SYSTIME_STR("1468108800.311239");
+
+class TraceFixture : public ndn::tests::UnitTestTimeFixture
+{
+protected:
+  TraceFixture()
+    : m_oldEnabledLevel(Logging::get().getLevels())
+    , m_oldDestination(Logging::get().getDestination())
+  {
+    this->systemClock->setNow(LOG_SYSTIME);
+    Logging::get().resetLevels();
+    Logging::setLevel("ndn.util.tests.Trace", LogLevel::DEBUG);
+    Logging::setDestination(os);
+  }
+
+  ~TraceFixture()
+  {
+    Trace::disable();
+    Logging::get().setLevelImpl(m_oldEnabledLevel);
+    Logging::setDestination(m_oldDestination);
+  }
+
+  /** \brief decode the binary trace in \p trace
+   */
+  static std::string
+  decode(std::istream& trace)
+  {
+    std::ostringstream text;
+    TraceDecoder decoder(trace);
+    while (decoder.decodeNext(text)) {
+    }
+    return text.str();
+  }
+
+protected:
+  boost::test_tools::output_test_stream os;
+
+private:
+  std::unordered_map<std::string, LogLevel> m_oldEnabledLevel;
+  shared_ptr<std::ostream> m_oldDestination;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestTrace, TraceFixture)
+
+BOOST_AUTO_TEST_CASE(TextFallback)
+{
+  BOOST_REQUIRE(!Trace::isEnabled());
+
+  NDN_TRACE_TRACE("not logged {}", 1);
+  NDN_TRACE_DEBUG("int={} str={} name={}", -1, "s", Name("/A/B"));
+  NDN_TRACE_INFO("missing {} {}", 1);
+  NDN_TRACE_WARN("extra", 2, 'c');
+  NDN_TRACE_ERROR("no arguments {}");
+
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " DEBUG: [ndn.util.tests.Trace] int=-1 str=s name=/A/B\n" +
+    LOG_SYSTIME_STR + " INFO: [ndn.util.tests.Trace] missing 1 {}\n" +
+    LOG_SYSTIME_STR + " WARNING: [ndn.util.tests.Trace] extra 2 c\n" +
+    LOG_SYSTIME_STR + " ERROR: [ndn.util.tests.Trace] no arguments {}\n"
+    ));
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  Interest interest("/I/n", 2_s);
+  interest.setNonce(0x1234);
+  interest.setMustBeFresh(true);
+  std::string str("string");
+
+  auto trace = make_shared<std::stringstream>();
+  // no periodic flush, so that the records of each thread stay together
+  Trace::enable(trace, Trace::DEFAULT_BUFFER_SIZE, time::hours(1));
+  BOOST_CHECK(Trace::isEnabled());
+
+  NDN_TRACE_TRACE("not recorded {}", 1);
+  NDN_TRACE_DEBUG("int={} uint={} double={} bool={}", -3, 4U, 2.5, true);
+  NDN_TRACE_INFO("char={} literal={} string={}", 'c', "literal", str);
+  NDN_TRACE_WARN("name={} interest={} other={}", Name("/A/B"), interest, LogLevel::INFO);
+  std::thread([] { NDN_TRACE_ERROR("from another thread"); }).join();
+  NDN_TRACE_FATAL("missing {} {}, extra", 1, 2, 3);
+
+  Trace::disable();
+  BOOST_CHECK(!Trace::isEnabled());
+  Logging::flush();
+  BOOST_CHECK(os.is_empty());
+
+  BOOST_CHECK_EQUAL(decode(*trace),
+    LOG_SYSTIME_STR + " DEBUG: [ndn.util.tests.Trace] int=-3 uint=4 double=2.5 bool=1\n" +
+    LOG_SYSTIME_STR + " INFO: [ndn.util.tests.Trace] char=c literal=literal string=string\n" +
+    LOG_SYSTIME_STR + " WARNING: [ndn.util.tests.Trace] name=/A/B interest=" +
+      boost::lexical_cast<std::string>(interest) + " other=INFO\n" +
+    LOG_SYSTIME_STR + " FATAL: [ndn.util.tests.Trace] missing 1 2, extra 3\n" +
+    LOG_SYSTIME_STR + " ERROR: [ndn.util.tests.Trace] from another thread\n");
+
+  // a new destination receives only new records, and the definitions of their log statements
+  trace = make_shared<std::stringstream>();
+  Trace::enable(trace);
+  NDN_TRACE_DEBUG("int={} uint={} double={} bool={}", 1, 2U, 0.5, false);
+  Trace::flush();
+  BOOST_CHECK_EQUAL(decode(*trace),
+    LOG_SYSTIME_STR + " DEBUG: [ndn.util.tests.Trace] int=1 uint=2 double=0.5 bool=0\n");
+}
+
+BOOST_AUTO_TEST_CASE(Dropped)
+{
+  auto trace = make_shared<std::stringstream>();
+  // the minimum ring size applies to threads that start recording from now on
+  Trace::enable(trace, 0, time::hours(1));
+  uint64_t nDroppedBefore = Trace::getNDropped();
+
+  std::thread([] {
+    for (int i = 0; i < 1000; ++i) {
+      NDN_TRACE_DEBUG("name={}", Name("/dropped/name").appendNumber(i));
+    }
+  }).join();
+  uint64_t nDropped = Trace::getNDropped() - nDroppedBefore;
+  BOOST_CHECK_GT(nDropped, 0);
+  BOOST_CHECK_LT(nDropped, 1000);
+
+  Trace::disable();
+  std::string text = decode(*trace);
+  BOOST_CHECK_EQUAL(std::count(text.begin(), text.end(), '\n'), 1000 - nDropped + 1);
+  BOOST_CHECK(text.find("DEBUG: [ndn.util.tests.Trace] name=/dropped/name/%00\n") != std::string::npos);
+  BOOST_CHECK(text.find("WARNING: [ndn.util.Trace] " + to_string(nDropped) + " records dropped\n") !=
+              std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidArguments)
+{
+  BOOST_CHECK_THROW(Trace::enable(nullptr), std::invalid_argument);
+  BOOST_CHECK_THROW(Trace::enable(make_shared<std::stringstream>(), 4096, time::milliseconds(0)),
+                    std::invalid_argument);
+  BOOST_CHECK(!Trace::isEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformed)
+{
+  std::stringstream notTrace("NDN-TRACE");
+  BOOST_CHECK_THROW(TraceDecoder decoder(notTrace), TraceDecoder::Error);
+
+  auto trace = make_shared<std::stringstream>();
+  Trace::enable(trace);
+  NDN_TRACE_DEBUG("name={}", Name("/A"));
+  Trace::disable();
+  std::string wire = trace->str();
+
+  std::stringstream empty(wire.substr(0, 13));
+  TraceDecoder emptyDecoder(empty);
+  std::ostringstream text;
+  BOOST_CHECK_EQUAL(emptyDecoder.decodeNext(text), false);
+
+  std::stringstream truncated(wire.substr(0, wire.size() - 1));
+  TraceDecoder truncatedDecoder(truncated);
+  BOOST_CHECK_THROW(truncatedDecoder.decodeNext(text), TraceDecoder::Error);
+
+  std::stringstream unknownFrame(wire.substr(0, 13) + '\x7F');
+  TraceDecoder unknownFrameDecoder(unknownFrame);
+  BOOST_CHECK_THROW(unknownFrameDecoder.decodeNext(text), TraceDecoder::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTrace
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+// Renders a binary trace written by ndn::util::Trace as text log messages.
+
+#include "util/trace.hpp"
+
+#include <fstream>
+#include <iostream>
+
+int
+main(int argc, char** argv)
+{
+  if (argc > 2 || (argc == 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))) {
+    std::cerr << "Usage: " << argv[0] << " [FILE]\n"
+              << "Render a binary trace as text log messages.\n"
+              << "With no FILE, or when FILE is -, read standard input." << std::endl;
+    return 2;
+  }
+
+  std::ifstream file;
+  std::istream* is = &std::cin;
+  if (argc == 2 && std::string(argv[1]) != "-") {
+    file.open(argv[1], std::ios::binary);
+    if (!file) {
+      std::cerr << "ERROR: cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+    is = &file;
+  }
+
+  try {
+    ndn::util::TraceDecoder decoder(*is);
+    while (decoder.decodeNext(std::cout)) {
+    }
+  }
+  catch (const ndn::util::TraceDecoder::Error& e) {
+    std::cout.flush();
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}